@@ -179,9 +179,9 @@ ConsumerZipfMandelbrot::SendPacket() {
   (*nameWithSequence) (seq);
   //
 
-  Interest interestHeader;
-  interestHeader.SetNonce (m_rand.GetValue ());
-  interestHeader.SetName  (nameWithSequence);
+  Ptr<Interest> interestHeader = Create<Interest> ();
+  interestHeader->SetNonce (m_rand.GetValue ());
+  interestHeader->SetName  (nameWithSequence);
 
   // NS_LOG_INFO ("Requesting Interest: \n" << interestHeader);
   NS_LOG_INFO ("> Interest for " << seq<<", Total: "<<m_seq<<", face: "<<m_face->GetId());
@@ -189,7 +189,8 @@ ConsumerZipfMandelbrot::SendPacket() {
   Ptr<Packet> packet = Create<Packet> ();
 
   //NS_LOG_DEBUG ("= Interest for " << seq<<", Total: "<<m_seq<<", face: "<<m_face->GetId());
-  packet->AddHeader (interestHeader);
+  interestHeader->SetHopCount (0); // hop count is carried in the header, FwHopCountTag is not needed
+  packet->AddHeader (*interestHeader);
   //NS_LOG_DEBUG ("Interest packet size: " << packet->GetSize ());
 
   NS_LOG_DEBUG ("Trying to add " << seq << " with " << Simulator::Now () << ". already " << m_seqTimeouts.size () << " items");
@@ -202,14 +203,11 @@ ConsumerZipfMandelbrot::SendPacket() {
 
   m_seqRetxCounts[seq] ++;
 
-  m_transmittedInterests (&interestHeader, this, m_face);
+  m_transmittedInterests (interestHeader, this, m_face);
 
   m_rtt->SentSeq (SequenceNumber32 (seq), 1);
 
-  FwHopCountTag hopCountTag;
-  packet->AddPacketTag (hopCountTag);
-
-  m_protocolHandler (packet);
+  m_face->ReceiveInterest (interestHeader, packet); // header is passed along, so the stack does not parse it again
 
   ConsumerZipfMandelbrot::ScheduleNextPacket ();
 }
@@ -225,31 +225,30 @@ Consumer::SendPacket ()
   (*nameWithSequence) (seq);
   //
 
-  Interest interestHeader;
-  interestHeader.SetNonce               (m_rand.GetValue ());
-  interestHeader.SetName                (nameWithSequence);
-  interestHeader.SetInterestLifetime    (m_interestLifeTime);
+  Ptr<Interest> interestHeader = Create<Interest> ();
+  interestHeader->SetNonce               (m_rand.GetValue ());
+  interestHeader->SetName                (nameWithSequence);
+  interestHeader->SetInterestLifetime    (m_interestLifeTime);
 
   // Add Exclusion
   for (int i = 0; i < (count < MAX_EXCLUSIONS ? count : MAX_EXCLUSIONS); i++)
     {
-      interestHeader.AddExclusion(m_hash[i]);
+      interestHeader->AddExclusion(m_hash[i]);
     }
 
   // NS_LOG_INFO ("Requesting Interest: \n" << interestHeader);
   NS_LOG_INFO ("> Interest for " << seq);
 
+  interestHeader->SetHopCount (0); // hop count is carried in the header, FwHopCountTag is not needed
+
   Ptr<Packet> packet = Create<Packet> ();
-  packet->AddHeader (interestHeader);
+  packet->AddHeader (*interestHeader);
   NS_LOG_DEBUG ("Interest packet size: " << packet->GetSize ());
 
   WillSendOutInterest (seq);  
 
-  FwHopCountTag hopCountTag;
-  packet->AddPacketTag (hopCountTag);
-
-  m_transmittedInterests (&interestHeader, this, m_face);
-  m_protocolHandler (packet);
+  m_transmittedInterests (interestHeader, this, m_face);
+  m_face->ReceiveInterest (interestHeader, packet); // header is passed along, so the stack does not parse it again
 
   ScheduleNextPacket ();
 }
@@ -348,9 +347,9 @@ Consumer::OnContentObject (const Ptr<const ContentObject> &contentObject,
   uint32_t seq = boost::lexical_cast<uint32_t> (contentObject->GetName ().GetComponents ().back ());
   NS_LOG_INFO ("< DATA for " << seq);
 
-  int hopCount = -1;
+  int hopCount = contentObject->GetHopCount ();
   FwHopCountTag hopCountTag;
-  if (payload->RemovePacketTag (hopCountTag))
+  if (hopCount < 0 && payload->PeekPacketTag (hopCountTag))
     {
       hopCount = hopCountTag.Get ();
     }
@@ -149,19 +149,22 @@ Producer::OnInterest (const Ptr<const Interest> &interest, Ptr<Packet> origPacke
 
   NS_LOG_INFO ("node("<< GetNode()->GetId() <<") respodning with ContentObject:\n" << boost::cref(*header));
   
-  Ptr<Packet> packet = Create<Packet> (m_virtualPayloadSize);
-  
-  packet->AddHeader (*header);
-  packet->AddTrailer (tail);
+  Ptr<Packet> payload = Create<Packet> (m_virtualPayloadSize);
+
+  // Echo back hop count, either carried in the header or in FwHopCountTag
+  header->SetHopCount (interest->GetHopCount ());
 
-  // Echo back FwHopCountTag if exists
   FwHopCountTag hopCountTag;
-  if (origPacket->RemovePacketTag (hopCountTag))
+  if (origPacket->PeekPacketTag (hopCountTag))
     {
-      packet->AddPacketTag (hopCountTag);
+      payload->AddPacketTag (hopCountTag);
     }
 
-  m_protocolHandler (packet);
+  Ptr<Packet> packet = payload->Copy ();
+  packet->AddHeader (*header);
+  packet->AddTrailer (tail);
+
+  m_face->ReceiveData (header, payload, packet); // header is passed along, so the stack does not parse it again
   
   m_transmittedContentObjects (header, packet, this, m_face);
   
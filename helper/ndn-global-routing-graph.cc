@@ -0,0 +1,368 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil -*- */
+/*
+ * Copyright (c) 2011 UCLA
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ * Author:  Alexander Afanasyev <alexander.afanasyev@ucla.edu>
+ */
+
+#include "ndn-global-routing-graph.h"
+
+#include "ns3/ndn-face.h"
+#include "ns3/ndn-limits.h"
+#include "../model/ndn-global-router.h"
+
+#include "ns3/node.h"
+#include "ns3/channel.h"
+#include "ns3/node-list.h"
+#include "ns3/channel-list.h"
+#include "ns3/log.h"
+#include "ns3/assert.h"
+
+#include <algorithm>
+#include <functional>
+#include <boost/unordered_map.hpp>
+#include <boost/foreach.hpp>
+
+NS_LOG_COMPONENT_DEFINE ("ndn.GlobalRoutingGraph");
+
+namespace ns3 {
+namespace ndn {
+
+namespace
+{
+typedef std::greater< std::pair<uint32_t, uint32_t> > HeapCompare;
+
+struct PathChangeVertexLess
+{
+  bool
+  operator () (const GlobalRoutingGraph::PathChange &a, const GlobalRoutingGraph::PathChange &b) const
+  {
+    return a.m_vertex < b.m_vertex;
+  }
+};
+
+struct PathChangeVertexEqual
+{
+  bool
+  operator () (const GlobalRoutingGraph::PathChange &a, const GlobalRoutingGraph::PathChange &b) const
+  {
+    return a.m_vertex == b.m_vertex;
+  }
+};
+}
+
+const uint32_t GlobalRoutingGraph::INVALID;
+const uint32_t GlobalRoutingGraph::DISABLED;
+
+GlobalRoutingGraph::GlobalRoutingGraph ()
+  : m_nNodes (0)
+{
+  boost::unordered_map<const GlobalRouter*, uint32_t> index;
+
+  for (NodeList::Iterator node = NodeList::Begin (); node != NodeList::End (); node++)
+    {
+      Ptr<GlobalRouter> gr = (*node)->GetObject<GlobalRouter> ();
+      if (gr == 0)
+        continue;
+
+      index[PeekPointer (gr)] = m_routers.size ();
+      m_routers.push_back (gr);
+    }
+  m_nNodes = m_routers.size ();
+
+  for (ChannelList::Iterator channel = ChannelList::Begin (); channel != ChannelList::End (); channel++)
+    {
+      Ptr<GlobalRouter> gr = (*channel)->GetObject<GlobalRouter> ();
+      if (gr == 0)
+        continue;
+
+      index[PeekPointer (gr)] = m_routers.size ();
+      m_routers.push_back (gr);
+    }
+
+  m_offsets.reserve (m_routers.size () + 1);
+  m_offsets.push_back (0);
+  for (std::vector< Ptr<GlobalRouter> >::const_iterator router = m_routers.begin ();
+       router != m_routers.end ();
+       router++)
+    {
+      BOOST_FOREACH (const GlobalRouter::Incidency &edge, (*router)->GetIncidencies ())
+        {
+          boost::unordered_map<const GlobalRouter*, uint32_t>::const_iterator target =
+            index.find (PeekPointer (edge.get<2> ()));
+          NS_ASSERT_MSG (target != index.end (), "GlobalRouter is not installed on a node or a channel");
+
+          Ptr<Face> face = edge.get<1> ();
+          double delay = 0.0;
+          uint32_t metric = 0;
+          if (face != 0)
+            {
+              metric = face->IsUp () ? face->GetMetric () : DISABLED;
+              m_faceEdges[PeekPointer (face)] = m_targets.size ();
+
+              Ptr<Limits> limits = face->GetObject<Limits> ();
+              if (limits != 0) // valid limits object
+                {
+                  delay = limits->GetLinkDelay ();
+                }
+            }
+
+          m_sources.push_back (m_offsets.size () - 1);
+          m_targets.push_back (target->second);
+          m_metrics.push_back (metric);
+          m_delays.push_back (delay);
+          m_hasFace.push_back (face != 0);
+          m_faces.push_back (face);
+        }
+      m_offsets.push_back (m_targets.size ());
+    }
+
+  // group edges by target vertex (counting sort, edges of each target stay in the original order)
+  m_reverseOffsets.assign (m_routers.size () + 1, 0);
+  for (uint32_t edge = 0; edge < m_targets.size (); edge++)
+    {
+      m_reverseOffsets[m_targets[edge] + 1] ++;
+    }
+  for (uint32_t vertex = 0; vertex < m_routers.size (); vertex++)
+    {
+      m_reverseOffsets[vertex + 1] += m_reverseOffsets[vertex];
+    }
+  m_reverseEdges.resize (m_targets.size ());
+  std::vector<uint32_t> position (m_reverseOffsets.begin (), m_reverseOffsets.end () - 1);
+  for (uint32_t edge = 0; edge < m_targets.size (); edge++)
+    {
+      m_reverseEdges[position[m_targets[edge]] ++] = edge;
+    }
+
+  NS_LOG_DEBUG ("Compiled graph: " << m_routers.size () << " vertices (" << m_nNodes << " nodes), "
+                << m_targets.size () << " edges");
+}
+
+void
+GlobalRoutingGraph::ShortestPaths (uint32_t source, Paths &paths) const
+{
+  uint32_t nVertices = m_routers.size ();
+
+  paths.m_distance.assign (nVertices, std::numeric_limits<uint32_t>::max ());
+  paths.m_firstHop.assign (nVertices, INVALID);
+  paths.m_delay.assign (nVertices, 0.0);
+  paths.m_parent.assign (nVertices, INVALID);
+  paths.m_heap.clear ();
+
+  paths.m_distance[source] = 0;
+  paths.m_heap.push_back (std::make_pair (0, source));
+
+  RunDijkstra (paths, 0);
+}
+
+void
+GlobalRoutingGraph::ReverseShortestPaths (uint32_t destination, Paths &paths) const
+{
+  uint32_t nVertices = m_routers.size ();
+
+  paths.m_distance.assign (nVertices, std::numeric_limits<uint32_t>::max ());
+  paths.m_firstHop.assign (nVertices, INVALID);
+  paths.m_delay.assign (nVertices, 0.0);
+  paths.m_heap.clear ();
+
+  paths.m_distance[destination] = 0;
+  paths.m_heap.push_back (std::make_pair (0, destination));
+
+  while (!paths.m_heap.empty ())
+    {
+      std::pop_heap (paths.m_heap.begin (), paths.m_heap.end (), HeapCompare ());
+      uint32_t distance = paths.m_heap.back ().first;
+      uint32_t vertex = paths.m_heap.back ().second;
+      paths.m_heap.pop_back ();
+
+      if (distance > paths.m_distance[vertex])
+        continue; // stale queue element
+
+      for (uint32_t i = m_reverseOffsets[vertex]; i < m_reverseOffsets[vertex + 1]; i++)
+        {
+          uint32_t edge = m_reverseEdges[i];
+          if (m_metrics[edge] == DISABLED)
+            continue;
+
+          uint32_t source = m_sources[edge];
+          uint32_t newDistance = distance + m_metrics[edge];
+          if (newDistance >= paths.m_distance[source])
+            continue;
+
+          paths.m_distance[source] = newDistance;
+          paths.m_delay[source] = paths.m_delay[vertex] + m_delays[edge];
+          paths.m_firstHop[source] = edge;
+
+          paths.m_heap.push_back (std::make_pair (newDistance, source));
+          std::push_heap (paths.m_heap.begin (), paths.m_heap.end (), HeapCompare ());
+        }
+    }
+}
+
+uint32_t
+GlobalRoutingGraph::FindEdge (Ptr<Face> face) const
+{
+  boost::unordered_map<const Face*, uint32_t>::const_iterator edge = m_faceEdges.find (PeekPointer (face));
+  if (edge == m_faceEdges.end ())
+    return INVALID;
+
+  return edge->second;
+}
+
+void
+GlobalRoutingGraph::UpdateShortestPaths (uint32_t source, uint32_t edge, uint32_t oldMetric,
+                                         Paths &paths, std::vector<PathChange> &changes) const
+{
+  uint32_t newMetric = m_metrics[edge];
+  if (newMetric == oldMetric)
+    return;
+
+  size_t firstChange = changes.size ();
+  paths.m_heap.clear ();
+
+  if (newMetric == DISABLED || (oldMetric != DISABLED && newMetric > oldMetric))
+    {
+      uint32_t target = m_targets[edge];
+      if (paths.m_parent[target] != edge)
+        return; // edge is not used by any shortest path
+
+      // collect subtree below the edge (breadth-first, using changes as a queue)
+      changes.push_back (Snapshot (target, paths));
+      for (size_t i = firstChange; i < changes.size (); i++)
+        {
+          uint32_t vertex = changes[i].m_vertex;
+          for (uint32_t child = m_offsets[vertex]; child < m_offsets[vertex + 1]; child++)
+            {
+              if (paths.m_parent[m_targets[child]] == child)
+                changes.push_back (Snapshot (m_targets[child], paths));
+            }
+        }
+
+      for (size_t i = firstChange; i < changes.size (); i++)
+        {
+          uint32_t vertex = changes[i].m_vertex;
+          paths.m_distance[vertex] = std::numeric_limits<uint32_t>::max ();
+          paths.m_firstHop[vertex] = INVALID;
+          paths.m_delay[vertex] = 0.0;
+          paths.m_parent[vertex] = INVALID;
+        }
+
+      // vertices of the subtree can now be reached only from vertices outside of it
+      for (size_t i = firstChange; i < changes.size (); i++)
+        {
+          uint32_t vertex = changes[i].m_vertex;
+          for (uint32_t j = m_reverseOffsets[vertex]; j < m_reverseOffsets[vertex + 1]; j++)
+            {
+              uint32_t in = m_reverseEdges[j];
+              if (paths.m_distance[m_sources[in]] != std::numeric_limits<uint32_t>::max ())
+                Relax (m_sources[in], in, paths, 0);
+            }
+        }
+
+      // only vertices of the subtree can improve, they all are already recorded
+      RunDijkstra (paths, 0);
+    }
+  else
+    {
+      // all new shortest paths go through the edge
+      if (paths.m_distance[m_sources[edge]] == std::numeric_limits<uint32_t>::max ())
+        return;
+
+      if (!Relax (m_sources[edge], edge, paths, &changes))
+        return;
+
+      RunDijkstra (paths, &changes);
+
+      // vertex could improve several times, only the first record has its original state
+      std::stable_sort (changes.begin () + firstChange, changes.end (), PathChangeVertexLess ());
+      changes.erase (std::unique (changes.begin () + firstChange, changes.end (), PathChangeVertexEqual ()),
+                     changes.end ());
+    }
+
+  // report only vertices that actually changed
+  size_t last = firstChange;
+  for (size_t i = firstChange; i < changes.size (); i++)
+    {
+      const PathChange &change = changes[i];
+      if (change.m_firstHop != paths.m_firstHop[change.m_vertex] ||
+          change.m_distance != paths.m_distance[change.m_vertex] ||
+          change.m_delay    != paths.m_delay[change.m_vertex])
+        changes[last++] = change;
+    }
+  changes.resize (last);
+}
+
+bool
+GlobalRoutingGraph::Relax (uint32_t vertex, uint32_t edge, Paths &paths, std::vector<PathChange> *changes) const
+{
+  if (m_metrics[edge] == DISABLED)
+    return false;
+
+  uint32_t target = m_targets[edge];
+  uint32_t newDistance = paths.m_distance[vertex] + m_metrics[edge];
+  if (newDistance >= paths.m_distance[target])
+    return false;
+
+  if (changes != 0)
+    changes->push_back (Snapshot (target, paths));
+
+  paths.m_distance[target] = newDistance;
+  paths.m_delay[target] = paths.m_delay[vertex] + m_delays[edge];
+  paths.m_parent[target] = edge;
+  // path inherits the first face on the way from the source
+  if (paths.m_firstHop[vertex] != INVALID)
+    paths.m_firstHop[target] = paths.m_firstHop[vertex];
+  else
+    paths.m_firstHop[target] = m_hasFace[edge] ? edge : INVALID;
+
+  paths.m_heap.push_back (std::make_pair (newDistance, target));
+  std::push_heap (paths.m_heap.begin (), paths.m_heap.end (), HeapCompare ());
+  return true;
+}
+
+void
+GlobalRoutingGraph::RunDijkstra (Paths &paths, std::vector<PathChange> *changes) const
+{
+  while (!paths.m_heap.empty ())
+    {
+      std::pop_heap (paths.m_heap.begin (), paths.m_heap.end (), HeapCompare ());
+      uint32_t distance = paths.m_heap.back ().first;
+      uint32_t vertex = paths.m_heap.back ().second;
+      paths.m_heap.pop_back ();
+
+      if (distance > paths.m_distance[vertex])
+        continue; // stale queue element
+
+      for (uint32_t edge = m_offsets[vertex]; edge < m_offsets[vertex + 1]; edge++)
+        {
+          Relax (vertex, edge, paths, changes);
+        }
+    }
+}
+
+GlobalRoutingGraph::PathChange
+GlobalRoutingGraph::Snapshot (uint32_t vertex, const Paths &paths)
+{
+  PathChange change;
+  change.m_vertex   = vertex;
+  change.m_firstHop = paths.m_firstHop[vertex];
+  change.m_distance = paths.m_distance[vertex];
+  change.m_delay    = paths.m_delay[vertex];
+  return change;
+}
+
+} // namespace ndn
+} // namespace ns3
@@ -0,0 +1,284 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil -*- */
+/*
+ * Copyright (c) 2011 UCLA
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ * Author:  Alexander Afanasyev <alexander.afanasyev@ucla.edu>
+ */
+
+#ifndef NDN_GLOBAL_ROUTING_GRAPH_H
+#define NDN_GLOBAL_ROUTING_GRAPH_H
+
+/// @cond include_hidden
+
+#include "ns3/ptr.h"
+
+#include <vector>
+#include <limits>
+#include <utility>
+#include <boost/unordered_map.hpp>
+
+namespace ns3 {
+namespace ndn {
+
+class GlobalRouter;
+class Face;
+
+/**
+ * @ingroup ndn
+ * @brief Compact snapshot of the graph formed by GlobalRouter objects
+ *
+ * All GlobalRouter objects are numbered consecutively (routers installed on nodes first, in
+ * NodeList order, followed by routers installed on channels) and outgoing edges of each vertex
+ * are stored in contiguous arrays (compressed sparse row format).  Face metrics and link delays
+ * are copied when the graph is compiled, so shortest path calculations do not touch any ns-3
+ * objects and can safely run in parallel on the same graph.
+ */
+class GlobalRoutingGraph
+{
+public:
+  static const uint32_t INVALID = std::numeric_limits<uint32_t>::max (); ///< @brief Invalid vertex or edge index
+  static const uint32_t DISABLED = std::numeric_limits<uint32_t>::max (); ///< @brief Metric of the edge that cannot be used (face is down)
+
+  /**
+   * @brief Result of single-source shortest path calculation
+   *
+   * Object also serves as a scratch space for the calculation and should be reused between
+   * calculations (one object per thread) to avoid memory reallocations
+   */
+  struct Paths
+  {
+    std::vector<uint32_t> m_distance; ///< @brief Sum of metrics along the shortest path to the vertex
+    std::vector<uint32_t> m_firstHop; ///< @brief Edge from the source that starts the shortest path (INVALID if unreachable).
+                                      ///<        For paths toward the destination, edge from the vertex that starts the path
+    std::vector<double>   m_delay;    ///< @brief Sum of link delays along the shortest path to the vertex
+    std::vector<uint32_t> m_parent;   ///< @brief Last edge of the shortest path from the source (INVALID if unreachable).
+                                      ///<        Not calculated for paths toward the destination
+
+    std::vector< std::pair<uint32_t, uint32_t> > m_heap; ///< @brief Priority queue of (distance, vertex)
+  };
+
+  /**
+   * @brief Previous state of the vertex, which shortest path has been changed by UpdateShortestPaths
+   */
+  struct PathChange
+  {
+    uint32_t m_vertex;   ///< @brief Vertex index
+    uint32_t m_firstHop; ///< @brief Previous first-hop edge
+    uint32_t m_distance; ///< @brief Previous distance
+    double   m_delay;    ///< @brief Previous delay
+  };
+
+  /**
+   * @brief Compile graph from GlobalRouter objects installed on nodes and channels
+   *
+   * Edges of faces that are down get DISABLED metric
+   */
+  GlobalRoutingGraph ();
+
+  /**
+   * @brief Get total number of vertices in the graph
+   */
+  inline uint32_t
+  GetNVertices () const;
+
+  /**
+   * @brief Get number of vertices that correspond to nodes
+   *
+   * Node vertices have indexes [0, GetNNodes ())
+   */
+  inline uint32_t
+  GetNNodes () const;
+
+  /**
+   * @brief Get GlobalRouter object of the vertex
+   */
+  inline Ptr<GlobalRouter>
+  GetRouter (uint32_t vertex) const;
+
+  /**
+   * @brief Get range [first, last) of indexes of edges originating from the vertex
+   */
+  inline std::pair<uint32_t, uint32_t>
+  GetEdges (uint32_t vertex) const;
+
+  /**
+   * @brief Get target vertex of the edge
+   */
+  inline uint32_t
+  GetTarget (uint32_t edge) const;
+
+  /**
+   * @brief Get face of the edge (can be 0, e.g., for edges to/from multi-access channels)
+   */
+  inline Ptr<Face>
+  GetFace (uint32_t edge) const;
+
+  /**
+   * @brief Get metric of the edge
+   */
+  inline uint32_t
+  GetMetric (uint32_t edge) const;
+
+  /**
+   * @brief Change metric of the edge (shortest paths calculated before should be updated using UpdateShortestPaths)
+   */
+  inline void
+  SetMetric (uint32_t edge, uint32_t metric);
+
+  /**
+   * @brief Find edge that corresponds to the face
+   * @returns edge index or INVALID if face is not part of the graph
+   */
+  uint32_t
+  FindEdge (Ptr<Face> face) const;
+
+  /**
+   * @brief Get link delay of the edge
+   */
+  inline double
+  GetDelay (uint32_t edge) const;
+
+  /**
+   * @brief Calculate shortest paths from the source vertex to all other vertices
+   *
+   * Only metrics are considered when comparing paths, delays are just accumulated along the
+   * selected paths.  The method is thread-safe, as long as each thread uses its own paths object.
+   */
+  void
+  ShortestPaths (uint32_t source, Paths &paths) const;
+
+  /**
+   * @brief Calculate shortest paths from all vertices toward the destination vertex
+   *
+   * The calculation runs over reversed edges, so a single call yields distances to the destination
+   * from every vertex (the reverse shortest path tree).  The method is thread-safe, as long as each
+   * thread uses its own paths object.
+   */
+  void
+  ReverseShortestPaths (uint32_t destination, Paths &paths) const;
+
+  /**
+   * @brief Update shortest paths from the source after metric of the edge has been changed
+   *
+   * If metric has increased (or edge has been disabled) and edge belongs to the shortest path tree,
+   * only the subtree below the edge is recalculated.  If metric has decreased, only vertices which
+   * paths become shorter are visited.  In all other cases shortest paths stay the same.
+   *
+   * @param source    Source of the shortest path tree
+   * @param edge      Edge, which metric has been changed with SetMetric
+   * @param oldMetric Metric of the edge that was used to calculate the paths
+   * @param paths     Shortest paths (as calculated by ShortestPaths), updated in place
+   * @param changes   Vector, to which previous state of all vertices with changed paths will be appended
+   */
+  void
+  UpdateShortestPaths (uint32_t source, uint32_t edge, uint32_t oldMetric,
+                       Paths &paths, std::vector<PathChange> &changes) const;
+
+private:
+  /**
+   * @brief Try to improve path to the target of the edge (optionally recording previous state of the target)
+   */
+  bool
+  Relax (uint32_t vertex, uint32_t edge, Paths &paths, std::vector<PathChange> *changes) const;
+
+  /**
+   * @brief Run Dijkstra algorithm from the vertices that are already in the queue
+   */
+  void
+  RunDijkstra (Paths &paths, std::vector<PathChange> *changes) const;
+
+  static PathChange
+  Snapshot (uint32_t vertex, const Paths &paths);
+
+private:
+  std::vector< Ptr<GlobalRouter> > m_routers;
+
+  std::vector<uint32_t>  m_offsets;  ///< @brief Edges of vertex i are [m_offsets[i], m_offsets[i+1])
+  std::vector<uint32_t>  m_targets;  ///< @brief Target vertex of each edge
+  std::vector<uint32_t>  m_metrics;  ///< @brief Metric of each edge
+  std::vector<double>    m_delays;   ///< @brief Link delay of each edge
+  std::vector<uint8_t>   m_hasFace;  ///< @brief Whether edge has an associated face
+  std::vector< Ptr<Face> > m_faces;  ///< @brief Face of each edge (not used during the calculations)
+
+  std::vector<uint32_t>  m_sources;         ///< @brief Source vertex of each edge
+  std::vector<uint32_t>  m_reverseOffsets;  ///< @brief Edges ending at vertex i are m_reverseEdges[m_reverseOffsets[i]..m_reverseOffsets[i+1])
+  std::vector<uint32_t>  m_reverseEdges;    ///< @brief Edge indexes, grouped by target vertex
+
+  boost::unordered_map<const Face*, uint32_t> m_faceEdges; ///< @brief Index of edges by face
+
+  uint32_t m_nNodes;
+};
+
+uint32_t
+GlobalRoutingGraph::GetNVertices () const
+{
+  return m_routers.size ();
+}
+
+uint32_t
+GlobalRoutingGraph::GetNNodes () const
+{
+  return m_nNodes;
+}
+
+Ptr<GlobalRouter>
+GlobalRoutingGraph::GetRouter (uint32_t vertex) const
+{
+  return m_routers[vertex];
+}
+
+std::pair<uint32_t, uint32_t>
+GlobalRoutingGraph::GetEdges (uint32_t vertex) const
+{
+  return std::make_pair (m_offsets[vertex], m_offsets[vertex + 1]);
+}
+
+uint32_t
+GlobalRoutingGraph::GetTarget (uint32_t edge) const
+{
+  return m_targets[edge];
+}
+
+Ptr<Face>
+GlobalRoutingGraph::GetFace (uint32_t edge) const
+{
+  return m_faces[edge];
+}
+
+uint32_t
+GlobalRoutingGraph::GetMetric (uint32_t edge) const
+{
+  return m_metrics[edge];
+}
+
+void
+GlobalRoutingGraph::SetMetric (uint32_t edge, uint32_t metric)
+{
+  m_metrics[edge] = metric;
+}
+
+double
+GlobalRoutingGraph::GetDelay (uint32_t edge) const
+{
+  return m_delays[edge];
+}
+
+} // namespace ndn
+} // namespace ns3
+
+/// @endcond
+
+#endif // NDN_GLOBAL_ROUTING_GRAPH_H
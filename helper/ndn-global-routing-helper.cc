@@ -25,6 +25,8 @@
 #include "../model/ndn-global-router.h"
 #include "ns3/ndn-name.h"
 #include "ns3/ndn-fib.h"
+#include "ns3/ndn-face.h"
+#include "ns3/ndn-limits.h"
 
 #include "ns3/node.h"
 #include "ns3/node-container.h"
@@ -36,17 +38,30 @@
 #include "ns3/node-list.h"
 #include "ns3/channel-list.h"
 #include "ns3/object-factory.h"
+#include "ns3/simulator.h"
 
 #include <boost/lexical_cast.hpp>
 #include <boost/foreach.hpp>
-#include <boost/concept/assert.hpp>
-// #include <boost/graph/graph_concepts.hpp>
-// #include <boost/graph/adjacency_list.hpp>
-#include <boost/graph/dijkstra_shortest_paths.hpp>
+#include <boost/shared_ptr.hpp>
+#include <boost/make_shared.hpp>
 
-#include "boost-graph-ndn-global-routing-helper.h"
+#include "ndn-global-routing-graph.h"
+
+#include "ns3/core-config.h"
+#ifdef HAVE_PTHREAD_H
+#include "ns3/system-thread.h"
+#endif
 
 #include <math.h>
+#include <string.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <algorithm>
+#include <limits>
+#include <fstream>
+#include <map>
 
 NS_LOG_COMPONENT_DEFINE ("ndn.GlobalRoutingHelper");
 
@@ -56,6 +71,687 @@ using namespace boost;
 namespace ns3 {
 namespace ndn {
 
+uint32_t GlobalRoutingHelper::m_nThreads = 0;
+bool GlobalRoutingHelper::m_dynamicRouting = false;
+
+namespace
+{
+/**
+ * @brief Number of sources processed by each thread before routes are installed into FIBs
+ */
+const uint32_t ROUTES_BATCH_PER_THREAD = 16;
+
+/**
+ * @brief Shortest path from a source node to a prefix origin
+ */
+struct Route
+{
+  uint32_t m_edge;   ///< \brief First-hop edge (GlobalRoutingGraph::INVALID if origin is unreachable)
+  uint32_t m_metric; ///< \brief Total metric of the path
+  double   m_delay;  ///< \brief Total link delay along the path
+};
+
+/**
+ * @brief Calculates shortest paths from every step-th source of the batch
+ *
+ * Each worker has its own scratch space and writes to its own rows of the shared route table
+ * (and to its own elements of the tree vector)
+ */
+class RouteWorker
+{
+public:
+  RouteWorker (const GlobalRoutingGraph &graph, const std::vector<uint32_t> &origins, std::vector<Route> &routes,
+               std::vector<GlobalRoutingGraph::Paths> *trees)
+    : m_graph (&graph)
+    , m_origins (&origins)
+    , m_routes (&routes)
+    , m_trees (trees)
+    , m_batchStart (0)
+    , m_batchSize (0)
+    , m_first (0)
+    , m_step (1)
+  {
+  }
+
+  void
+  Setup (uint32_t batchStart, uint32_t batchSize, uint32_t first, uint32_t step)
+  {
+    m_batchStart = batchStart;
+    m_batchSize = batchSize;
+    m_first = first;
+    m_step = step;
+  }
+
+  void
+  Run ()
+  {
+    const std::vector<uint32_t> &origins = *m_origins;
+    for (uint32_t i = m_first; i < m_batchSize; i += m_step)
+      {
+        m_graph->ShortestPaths (m_batchStart + i, m_paths);
+
+        Route *row = &(*m_routes)[i * origins.size ()];
+        for (uint32_t j = 0; j < origins.size (); j++)
+          {
+            row[j].m_edge   = m_paths.m_firstHop[origins[j]];
+            row[j].m_metric = m_paths.m_distance[origins[j]];
+            row[j].m_delay  = m_paths.m_delay[origins[j]];
+          }
+
+        if (m_trees != 0)
+          (*m_trees)[m_batchStart + i] = m_paths;
+      }
+  }
+
+private:
+  const GlobalRoutingGraph *m_graph;
+  const std::vector<uint32_t> *m_origins;
+  std::vector<Route> *m_routes;
+  std::vector<GlobalRoutingGraph::Paths> *m_trees; ///< \brief If not 0, shortest path trees are saved for dynamic routing
+
+  uint32_t m_batchStart;
+  uint32_t m_batchSize;
+  uint32_t m_first;
+  uint32_t m_step;
+
+  GlobalRoutingGraph::Paths m_paths;
+};
+
+/**
+ * @brief Calculates reverse shortest path trees toward every step-th origin of the batch
+ */
+class TreeWorker
+{
+public:
+  TreeWorker (const GlobalRoutingGraph &graph, const std::vector<uint32_t> &origins,
+              std::vector<GlobalRoutingGraph::Paths> &trees)
+    : m_graph (&graph)
+    , m_origins (&origins)
+    , m_trees (&trees)
+    , m_batchStart (0)
+    , m_batchSize (0)
+    , m_first (0)
+    , m_step (1)
+  {
+  }
+
+  void
+  Setup (uint32_t batchStart, uint32_t batchSize, uint32_t first, uint32_t step)
+  {
+    m_batchStart = batchStart;
+    m_batchSize = batchSize;
+    m_first = first;
+    m_step = step;
+  }
+
+  void
+  Run ()
+  {
+    for (uint32_t i = m_first; i < m_batchSize; i += m_step)
+      {
+        m_graph->ReverseShortestPaths ((*m_origins)[m_batchStart + i], (*m_trees)[i]);
+      }
+  }
+
+private:
+  const GlobalRoutingGraph *m_graph;
+  const std::vector<uint32_t> *m_origins;
+  std::vector<GlobalRoutingGraph::Paths> *m_trees;
+
+  uint32_t m_batchStart;
+  uint32_t m_batchSize;
+  uint32_t m_first;
+  uint32_t m_step;
+};
+
+/**
+ * @brief Pre-order numbering of the reverse shortest path tree
+ *
+ * Path from a vertex toward the origin passes through another vertex if and only if the vertex belongs
+ * to the subtree of the other vertex, that is, its number is inside the interval of numbers of that subtree
+ */
+class TreeOrder
+{
+public:
+  void
+  Build (const GlobalRoutingGraph &graph, const GlobalRoutingGraph::Paths &tree, uint32_t origin)
+  {
+    uint32_t nVertices = graph.GetNVertices ();
+
+    // children of vertex v are m_children[m_offset[v]], ..., m_children[m_offset[v + 1] - 1]
+    m_offset.assign (nVertices + 1, 0);
+    for (uint32_t vertex = 0; vertex < nVertices; vertex++)
+      {
+        if (vertex != origin && tree.m_firstHop[vertex] != GlobalRoutingGraph::INVALID)
+          m_offset[graph.GetTarget (tree.m_firstHop[vertex]) + 1] ++;
+      }
+    for (uint32_t vertex = 0; vertex < nVertices; vertex++)
+      {
+        m_offset[vertex + 1] += m_offset[vertex];
+      }
+
+    m_children.resize (nVertices);
+    m_next.assign (m_offset.begin (), m_offset.end () - 1);
+    for (uint32_t vertex = 0; vertex < nVertices; vertex++)
+      {
+        if (vertex != origin && tree.m_firstHop[vertex] != GlobalRoutingGraph::INVALID)
+          m_children[m_next[graph.GetTarget (tree.m_firstHop[vertex])] ++] = vertex;
+      }
+
+    // iterative depth-first traversal from the origin (m_next is reused as the position in the list of children)
+    m_enter.assign (nVertices, GlobalRoutingGraph::INVALID);
+    m_exit.assign (nVertices, 0);
+    m_next.assign (m_offset.begin (), m_offset.end () - 1);
+
+    uint32_t counter = 0;
+    m_enter[origin] = counter++;
+    m_stack.assign (1, origin);
+    while (!m_stack.empty ())
+      {
+        uint32_t vertex = m_stack.back ();
+        if (m_next[vertex] < m_offset[vertex + 1])
+          {
+            uint32_t child = m_children[m_next[vertex] ++];
+            m_enter[child] = counter++;
+            m_stack.push_back (child);
+          }
+        else
+          {
+            m_exit[vertex] = counter;
+            m_stack.pop_back ();
+          }
+      }
+  }
+
+  /**
+   * @brief Check if shortest path from the vertex toward the origin passes through another vertex
+   */
+  bool
+  PassesThrough (uint32_t vertex, uint32_t through) const
+  {
+    if (m_enter[vertex] == GlobalRoutingGraph::INVALID || m_enter[through] == GlobalRoutingGraph::INVALID)
+      return false;
+
+    return m_enter[through] <= m_enter[vertex] && m_enter[vertex] < m_exit[through];
+  }
+
+private:
+  std::vector<uint32_t> m_offset;
+  std::vector<uint32_t> m_children;
+  std::vector<uint32_t> m_next;
+  std::vector<uint32_t> m_enter;
+  std::vector<uint32_t> m_exit;
+  std::vector<uint32_t> m_stack;
+};
+
+/**
+ * @brief Run all workers, each in a separate thread (if supported), and wait until they finish
+ *
+ * Workers should only read the graph and write to their own scratch space and results.  In particular,
+ * they must not create or release Name, Interest, ContentObject, or other objects that use ObjectPool,
+ * because the pool is not thread-safe (FIBs are updated by the main thread after workers finish).
+ */
+template<class Worker>
+void
+RunWorkers (std::vector<Worker> &workers)
+{
+#ifdef HAVE_PTHREAD_H
+  if (workers.size () > 1)
+    {
+      std::vector< Ptr<SystemThread> > threads;
+      for (uint32_t thread = 0; thread < workers.size (); thread++)
+        {
+          threads.push_back (Create<SystemThread> (MakeCallback (&Worker::Run, &workers[thread])));
+          threads.back ()->Start ();
+        }
+      for (uint32_t thread = 0; thread < threads.size (); thread++)
+        {
+          threads[thread]->Join ();
+        }
+      return;
+    }
+#endif
+
+  for (uint32_t thread = 0; thread < workers.size (); thread++)
+    {
+      workers[thread].Run ();
+    }
+}
+
+/**
+ * @brief Collect vertices that originate at least one prefix
+ */
+std::vector<uint32_t>
+GetOrigins (const GlobalRoutingGraph &graph)
+{
+  std::vector<uint32_t> origins;
+  for (uint32_t vertex = 0; vertex < graph.GetNVertices (); vertex++)
+    {
+      if (!graph.GetRouter (vertex)->GetLocalPrefixes ().empty ())
+        origins.push_back (vertex);
+    }
+  return origins;
+}
+
+/**
+ * @brief Add (or update) route to the prefix via the face and adjust FIB limits, if any
+ */
+void
+InstallRoute (Ptr<Fib> fib, const Ptr<const Name> &prefix, Ptr<Face> face, uint32_t metric, double delay)
+{
+  NS_LOG_DEBUG (" prefix " << *prefix << " reachable via face " << *face
+                << " with distance " << metric
+                << " with delay " << delay);
+
+  Ptr<fib::Entry> entry = fib->Add (prefix, face, metric);
+  entry->SetRealDelayToProducer (face, Seconds (delay));
+
+  Ptr<Limits> faceLimits = face->GetObject<Limits> ();
+
+  Ptr<Limits> fibLimits = entry->GetObject<Limits> ();
+  if (fibLimits != 0)
+    {
+      // if it was created by the forwarding strategy via DidAddFibEntry event
+      fibLimits->SetLimits (faceLimits->GetMaxRate (), 2 * delay /*exact RTT*/);
+      NS_LOG_DEBUG ("Set limit for prefix " << *prefix << " " << faceLimits->GetMaxRate () << " / " <<
+                    2*delay << "s (" << faceLimits->GetMaxRate () * 2 * delay << ")");
+    }
+}
+
+/**
+ * @brief Graph and shortest path trees of all nodes, kept by CalculateRoutes when dynamic routing is enabled
+ */
+struct DynamicRoutingState
+{
+  /**
+   * @brief All origins of the prefix (the same prefix can be announced by several origins)
+   */
+  struct PrefixOrigins
+  {
+    Ptr<const Name> m_prefix;
+    std::vector<uint32_t> m_origins; ///< \brief Sorted list of origin vertices of the prefix
+  };
+  typedef std::map<Name, PrefixOrigins> PrefixOriginsMap;
+
+  GlobalRoutingGraph m_graph;
+  std::vector<uint32_t> m_origins;                  ///< \brief Sorted list of origin vertices
+  std::vector<GlobalRoutingGraph::Paths> m_trees;   ///< \brief Shortest path tree of each node
+  PrefixOriginsMap m_prefixes;                      ///< \brief Origins of each prefix
+};
+
+boost::shared_ptr<DynamicRoutingState> g_dynamicRoutingState;
+
+void
+ResetDynamicRoutingState ()
+{
+  g_dynamicRoutingState.reset ();
+}
+
+/**
+ * @brief Magic bytes at the beginning of the file with saved routes
+ */
+const char ROUTES_FILE_MAGIC[8] = { 'n', 'd', 'n', 'S', 'I', 'M', 'F', 'B' };
+const uint32_t ROUTES_FILE_VERSION = 1;
+
+/**
+ * @brief 64-bit FNV-1a hash, used as a topology fingerprint
+ */
+class Fingerprint
+{
+public:
+  Fingerprint ()
+    : m_hash (0xcbf29ce484222325ULL)
+  {
+  }
+
+  void
+  Add (uint64_t value)
+  {
+    for (int i = 0; i < 8; i++)
+      {
+        AddByte (static_cast<uint8_t> (value >> (8 * i)));
+      }
+  }
+
+  void
+  Add (const std::string &value)
+  {
+    Add (value.size ());
+    for (std::string::const_iterator i = value.begin (); i != value.end (); i++)
+      {
+        AddByte (static_cast<uint8_t> (*i));
+      }
+  }
+
+  uint64_t
+  Get () const
+  {
+    return m_hash;
+  }
+
+private:
+  void
+  AddByte (uint8_t byte)
+  {
+    m_hash ^= byte;
+    m_hash *= 0x100000001b3ULL;
+  }
+
+private:
+  uint64_t m_hash;
+};
+
+/**
+ * @brief Calculate fingerprint of everything that affects routes: nodes, faces, metrics, links,
+ *        link delays, and prefix origins
+ */
+uint64_t
+GetTopologyFingerprint ()
+{
+  Fingerprint fingerprint;
+  for (NodeList::Iterator node = NodeList::Begin (); node != NodeList::End (); node++)
+    {
+      Ptr<L3Protocol> l3 = (*node)->GetObject<L3Protocol> ();
+      if (l3 == 0)
+        continue;
+
+      fingerprint.Add ((*node)->GetId ());
+      fingerprint.Add (l3->GetNFaces ());
+      for (uint32_t faceId = 0; faceId < l3->GetNFaces (); faceId++)
+        {
+          Ptr<Face> face = l3->GetFace (faceId);
+          fingerprint.Add (face->GetId ());
+          fingerprint.Add (face->GetMetric ());
+          fingerprint.Add (face->IsUp ());
+
+          Ptr<Limits> limits = face->GetObject<Limits> ();
+          if (limits != 0)
+            {
+              double delay = limits->GetLinkDelay ();
+              uint64_t bits;
+              memcpy (&bits, &delay, sizeof (bits));
+              fingerprint.Add (bits);
+            }
+
+          Ptr<NetDeviceFace> netDeviceFace = DynamicCast<NetDeviceFace> (face);
+          if (netDeviceFace == 0 || netDeviceFace->GetNetDevice ()->GetChannel () == 0)
+            continue;
+
+          Ptr<Channel> channel = netDeviceFace->GetNetDevice ()->GetChannel ();
+          for (uint32_t deviceId = 0; deviceId < channel->GetNDevices (); deviceId++)
+            {
+              fingerprint.Add (channel->GetDevice (deviceId)->GetNode ()->GetId ());
+            }
+        }
+
+      Ptr<GlobalRouter> gr = (*node)->GetObject<GlobalRouter> ();
+      if (gr != 0)
+        {
+          BOOST_FOREACH (const Ptr<Name> &prefix, gr->GetLocalPrefixes ())
+            {
+              fingerprint.Add (prefix->ToString ());
+            }
+        }
+    }
+  return fingerprint.Get ();
+}
+
+/**
+ * @brief Writes integers in little-endian byte order
+ */
+class RoutesWriter
+{
+public:
+  RoutesWriter (std::ostream &os)
+    : m_os (os)
+  {
+  }
+
+  void
+  WriteU8 (uint8_t value)
+  {
+    m_os.put (static_cast<char> (value));
+  }
+
+  void
+  WriteU32 (uint32_t value)
+  {
+    for (int i = 0; i < 4; i++)
+      WriteU8 (static_cast<uint8_t> (value >> (8 * i)));
+  }
+
+  void
+  WriteU64 (uint64_t value)
+  {
+    for (int i = 0; i < 8; i++)
+      WriteU8 (static_cast<uint8_t> (value >> (8 * i)));
+  }
+
+  void
+  WriteDouble (double value)
+  {
+    uint64_t bits;
+    memcpy (&bits, &value, sizeof (bits));
+    WriteU64 (bits);
+  }
+
+  void
+  WriteString (const std::string &value)
+  {
+    WriteU32 (value.size ());
+    m_os.write (value.data (), value.size ());
+  }
+
+private:
+  std::ostream &m_os;
+};
+
+/**
+ * @brief Reads data written by RoutesWriter from memory, checking boundaries
+ *
+ * If there is not enough data, reader switches to failed state and returns zeros
+ */
+class RoutesReader
+{
+public:
+  RoutesReader (const uint8_t *data, size_t size)
+    : m_data (data)
+    , m_end (data + size)
+    , m_ok (true)
+  {
+  }
+
+  bool
+  IsOk () const
+  {
+    return m_ok;
+  }
+
+  size_t
+  GetRemainingSize () const
+  {
+    return m_end - m_data;
+  }
+
+  const uint8_t *
+  Skip (size_t size)
+  {
+    if (!m_ok || static_cast<size_t> (m_end - m_data) < size)
+      {
+        m_ok = false;
+        return 0;
+      }
+
+    const uint8_t *data = m_data;
+    m_data += size;
+    return data;
+  }
+
+  uint8_t
+  ReadU8 ()
+  {
+    const uint8_t *data = Skip (1);
+    return data != 0 ? data[0] : 0;
+  }
+
+  uint32_t
+  ReadU32 ()
+  {
+    const uint8_t *data = Skip (4);
+    if (data == 0)
+      return 0;
+
+    uint32_t value = 0;
+    for (int i = 3; i >= 0; i--)
+      value = (value << 8) | data[i];
+    return value;
+  }
+
+  uint64_t
+  ReadU64 ()
+  {
+    const uint8_t *data = Skip (8);
+    if (data == 0)
+      return 0;
+
+    uint64_t value = 0;
+    for (int i = 7; i >= 0; i--)
+      value = (value << 8) | data[i];
+    return value;
+  }
+
+  double
+  ReadDouble ()
+  {
+    uint64_t bits = ReadU64 ();
+    double value;
+    memcpy (&value, &bits, sizeof (value));
+    return value;
+  }
+
+  std::string
+  ReadString ()
+  {
+    uint32_t size = ReadU32 ();
+    const uint8_t *data = Skip (size);
+    if (data == 0)
+      return std::string ();
+
+    return std::string (reinterpret_cast<const char*> (data), size);
+  }
+
+private:
+  const uint8_t *m_data;
+  const uint8_t *m_end;
+  bool m_ok;
+};
+
+/**
+ * @brief Read per-node FIB section of the saved routes and, if requested, install routes
+ * @returns false if data is corrupted or does not match the current topology
+ */
+bool
+ReadFibs (RoutesReader &reader, const std::vector< Ptr<const Name> > &prefixes, bool install)
+{
+  uint32_t nNodes = reader.ReadU32 ();
+  for (uint32_t i = 0; i < nNodes && reader.IsOk (); i++)
+    {
+      uint32_t nodeId = reader.ReadU32 ();
+      uint32_t nEntries = reader.ReadU32 ();
+      if (!reader.IsOk () || nodeId >= NodeList::GetNNodes ())
+        return false;
+
+      Ptr<Node> node = NodeList::GetNode (nodeId);
+      Ptr<L3Protocol> l3 = node->GetObject<L3Protocol> ();
+      Ptr<Fib> fib = node->GetObject<Fib> ();
+      if (l3 == 0 || fib == 0)
+        return false;
+
+      for (uint32_t j = 0; j < nEntries && reader.IsOk (); j++)
+        {
+          uint32_t prefixIndex = reader.ReadU32 ();
+          uint32_t nFaces = reader.ReadU32 ();
+          if (!reader.IsOk () || prefixIndex >= prefixes.size ())
+            return false;
+
+          for (uint32_t k = 0; k < nFaces && reader.IsOk (); k++)
+            {
+              uint32_t faceId = reader.ReadU32 ();
+              int32_t cost = static_cast<int32_t> (reader.ReadU32 ());
+              uint8_t status = reader.ReadU8 ();
+              double delay = reader.ReadDouble ();
+
+              Ptr<Face> face = l3->GetFaceById (faceId);
+              if (!reader.IsOk () || face == 0 ||
+                  status < fib::FaceMetric::NDN_FIB_GREEN || status > fib::FaceMetric::NDN_FIB_RED)
+                return false;
+
+              if (!install)
+                continue;
+
+              if (status == fib::FaceMetric::NDN_FIB_RED)
+                {
+                  Ptr<fib::Entry> entry = fib->Add (prefixes[prefixIndex], face, cost);
+                  entry->SetRealDelayToProducer (face, Seconds (delay));
+                  entry->Invalidate (face);
+                }
+              else
+                {
+                  InstallRoute (fib, prefixes[prefixIndex], face, cost, delay);
+                  if (status == fib::FaceMetric::NDN_FIB_GREEN)
+                    fib->Find (*prefixes[prefixIndex])->UpdateStatus (face, fib::FaceMetric::NDN_FIB_GREEN);
+                }
+            }
+        }
+    }
+
+  return reader.IsOk ();
+}
+
+/**
+ * @brief Read prefix table and per-node FIBs of the saved routes and install them
+ * @returns false (and nothing is installed) if data is corrupted or does not match the current topology
+ */
+bool
+InstallSavedRoutes (RoutesReader &reader)
+{
+  uint32_t nPrefixes = reader.ReadU32 ();
+  if (nPrefixes > reader.GetRemainingSize () / 4) // each prefix takes at least 4 bytes
+    return false;
+
+  std::vector< Ptr<const Name> > prefixes (nPrefixes);
+  for (uint32_t i = 0; i < prefixes.size () && reader.IsOk (); i++)
+    {
+      Ptr<Name> prefix = Create<Name> ();
+      uint32_t nComponents = reader.ReadU32 ();
+      if (nComponents > reader.GetRemainingSize () / 4) // each component takes at least 4 bytes
+        return false;
+
+      prefix->reserve (nComponents);
+      for (uint32_t j = 0; j < nComponents && reader.IsOk (); j++)
+        {
+          prefix->Add (reader.ReadString ());
+        }
+      prefixes[i] = prefix;
+    }
+
+  // check the whole file first, so nothing is installed if it is corrupted
+  RoutesReader checkReader = reader;
+  if (!reader.IsOk () || !ReadFibs (checkReader, prefixes, false))
+    return false;
+
+  for (NodeList::Iterator node = NodeList::Begin (); node != NodeList::End (); node++)
+    {
+      Ptr<Fib> fib = (*node)->GetObject<Fib> ();
+      if (fib != 0)
+        fib->InvalidateAll ();
+    }
+
+  NS_LOG_DEBUG ("Installing routes for " << prefixes.size () << " prefixes");
+  return ReadFibs (reader, prefixes, true);
+}
+}
+
 void
 GlobalRoutingHelper::Install (Ptr<Node> node)
 {
@@ -227,222 +923,401 @@ GlobalRoutingHelper::AddOriginsForAll ()
     }
 }
 
+void
+GlobalRoutingHelper::SetComputationThreads (uint32_t nThreads)
+{
+  m_nThreads = nThreads;
+}
+
+uint32_t
+GlobalRoutingHelper::GetComputationThreads ()
+{
+#ifdef HAVE_PTHREAD_H
+  if (m_nThreads != 0)
+    return m_nThreads;
+
+  long nCpus = sysconf (_SC_NPROCESSORS_ONLN);
+  return nCpus > 0 ? static_cast<uint32_t> (nCpus) : 1;
+#else
+  return 1;
+#endif
+}
+
 void
 GlobalRoutingHelper::CalculateRoutes ()
 {
   /**
-   * Implementation of route calculation is heavily based on Boost Graph Library
-   * See http://www.boost.org/doc/libs/1_49_0/libs/graph/doc/table_of_contents.html for more details
+   * Graph is compiled into a compact array form and shortest path trees from all nodes are calculated
+   * in batches using several threads.  When a batch is ready, routes are installed into FIBs of
+   * nodes in the batch, always in the same (NodeList) order, independent of the number of threads.
    */
 
-  BOOST_CONCEPT_ASSERT(( VertexListGraphConcept< NdnGlobalRouterGraph > ));
-  BOOST_CONCEPT_ASSERT(( IncidenceGraphConcept< NdnGlobalRouterGraph > ));
+  boost::shared_ptr<DynamicRoutingState> state = boost::make_shared<DynamicRoutingState> ();
+  const GlobalRoutingGraph &graph = state->m_graph;
+  std::vector<uint32_t> &origins = state->m_origins;
+  origins = GetOrigins (graph);
 
-  NdnGlobalRouterGraph graph;
-  typedef graph_traits < NdnGlobalRouterGraph >::vertex_descriptor vertex_descriptor;
+  std::vector<GlobalRoutingGraph::Paths> *trees = 0;
+  if (m_dynamicRouting)
+    {
+      state->m_trees.resize (graph.GetNNodes ());
+      trees = &state->m_trees;
 
-  // For now we doing Dijkstra for every node.  Can be replaced with Bellman-Ford or Floyd-Warshall.
-  // Other algorithms should be faster, but they need additional EdgeListGraph concept provided by the graph, which
-  // is not obviously how implement in an efficient manner
-  for (NodeList::Iterator node = NodeList::Begin (); node != NodeList::End (); node++)
+      BOOST_FOREACH (uint32_t origin, origins)
+        {
+          BOOST_FOREACH (const Ptr<const Name> &prefix, graph.GetRouter (origin)->GetLocalPrefixes ())
+            {
+              DynamicRoutingState::PrefixOrigins &prefixOrigins = state->m_prefixes[*prefix];
+              if (prefixOrigins.m_prefix == 0)
+                prefixOrigins.m_prefix = prefix;
+              prefixOrigins.m_origins.push_back (origin);
+            }
+        }
+    }
+
+  uint32_t nThreads = std::max<uint32_t> (1, std::min (GetComputationThreads (), graph.GetNNodes ()));
+  uint32_t maxBatchSize = nThreads * ROUTES_BATCH_PER_THREAD;
+  NS_LOG_DEBUG ("Calculating routes for " << graph.GetNNodes () << " nodes and " << origins.size ()
+                << " origins using " << nThreads << " thread(s)");
+
+  std::vector<Route> routes (std::min (maxBatchSize, graph.GetNNodes ()) * origins.size ());
+  std::vector<RouteWorker> workers (nThreads, RouteWorker (graph, origins, routes, trees));
+
+  for (uint32_t batchStart = 0; batchStart < graph.GetNNodes (); batchStart += maxBatchSize)
     {
-      Ptr<GlobalRouter> source = (*node)->GetObject<GlobalRouter> ();
-      if (source == 0)
-	{
-	  NS_LOG_DEBUG ("Node " << (*node)->GetId () << " does not export GlobalRouter interface");
-	  continue;
-	}
+      uint32_t batchSize = std::min (maxBatchSize, graph.GetNNodes () - batchStart);
+      for (uint32_t thread = 0; thread < nThreads; thread++)
+        {
+          workers[thread].Setup (batchStart, batchSize, thread, nThreads);
+        }
 
-      DistancesMap    distances;
-
-      dijkstra_shortest_paths (graph, source,
-			       // predecessor_map (boost::ref(predecessors))
-			       // .
-			       distance_map (boost::ref(distances))
-			       .
-			       distance_inf (WeightInf)
-			       .
-			       distance_zero (WeightZero)
-			       .
-			       distance_compare (boost::WeightCompare ())
-			       .
-			       distance_combine (boost::WeightCombine ())
-			       );
-
-      // NS_LOG_DEBUG (predecessors.size () << ", " << distances.size ());
-
-      Ptr<Fib>  fib  = source->GetObject<Fib> ();
-      fib->InvalidateAll ();
-      NS_ASSERT (fib != 0);
+      RunWorkers (workers);
 
-      NS_LOG_DEBUG ("Reachability from Node: " << source->GetObject<Node> ()->GetId ());
-      for (DistancesMap::iterator i = distances.begin ();
-	   i != distances.end ();
-	   i++)
-	{
-	  if (i->first == source)
-	    continue;
-	  else
-	    {
-	      // cout << "  Node " << i->first->GetObject<Node> ()->GetId ();
-	      if (i->second.get<0> () == 0)
-		{
-		  // cout << " is unreachable" << endl;
-		}
-	      else
-		{
-                  BOOST_FOREACH (const Ptr<const Name> &prefix, i->first->GetLocalPrefixes ())
-                    {
-                      NS_LOG_DEBUG (" prefix " << prefix << " reachable via face " << *i->second.get<0> ()
-                                    << " with distance " << i->second.get<1> ()
-                                    << " with delay " << i->second.get<2> ());
-
-                      Ptr<fib::Entry> entry = fib->Add (prefix, i->second.get<0> (), i->second.get<1> ());
-                      entry->SetRealDelayToProducer (i->second.get<0> (), Seconds (i->second.get<2> ()));
-
-                      Ptr<Limits> faceLimits = i->second.get<0> ()->GetObject<Limits> ();
-
-                      Ptr<Limits> fibLimits = entry->GetObject<Limits> ();
-                      if (fibLimits != 0)
-                        {
-                          // if it was created by the forwarding strategy via DidAddFibEntry event
-                          fibLimits->SetLimits (faceLimits->GetMaxRate (), 2 * i->second.get<2> () /*exact RTT*/);
-                          NS_LOG_DEBUG ("Set limit for prefix " << *prefix << " " << faceLimits->GetMaxRate () << " / " <<
-                                        2*i->second.get<2> () << "s (" << faceLimits->GetMaxRate () * 2 * i->second.get<2> () << ")");
-                        }
-                    }
-		}
-	    }
-	}
+      for (uint32_t i = 0; i < batchSize; i++)
+        {
+          Ptr<GlobalRouter> source = graph.GetRouter (batchStart + i);
+
+          Ptr<Fib>  fib  = source->GetObject<Fib> ();
+          NS_ASSERT (fib != 0);
+          fib->InvalidateAll ();
+
+          NS_LOG_DEBUG ("Reachability from Node: " << source->GetObject<Node> ()->GetId ());
+          for (uint32_t j = 0; j < origins.size (); j++)
+            {
+              const Route &route = routes[i * origins.size () + j];
+              if (origins[j] == batchStart + i ||
+                  route.m_edge == GlobalRoutingGraph::INVALID) // unreachable
+                continue;
+
+              BOOST_FOREACH (const Ptr<const Name> &prefix, graph.GetRouter (origins[j])->GetLocalPrefixes ())
+                {
+                  InstallRoute (fib, prefix, graph.GetFace (route.m_edge), route.m_metric, route.m_delay);
+                }
+            }
+        }
+    }
+
+  if (m_dynamicRouting)
+    {
+      if (!g_dynamicRoutingState)
+        Simulator::ScheduleDestroy (&ResetDynamicRoutingState);
+      g_dynamicRoutingState = state;
     }
+  else
+    g_dynamicRoutingState.reset ();
 }
 
 void
-GlobalRoutingHelper::CalculateAllPossibleRoutes ()
+GlobalRoutingHelper::EnableDynamicRouting (bool enable/* = true*/)
 {
-  /**
-   * Implementation of route calculation is heavily based on Boost Graph Library
-   * See http://www.boost.org/doc/libs/1_49_0/libs/graph/doc/table_of_contents.html for more details
-   */
+  m_dynamicRouting = enable;
+  if (!enable)
+    g_dynamicRoutingState.reset ();
+}
 
-  BOOST_CONCEPT_ASSERT(( VertexListGraphConcept< NdnGlobalRouterGraph > ));
-  BOOST_CONCEPT_ASSERT(( IncidenceGraphConcept< NdnGlobalRouterGraph > ));
+void
+GlobalRoutingHelper::UpdateFace (Ptr<Face> face)
+{
+  NS_ASSERT_MSG (g_dynamicRoutingState,
+                 "Dynamic routing should be enabled and CalculateRoutes called before routes can be updated");
 
-  NdnGlobalRouterGraph graph;
-  typedef graph_traits < NdnGlobalRouterGraph >::vertex_descriptor vertex_descriptor;
+  DynamicRoutingState &state = *g_dynamicRoutingState;
+  GlobalRoutingGraph &graph = state.m_graph;
 
-  // For now we doing Dijkstra for every node.  Can be replaced with Bellman-Ford or Floyd-Warshall.
-  // Other algorithms should be faster, but they need additional EdgeListGraph concept provided by the graph, which
-  // is not obviously how implement in an efficient manner
-  for (NodeList::Iterator node = NodeList::Begin (); node != NodeList::End (); node++)
+  uint32_t edge = graph.FindEdge (face);
+  if (edge == GlobalRoutingGraph::INVALID)
     {
-      Ptr<GlobalRouter> source = (*node)->GetObject<GlobalRouter> ();
-      if (source == 0)
-	{
-	  NS_LOG_DEBUG ("Node " << (*node)->GetId () << " does not export GlobalRouter interface");
-	  continue;
-	}
+      NS_LOG_DEBUG ("Face " << *face << " is not part of the routing graph");
+      return;
+    }
 
-      Ptr<Fib>  fib  = source->GetObject<Fib> ();
-      fib->InvalidateAll ();
-      NS_ASSERT (fib != 0);
+  uint32_t oldMetric = graph.GetMetric (edge);
+  uint32_t newMetric = face->IsUp () ? face->GetMetric () : static_cast<uint32_t> (GlobalRoutingGraph::DISABLED);
+  if (oldMetric == newMetric)
+    return;
 
-      NS_LOG_DEBUG ("===========");
-      NS_LOG_DEBUG ("Reachability from Node: " << source->GetObject<Node> ()->GetId () << " (" << Names::FindName (source->GetObject<Node> ()) << ")");
+  NS_LOG_DEBUG ("Face " << *face << " changed metric from " << oldMetric << " to " << newMetric);
+  graph.SetMetric (edge, newMetric);
 
-      Ptr<L3Protocol> l3 = source->GetObject<L3Protocol> ();
-      NS_ASSERT (l3 != 0);
+  std::vector<GlobalRoutingGraph::PathChange> changes;
+  for (uint32_t vertex = 0; vertex < graph.GetNNodes (); vertex++)
+    {
+      changes.clear ();
+      GlobalRoutingGraph::Paths &tree = state.m_trees[vertex];
+      graph.UpdateShortestPaths (vertex, edge, oldMetric, tree, changes);
 
-      // remember interface statuses
-      std::vector<uint16_t> originalMetric (l3->GetNFaces ());
-      for (uint32_t faceId = 0; faceId < l3->GetNFaces (); faceId++)
+      // previous first hops of changed routes, grouped by prefix
+      std::map<Name, std::vector<uint32_t> > oldHops;
+      BOOST_FOREACH (const GlobalRoutingGraph::PathChange &change, changes)
         {
-          originalMetric[faceId] = l3->GetFace (faceId)->GetMetric ();
-          l3->GetFace (faceId)->SetMetric (std::numeric_limits<int16_t>::max ()-1); // value std::numeric_limits<int16_t>::max () MUST NOT be used (reserved)
+          if (change.m_vertex == vertex ||
+              !std::binary_search (state.m_origins.begin (), state.m_origins.end (), change.m_vertex))
+            continue;
+
+          BOOST_FOREACH (const Ptr<const Name> &prefix, graph.GetRouter (change.m_vertex)->GetLocalPrefixes ())
+            {
+              oldHops[*prefix].push_back (change.m_firstHop);
+            }
         }
 
-      for (uint32_t enabledFaceId = 0; enabledFaceId < l3->GetNFaces (); enabledFaceId++)
+      if (oldHops.empty ())
+        continue;
+
+      Ptr<Fib> fib = graph.GetRouter (vertex)->GetObject<Fib> ();
+      NS_LOG_DEBUG ("Repairing routes of Node: " << graph.GetRouter (vertex)->GetObject<Node> ()->GetId ());
+
+      for (std::map<Name, std::vector<uint32_t> >::iterator prefixHops = oldHops.begin ();
+           prefixHops != oldHops.end ();
+           prefixHops++)
         {
-          if (DynamicCast<ndn::NetDeviceFace> (l3->GetFace (enabledFaceId)) == 0)
-            continue;
+          // old routes are invalidated first (metric can only be replaced after that), then routes to all
+          // origins of the prefix are installed again, so faces that still lead to other origins
+          // of the same prefix get their best metrics back
+          Ptr<fib::Entry> entry = fib->Find (prefixHops->first);
+          if (entry != 0)
+            {
+              BOOST_FOREACH (uint32_t oldHop, prefixHops->second)
+                {
+                  if (oldHop != GlobalRoutingGraph::INVALID)
+                    entry->Invalidate (graph.GetFace (oldHop));
+                }
+            }
+
+          const DynamicRoutingState::PrefixOrigins &prefixOrigins = state.m_prefixes[prefixHops->first];
+          BOOST_FOREACH (uint32_t origin, prefixOrigins.m_origins)
+            {
+              uint32_t firstHop = tree.m_firstHop[origin];
+              if (origin == vertex || firstHop == GlobalRoutingGraph::INVALID)
+                continue;
 
-          // enabling only faceId
-          l3->GetFace (enabledFaceId)->SetMetric (originalMetric[enabledFaceId]);
+              InstallRoute (fib, prefixOrigins.m_prefix, graph.GetFace (firstHop),
+                            tree.m_distance[origin], tree.m_delay[origin]);
+            }
+        }
+    }
+}
+
+void
+GlobalRoutingHelper::CalculateAllPossibleRoutes ()
+{
+  /**
+   * For each origin, a single reverse shortest path tree is calculated, yielding distance to the origin
+   * from every node.  Route via a face of a node has metric of the face plus distance from the node on
+   * the other side of the face to the origin, so every node gets a FIB entry that contains all of its
+   * faces, ordered by the length of the best path through the face.  Faces, through which the shortest
+   * path of the neighbor comes back to the node itself, are skipped.
+   *
+   * Trees are calculated in batches of origins using several threads, routes are installed in
+   * deterministic order after each batch.
+   */
 
-          DistancesMap    distances;
+  GlobalRoutingGraph graph;
+  std::vector<uint32_t> origins = GetOrigins (graph);
 
-          NS_LOG_DEBUG ("-----------");
+  for (uint32_t vertex = 0; vertex < graph.GetNNodes (); vertex++)
+    {
+      Ptr<Fib>  fib  = graph.GetRouter (vertex)->GetObject<Fib> ();
+      NS_ASSERT (fib != 0);
+      fib->InvalidateAll ();
+    }
 
-          dijkstra_shortest_paths (graph, source,
-                                   // predecessor_map (boost::ref(predecessors))
-                                   // .
-                                   distance_map (boost::ref(distances))
-                                   .
-                                   distance_inf (WeightInf)
-                                   .
-                                   distance_zero (WeightZero)
-                                   .
-                                   distance_compare (boost::WeightCompare ())
-                                   .
-                                   distance_combine (boost::WeightCombine ())
-                                   );
+  uint32_t nThreads = std::max<uint32_t> (1, std::min<uint32_t> (GetComputationThreads (), origins.size ()));
+  uint32_t maxBatchSize = nThreads * ROUTES_BATCH_PER_THREAD;
+  NS_LOG_DEBUG ("Calculating all possible routes for " << graph.GetNNodes () << " nodes and " << origins.size ()
+                << " origins using " << nThreads << " thread(s)");
 
-          // NS_LOG_DEBUG (predecessors.size () << ", " << distances.size ());
+  std::vector<GlobalRoutingGraph::Paths> trees (std::min<uint32_t> (maxBatchSize, origins.size ()));
+  std::vector<TreeWorker> workers (nThreads, TreeWorker (graph, origins, trees));
+  TreeOrder order;
+
+  for (uint32_t batchStart = 0; batchStart < origins.size (); batchStart += maxBatchSize)
+    {
+      uint32_t batchSize = std::min<uint32_t> (maxBatchSize, origins.size () - batchStart);
+      for (uint32_t thread = 0; thread < nThreads; thread++)
+        {
+          workers[thread].Setup (batchStart, batchSize, thread, nThreads);
+        }
 
-          for (DistancesMap::iterator i = distances.begin ();
-               i != distances.end ();
-               i++)
+      RunWorkers (workers);
+
+      for (uint32_t i = 0; i < batchSize; i++)
+        {
+          uint32_t origin = origins[batchStart + i];
+          const GlobalRoutingGraph::Paths &tree = trees[i];
+          Ptr<GlobalRouter> originRouter = graph.GetRouter (origin);
+          order.Build (graph, tree, origin);
+
+          NS_LOG_DEBUG ("===========");
+          NS_LOG_DEBUG ("Reachability of Node: " << originRouter->GetObject<Node> ()->GetId () << " (" << Names::FindName (originRouter->GetObject<Node> ()) << ")");
+
+          for (uint32_t vertex = 0; vertex < graph.GetNNodes (); vertex++)
             {
-              if (i->first == source)
+              if (vertex == origin)
                 continue;
-              else
+
+              Ptr<GlobalRouter> source = graph.GetRouter (vertex);
+              Ptr<Fib>  fib  = source->GetObject<Fib> ();
+              NS_LOG_DEBUG ("From Node: " << source->GetObject<Node> ()->GetId ());
+
+              std::pair<uint32_t, uint32_t> edges = graph.GetEdges (vertex);
+              for (uint32_t edge = edges.first; edge < edges.second; edge++)
                 {
-                  // cout << "  Node " << i->first->GetObject<Node> ()->GetId ();
-                  if (i->second.get<0> () == 0)
-                    {
-                      // cout << " is unreachable" << endl;
-                    }
-                  else
+                  Ptr<Face> face = graph.GetFace (edge);
+                  uint32_t neighbor = graph.GetTarget (edge);
+                  if (face == 0 || // not a NetDeviceFace
+                      graph.GetMetric (edge) == GlobalRoutingGraph::DISABLED || // face is down
+                      tree.m_distance[neighbor] == std::numeric_limits<uint32_t>::max () || // origin is unreachable via the face
+                      order.PassesThrough (neighbor, vertex)) // path from the neighbor bounces back through this node
+                    continue;
+
+                  uint32_t metric = graph.GetMetric (edge) + tree.m_distance[neighbor];
+                  double delay = graph.GetDelay (edge) + tree.m_delay[neighbor];
+
+                  BOOST_FOREACH (const Ptr<const Name> &prefix, originRouter->GetLocalPrefixes ())
                     {
-                      BOOST_FOREACH (const Ptr<const Name> &prefix, i->first->GetLocalPrefixes ())
-                        {
-                          NS_LOG_DEBUG (" prefix " << *prefix << " reachable via face " << *i->second.get<0> ()
-                                        << " with distance " << i->second.get<1> ()
-                                        << " with delay " << i->second.get<2> ());
-
-                          if (i->second.get<0> ()->GetMetric () == std::numeric_limits<uint16_t>::max ()-1)
-                            continue;
-
-                          Ptr<fib::Entry> entry = fib->Add (prefix, i->second.get<0> (), i->second.get<1> ());
-                          entry->SetRealDelayToProducer (i->second.get<0> (), Seconds (i->second.get<2> ()));
-
-                          Ptr<Limits> faceLimits = i->second.get<0> ()->GetObject<Limits> ();
-
-                          Ptr<Limits> fibLimits = entry->GetObject<Limits> ();
-                          if (fibLimits != 0)
-                            {
-                              // if it was created by the forwarding strategy via DidAddFibEntry event
-                              fibLimits->SetLimits (faceLimits->GetMaxRate (), 2 * i->second.get<2> () /*exact RTT*/);
-                              NS_LOG_DEBUG ("Set limit for prefix " << *prefix << " " << faceLimits->GetMaxRate () << " / " <<
-                                            2*i->second.get<2> () << "s (" << faceLimits->GetMaxRate () * 2 * i->second.get<2> () << ")");
-                            }
-                        }
+                      InstallRoute (fib, prefix, face, metric, delay);
                     }
                 }
             }
+        }
+    }
+}
+
+void
+GlobalRoutingHelper::SaveRoutes (const std::string &filename)
+{
+  std::vector< Ptr<const Name> > prefixes;
+  std::map<Name, uint32_t> prefixIndex;
+
+  std::ostringstream fibs;
+  RoutesWriter fibsWriter (fibs);
+
+  uint32_t nNodes = 0;
+  for (NodeList::Iterator node = NodeList::Begin (); node != NodeList::End (); node++)
+    {
+      Ptr<Fib> fib = (*node)->GetObject<Fib> ();
+      if (fib == 0)
+        continue;
+
+      nNodes ++;
+      fibsWriter.WriteU32 ((*node)->GetId ());
+      fibsWriter.WriteU32 (fib->GetSize ());
+      for (Ptr<fib::Entry> entry = fib->Begin (); entry != fib->End (); entry = fib->Next (entry))
+        {
+          std::map<Name, uint32_t>::iterator index = prefixIndex.find (entry->GetPrefix ());
+          if (index == prefixIndex.end ())
+            {
+              index = prefixIndex.insert (std::make_pair (entry->GetPrefix (), prefixes.size ())).first;
+              prefixes.push_back (entry->m_prefix);
+            }
 
-          // disabling the face again
-          l3->GetFace (enabledFaceId)->SetMetric (std::numeric_limits<uint16_t>::max ()-1);
+          fibsWriter.WriteU32 (index->second);
+          fibsWriter.WriteU32 (entry->m_faces.size ());
+          BOOST_FOREACH (const fib::FaceMetric &metric, entry->m_faces)
+            {
+              fibsWriter.WriteU32 (metric.GetFace ()->GetId ());
+              fibsWriter.WriteU32 (static_cast<uint32_t> (metric.GetRoutingCost ()));
+              fibsWriter.WriteU8 (metric.GetStatus ());
+              fibsWriter.WriteDouble (metric.GetRealDelay ().ToDouble (Time::S));
+            }
         }
+    }
 
-      // recover original interface statuses
-      for (uint32_t faceId = 0; faceId < l3->GetNFaces (); faceId++)
+  std::ofstream os (filename.c_str (), std::ios::out | std::ios::binary | std::ios::trunc);
+  if (!os.is_open ())
+    {
+      NS_FATAL_ERROR ("Cannot open file " << filename << " for writing");
+    }
+
+  RoutesWriter writer (os);
+  os.write (ROUTES_FILE_MAGIC, sizeof (ROUTES_FILE_MAGIC));
+  writer.WriteU32 (ROUTES_FILE_VERSION);
+  writer.WriteU64 (GetTopologyFingerprint ());
+
+  writer.WriteU32 (prefixes.size ());
+  BOOST_FOREACH (const Ptr<const Name> &prefix, prefixes)
+    {
+      writer.WriteU32 (prefix->size ());
+      BOOST_FOREACH (const std::string &component, *prefix)
         {
-          l3->GetFace (faceId)->SetMetric (originalMetric[faceId]);
+          writer.WriteString (component);
         }
     }
+
+  writer.WriteU32 (nNodes);
+  os << fibs.str ();
+
+  NS_LOG_DEBUG ("Saved FIBs of " << nNodes << " nodes (" << prefixes.size () << " prefixes) to " << filename);
 }
 
+bool
+GlobalRoutingHelper::LoadRoutes (const std::string &filename)
+{
+  int fd = ::open (filename.c_str (), O_RDONLY);
+  if (fd < 0)
+    {
+      NS_LOG_DEBUG ("Cannot open file " << filename);
+      return false;
+    }
+
+  struct stat info;
+  if (::fstat (fd, &info) != 0 || info.st_size == 0)
+    {
+      ::close (fd);
+      return false;
+    }
+
+  void *data = ::mmap (0, info.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+  ::close (fd);
+  if (data == MAP_FAILED)
+    {
+      NS_LOG_DEBUG ("Cannot map file " << filename);
+      return false;
+    }
+
+  RoutesReader reader (static_cast<const uint8_t*> (data), info.st_size);
+  bool ok = false;
+
+  const uint8_t *magic = reader.Skip (sizeof (ROUTES_FILE_MAGIC));
+  if (magic == 0 || memcmp (magic, ROUTES_FILE_MAGIC, sizeof (ROUTES_FILE_MAGIC)) != 0 ||
+      reader.ReadU32 () != ROUTES_FILE_VERSION)
+    {
+      NS_LOG_DEBUG ("File " << filename << " does not contain saved routes");
+    }
+  else if (reader.ReadU64 () != GetTopologyFingerprint ())
+    {
+      NS_LOG_DEBUG ("Routes in " << filename << " were saved for a different topology");
+    }
+  else
+    {
+      ok = InstallSavedRoutes (reader);
+      if (!ok)
+        NS_LOG_DEBUG ("File " << filename << " is corrupted");
+    }
+
+  ::munmap (data, info.st_size);
+  return ok;
+}
 
 } // namespace ndn
 } // namespace ns3
@@ -31,6 +31,8 @@ class Channel;
 
 namespace ndn {
 
+class Face;
+
 /**
  * @ingroup ndn
  * @brief Helper for GlobalRouter interface
@@ -104,16 +106,92 @@ public:
   /**
    * @brief Calculate all possible next-hop independent alternative routes
    *
+   * Every node gets routes to every prefix origin via each of its faces.  Metric of the route is
+   * metric of the face plus length of the shortest path from the node on the other side of the face.
    * Refer to the implementation for more details.
    *
-   * Note that this method is highly experimental and should be used with caution (very time consuming).
+   * Note that this method is highly experimental and should be used with caution.
    */
   static void
   CalculateAllPossibleRoutes ();
 
+  /**
+   * @brief Save FIBs of all nodes into a binary file
+   *
+   * Besides FIB entries (prefixes, face IDs, routing costs, statuses, and real delays), file contains
+   * fingerprint of the topology (nodes, faces, face metrics, links, link delays, and prefix origins),
+   * so the routes can be reused by later runs on the same topology with LoadRoutes:
+   *
+   * \code
+   * if (!ndn::GlobalRoutingHelper::LoadRoutes ("routes.bin"))
+   *   {
+   *     ndn::GlobalRoutingHelper::CalculateRoutes ();
+   *     ndn::GlobalRoutingHelper::SaveRoutes ("routes.bin");
+   *   }
+   * \endcode
+   *
+   * @param filename Name of the file
+   */
+  static void
+  SaveRoutes (const std::string &filename);
+
+  /**
+   * @brief Install FIBs of all nodes from a file saved by SaveRoutes
+   *
+   * FIBs are invalidated before routes are installed (the same way as CalculateRoutes does).
+   *
+   * @param filename Name of the file
+   * @returns false (and nothing is installed) if file cannot be read, is corrupted, or was saved
+   *          for a different topology
+   */
+  static bool
+  LoadRoutes (const std::string &filename);
+
+  /**
+   * @brief Keep shortest path trees calculated by CalculateRoutes, so routes can be repaired with UpdateFace
+   *
+   * Should be called before CalculateRoutes.  Note that trees of all nodes are kept in memory
+   * (about 20 bytes per node pair).
+   */
+  static void
+  EnableDynamicRouting (bool enable = true);
+
+  /**
+   * @brief Repair routes after the face went up or down, or its metric has changed
+   *
+   * Only shortest path trees that are affected by the change are updated, and only FIB entries
+   * for which next hop, distance, or delay have changed are modified.  Previous next hop of the changed
+   * entries is invalidated in the same way as by Fib::InvalidateAll.
+   *
+   * Note that each side of a link is represented by its own face, so to simulate link failure
+   * both faces should be set down and UpdateFace should be called for each of them.
+   *
+   * @param face Face, which status or metric has been changed
+   */
+  static void
+  UpdateFace (Ptr<Face> face);
+
+  /**
+   * @brief Set number of threads used to calculate shortest path trees
+   *
+   * Routes installed into FIBs do not depend on the number of threads.  If ns-3 is built
+   * without thread support, routes are always calculated in the calling thread.
+   *
+   * @param nThreads Number of threads, 0 (default) to use one thread per online CPU
+   */
+  static void
+  SetComputationThreads (uint32_t nThreads);
+
 private:
   void
   Install (Ptr<Channel> channel);
+
+  static uint32_t
+  GetComputationThreads ();
+
+private:
+  static uint32_t m_nThreads;
+  static bool m_dynamicRouting;
 };
 
 } // namespace ndn
@@ -24,9 +24,11 @@
 #include "ns3/packet.h"
 #include "ns3/header.h"
 #include "ns3/object.h"
+#include "ns3/unused.h"
 
 #include "ns3/ndn-interest.h"
 #include "ns3/ndn-content-object.h"
+#include "../model/ndn-tlv.h"
 #include <iomanip>
 
 NS_LOG_COMPONENT_DEFINE ("ndn.HeaderHelper");
@@ -37,9 +39,160 @@ const uint8_t CONTENT_OBJECT_CCNB_BYTES[] = {0x04, 0x82};
 const uint8_t INTEREST_NDNSIM_BYTES[]       = {0x80, 0x00};
 const uint8_t CONTENT_OBJECT_NDNSIM_BYTES[] = {0x80, 0x01};
 
+const uint8_t INTEREST_HOP_COUNT_NDNSIM_BYTES[]       = {0x80, 0x02};
+const uint8_t CONTENT_OBJECT_HOP_COUNT_NDNSIM_BYTES[] = {0x80, 0x03};
+
+const uint8_t INTEREST_TLV_BYTE       = 0x05;
+const uint8_t CONTENT_OBJECT_TLV_BYTE = 0x06;
+
 namespace ns3 {
 namespace ndn {
 
+HeaderHelper::WireFormat HeaderHelper::s_wireFormat = HeaderHelper::WIRE_FORMAT_NDNSIM;
+
+namespace {
+
+// TLV type, TLV length (up to 9 octets), HopCount type and length, and 4-octet hop count
+const uint32_t MAX_HOP_COUNT_PREFIX = 1 + 9 + 2 + 4;
+
+/**
+ * @brief Header that consists of the raw bytes of the packet, up to and including hop count
+ *
+ * Used to put back the beginning of the header with the updated hop count
+ */
+class HopCountPrefix : public Header
+{
+public:
+  HopCountPrefix (const uint8_t *prefix, uint32_t size)
+    : m_prefix (prefix)
+    , m_size (size)
+  {
+  }
+
+  static TypeId
+  GetTypeId ()
+  {
+    static TypeId tid = TypeId ("ns3::ndn::HopCountPrefix")
+      .SetGroupName ("Ndn")
+      .SetParent<Header> ()
+      ;
+    return tid;
+  }
+
+  virtual TypeId
+  GetInstanceTypeId () const
+  {
+    return GetTypeId ();
+  }
+
+  virtual uint32_t
+  GetSerializedSize () const
+  {
+    return m_size;
+  }
+
+  virtual void
+  Serialize (Buffer::Iterator start) const
+  {
+    start.Write (m_prefix, m_size);
+  }
+
+  virtual uint32_t
+  Deserialize (Buffer::Iterator start)
+  {
+    NS_FATAL_ERROR ("HopCountPrefix is never deserialized");
+    return 0;
+  }
+
+  virtual void
+  Print (std::ostream &os) const
+  {
+    os << "HopCountPrefix";
+  }
+
+private:
+  const uint8_t *m_prefix;
+  uint32_t m_size;
+};
+
+/**
+ * @brief Copy the beginning of the packet and find offset of the hop count value
+ *
+ * @returns false if the packet does not carry hop count
+ */
+bool
+FindHopCount (Ptr<const Packet> packet, uint8_t *prefix, uint32_t &offset)
+{
+  uint32_t size = packet->CopyData (prefix, MAX_HOP_COUNT_PREFIX);
+  if (size < 2)
+    return false;
+
+  if (prefix[0] == INTEREST_HOP_COUNT_NDNSIM_BYTES[0] &&
+      (prefix[1] == INTEREST_HOP_COUNT_NDNSIM_BYTES[1] || prefix[1] == CONTENT_OBJECT_HOP_COUNT_NDNSIM_BYTES[1]))
+    {
+      offset = 2;
+    }
+  else if (prefix[0] == INTEREST_TLV_BYTE || prefix[0] == CONTENT_OBJECT_TLV_BYTE)
+    {
+      // HopCount, if present, is the first element of the block
+      switch (prefix[1])
+        {
+        case 253: offset = 1 + 3; break;
+        case 254: offset = 1 + 5; break;
+        case 255: offset = 1 + 9; break;
+        default:  offset = 1 + 1; break;
+        }
+
+      if (size < offset + 2 || prefix[offset] != tlv::HOP_COUNT || prefix[offset + 1] != 4)
+        return false;
+      offset += 2;
+    }
+  else
+    return false;
+
+  return size >= offset + 4;
+}
+
+uint32_t
+ReadHopCount (const uint8_t *prefix, uint32_t offset)
+{
+  return ((static_cast<uint32_t> (prefix[offset]) << 24) |
+          (static_cast<uint32_t> (prefix[offset + 1]) << 16) |
+          (static_cast<uint32_t> (prefix[offset + 2]) << 8) |
+          static_cast<uint32_t> (prefix[offset + 3])) & 0x7FFFFFFF;
+}
+
+/**
+ * @brief Replace the beginning of the packet (up to and including hop count) with the updated copy
+ */
+void
+WriteHopCount (Ptr<Packet> packet, uint8_t *prefix, uint32_t offset, uint32_t hopCount)
+{
+  prefix[offset]     = static_cast<uint8_t> (hopCount >> 24);
+  prefix[offset + 1] = static_cast<uint8_t> (hopCount >> 16);
+  prefix[offset + 2] = static_cast<uint8_t> (hopCount >> 8);
+  prefix[offset + 3] = static_cast<uint8_t> (hopCount);
+
+  packet->RemoveAtStart (offset + 4);
+  packet->AddHeader (HopCountPrefix (prefix, offset + 4));
+}
+
+} // namespace
+
+NS_OBJECT_ENSURE_REGISTERED (HopCountPrefix);
+
+void
+HeaderHelper::SetWireFormat (WireFormat format)
+{
+  s_wireFormat = format;
+}
+
+HeaderHelper::WireFormat
+HeaderHelper::GetWireFormat ()
+{
+  return s_wireFormat;
+}
+
 HeaderHelper::Type
 HeaderHelper::GetNdnHeaderType (Ptr<const Packet> packet)
 {
@@ -65,6 +218,22 @@ HeaderHelper::GetNdnHeaderType (Ptr<const Packet> packet)
     {
       return HeaderHelper::CONTENT_OBJECT_NDNSIM;
     }
+  else if (type[0] == INTEREST_HOP_COUNT_NDNSIM_BYTES[0] && type[1] == INTEREST_HOP_COUNT_NDNSIM_BYTES[1])
+    {
+      return HeaderHelper::INTEREST_NDNSIM;
+    }
+  else if (type[0] == CONTENT_OBJECT_HOP_COUNT_NDNSIM_BYTES[0] && type[1] == CONTENT_OBJECT_HOP_COUNT_NDNSIM_BYTES[1])
+    {
+      return HeaderHelper::CONTENT_OBJECT_NDNSIM;
+    }
+  else if (type[0] == INTEREST_TLV_BYTE)
+    {
+      return HeaderHelper::INTEREST_TLV;
+    }
+  else if (type[0] == CONTENT_OBJECT_TLV_BYTE)
+    {
+      return HeaderHelper::CONTENT_OBJECT_TLV;
+    }
 
   NS_LOG_DEBUG (*packet);
   throw UnknownHeaderException();
@@ -73,29 +242,31 @@ HeaderHelper::GetNdnHeaderType (Ptr<const Packet> packet)
 Ptr<const Name>
 HeaderHelper::GetName (Ptr<const Packet> p)
 {
-  Ptr<Packet> packet = p->Copy (); // give upper layers a rw copy of the packet
   try
     {
       HeaderHelper::Type type = HeaderHelper::GetNdnHeaderType (p);
       switch (type)
         {
         case HeaderHelper::INTEREST_NDNSIM:
+        case HeaderHelper::INTEREST_TLV:
           {
             Ptr<Interest> header = Create<Interest> ();
 
             // Deserialization. Exception may be thrown
-            packet->RemoveHeader (*header);
-            NS_ASSERT_MSG (packet->GetSize () == 0, "Payload of Interests should be zero");
+            uint32_t headerSize = p->PeekHeader (*header);
+            NS_ASSERT_MSG (p->GetSize () == headerSize, "Payload of Interests should be zero");
+            NS_UNUSED (headerSize);
 
             return header->GetNamePtr ();
             break;
           }
         case HeaderHelper::CONTENT_OBJECT_NDNSIM:
+        case HeaderHelper::CONTENT_OBJECT_TLV:
           {
             Ptr<ContentObject> header = Create<ContentObject> ();
 
             // Deserialization. Exception may be thrown
-            packet->RemoveHeader (*header);
+            p->PeekHeader (*header);
             return header->GetNamePtr ();
             break;
           }
@@ -115,6 +286,40 @@ HeaderHelper::GetName (Ptr<const Packet> p)
   return 0;
 }
 
+int32_t
+HeaderHelper::GetHopCount (Ptr<const Packet> packet)
+{
+  uint8_t prefix[MAX_HOP_COUNT_PREFIX];
+  uint32_t offset;
+  if (!FindHopCount (packet, prefix, offset))
+    return -1;
+
+  return static_cast<int32_t> (ReadHopCount (prefix, offset));
+}
+
+bool
+HeaderHelper::SetHopCount (Ptr<Packet> packet, uint32_t hopCount)
+{
+  uint8_t prefix[MAX_HOP_COUNT_PREFIX];
+  uint32_t offset;
+  if (!FindHopCount (packet, prefix, offset))
+    return false;
+
+  WriteHopCount (packet, prefix, offset, hopCount);
+  return true;
+}
+
+bool
+HeaderHelper::IncrementHopCount (Ptr<Packet> packet)
+{
+  uint8_t prefix[MAX_HOP_COUNT_PREFIX];
+  uint32_t offset;
+  if (!FindHopCount (packet, prefix, offset))
+    return false;
+
+  WriteHopCount (packet, prefix, offset, ReadHopCount (prefix, offset) + 1);
+  return true;
+}
 
 } // namespace ndn
 } // namespace ns3
@@ -52,7 +52,15 @@ public:
      @brief enum for Ndn packet types
    */
   enum Type {INTEREST_CCNB, CONTENT_OBJECT_CCNB,
-             INTEREST_NDNSIM, CONTENT_OBJECT_NDNSIM};
+             INTEREST_NDNSIM, CONTENT_OBJECT_NDNSIM,
+             INTEREST_TLV, CONTENT_OBJECT_TLV};
+
+  /**
+     @brief enum for wire formats used to encode Ndn packets
+   */
+  enum WireFormat {WIRE_FORMAT_NDNSIM, ///< @brief ndnSIM format (fixed-length fields)
+                   WIRE_FORMAT_TLV     ///< @brief compact NDN-TLV style format (variable-length types and lengths, see ndn-tlv.h)
+  };
 
   /**
    *	Packet ::= Version
@@ -87,11 +95,35 @@ public:
    *                      terminator      DTAG (Dictionary TAG)
    *
    * \see http://www.ccnx.org/releases/latest/doc/technical/BinaryEncoding.html
+   *
+   * ndnSIM-encoded packets that carry hop count use PacketType 0x02 (``Interest``) and
+   * 0x03 (``ContentObject``), immediately followed by 4-octet hop count.
+   *
+   * TLV-encoded packets start with type of the outer TLV block:
+   *
+   * 0x05 --- TLV-encoded ``Interest`` packet
+   * 0x06 --- TLV-encoded ``ContentObject`` packet
    */
 
   static Type
   GetNdnHeaderType (Ptr<const Packet> packet);
 
+  /**
+   * @brief Set wire format, which is used to encode Interest and ContentObject headers
+   *
+   * Headers are encoded without knowledge about the node, so the format is the same for the whole
+   * simulation and should be set before simulation starts.  Packets in any of the supported
+   * formats are always accepted.
+   */
+  static void
+  SetWireFormat (WireFormat format);
+
+  /**
+   * @brief Get wire format, which is used to encode Interest and ContentObject headers
+   */
+  static WireFormat
+  GetWireFormat ();
+
   /**
    * @brief A heavy-weight operation to get name of the packet
    *
@@ -99,6 +131,41 @@ public:
    */
   static Ptr<const Name>
   GetName (Ptr<const Packet> packet);
+
+  /**
+   * @brief Get hop count carried in the header of the packet, without deserializing the header
+   *
+   * In both wire formats hop count is a 4-octet field at a fixed place at the beginning of the
+   * header (right after PacketType in ndnSIM format and the first element of the TLV block in TLV format)
+   *
+   * @returns hop count or -1 if the packet does not carry hop count
+   */
+  static int32_t
+  GetHopCount (Ptr<const Packet> packet);
+
+  /**
+   * @brief Overwrite hop count carried in the header of the packet
+   *
+   * Only the bytes up to and including the hop count field are replaced, the rest of the header
+   * is neither decoded nor re-encoded.  Note that ns-3 packets cannot be modified in place, so
+   * if the buffer is shared with other packets (e.g., after Packet::Copy), it is copied once.
+   *
+   * @returns false if the packet does not carry hop count (packet is not modified)
+   */
+  static bool
+  SetHopCount (Ptr<Packet> packet, uint32_t hopCount);
+
+  /**
+   * @brief Increment hop count carried in the header of the packet
+   *
+   * @see SetHopCount
+   * @returns false if the packet does not carry hop count (packet is not modified)
+   */
+  static bool
+  IncrementHopCount (Ptr<Packet> packet);
+
+private:
+  static WireFormat s_wireFormat;
 };
 
   /**
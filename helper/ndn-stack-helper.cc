@@ -38,12 +38,16 @@
 
 #include "../model/ndn-net-device-face.h"
 #include "../model/ndn-l3-protocol.h"
+#include "../model/ndn-name-tree.h"
+#include "../model/ndn-nonce-filter.h"
+#include "../model/pit/ndn-pit-admission-control.h"
 
 #include "ns3/ndn-forwarding-strategy.h"
 #include "ns3/ndn-fib.h"
 #include "ns3/ndn-pit.h"
 #include "ns3/ndn-name.h"
 #include "ns3/ndn-content-store.h"
+#include "ns3/ndn-header-helper.h"
 
 #include "ns3/node-list.h"
 // #include "ns3/loopback-net-device.h"
@@ -66,12 +70,17 @@ namespace ndn {
 StackHelper::StackHelper ()
   : m_limitsEnabled (false)
   , m_needSetDefaultRoutes (false)
+  , m_nameTreeEnabled (false)
+  , m_nonceFilterEnabled (false)
+  , m_pitQuotasEnabled (false)
 {
   m_ndnFactory.         SetTypeId ("ns3::ndn::L3Protocol");
   m_strategyFactory.    SetTypeId ("ns3::ndn::fw::Flooding");
   m_contentStoreFactory.SetTypeId ("ns3::ndn::cs::Lru");
   m_fibFactory.         SetTypeId ("ns3::ndn::fib::Default");
   m_pitFactory.         SetTypeId ("ns3::ndn::pit::Persistent");
+  m_nonceFilterFactory. SetTypeId ("ns3::ndn::NonceFilter");
+  m_admissionControlFactory.SetTypeId ("ns3::ndn::pit::AdmissionControl");
 
   m_netDeviceCallbacks.push_back (std::make_pair (PointToPointNetDevice::GetTypeId (), MakeCallback (&StackHelper::PointToPointNetDeviceCallback, this)));
   // default callback will be fired if non of others callbacks fit or did the job
@@ -195,6 +204,57 @@ StackHelper::EnableLimits (bool enable/* = true*/,
   m_avgInterestSize = avgInterest;
 }
 
+void
+StackHelper::EnableNameTree (bool enable/* = true*/)
+{
+  NS_LOG_INFO ("EnableNameTree: " << enable);
+  m_nameTreeEnabled = enable;
+}
+
+void
+StackHelper::SetWireFormat (const std::string &format)
+{
+  NS_LOG_INFO ("SetWireFormat: " << format);
+  if (format == "ndnSIM")
+    HeaderHelper::SetWireFormat (HeaderHelper::WIRE_FORMAT_NDNSIM);
+  else if (format == "TLV")
+    HeaderHelper::SetWireFormat (HeaderHelper::WIRE_FORMAT_TLV);
+  else
+    NS_FATAL_ERROR ("Unknown wire format [" << format << "], should be either ndnSIM or TLV");
+}
+
+void
+StackHelper::EnableNonceFilter (bool enable/* = true*/,
+                                const std::string &attr1, const std::string &value1,
+                                const std::string &attr2, const std::string &value2,
+                                const std::string &attr3, const std::string &value3,
+                                const std::string &attr4, const std::string &value4)
+{
+  NS_LOG_INFO ("EnableNonceFilter: " << enable);
+  m_nonceFilterEnabled = enable;
+  if (attr1 != "")
+      m_nonceFilterFactory.Set (attr1, StringValue (value1));
+  if (attr2 != "")
+      m_nonceFilterFactory.Set (attr2, StringValue (value2));
+  if (attr3 != "")
+      m_nonceFilterFactory.Set (attr3, StringValue (value3));
+  if (attr4 != "")
+      m_nonceFilterFactory.Set (attr4, StringValue (value4));
+}
+
+void
+StackHelper::EnablePitQuotas (bool enable/* = true*/,
+                              const std::string &attr1, const std::string &value1,
+                              const std::string &attr2, const std::string &value2)
+{
+  NS_LOG_INFO ("EnablePitQuotas: " << enable);
+  m_pitQuotasEnabled = enable;
+  if (attr1 != "")
+      m_admissionControlFactory.Set (attr1, StringValue (value1));
+  if (attr2 != "")
+      m_admissionControlFactory.Set (attr2, StringValue (value2));
+}
+
 Ptr<FaceContainer>
 StackHelper::Install (const NodeContainer &c) const
 {
@@ -228,6 +288,24 @@ StackHelper::Install (Ptr<Node> node) const
   // Create L3Protocol
   Ptr<L3Protocol> ndn = m_ndnFactory.Create<L3Protocol> ();
 
+  if (m_nameTreeEnabled)
+    {
+      // Create and aggregate name tree
+      ndn->AggregateObject (CreateObject<NameTree> ());
+    }
+
+  if (m_nonceFilterEnabled)
+    {
+      // Create and aggregate per-node nonce filter
+      ndn->AggregateObject (m_nonceFilterFactory.Create<NonceFilter> ());
+    }
+
+  if (m_pitQuotasEnabled)
+    {
+      // Create and aggregate PIT admission control (per-face and per-prefix quotas)
+      ndn->AggregateObject (m_admissionControlFactory.Create<pit::AdmissionControl> ());
+    }
+
   // Create and aggregate FIB
   Ptr<Fib> fib = m_fibFactory.Create<Fib> ();
   ndn->AggregateObject (fib);
@@ -371,6 +449,22 @@ StackHelper::AddRoute (Ptr<Node> node, const std::string &prefix, Ptr<Face> face
   fib->Add (prefixValue.Get (), face, metric);
 }
 
+void
+StackHelper::AddRoutes (Ptr<Node> node, const std::vector<std::string> &prefixes, Ptr<Face> face, int32_t metric)
+{
+  NS_LOG_LOGIC ("[" << node->GetId () << "]$ route add " << prefixes.size () << " prefixes via " << *face << " metric " << metric);
+
+  Ptr<Fib>  fib  = node->GetObject<Fib> ();
+
+  fib::RouteList routes;
+  routes.reserve (prefixes.size ());
+  for (std::vector<std::string>::const_iterator prefix = prefixes.begin (); prefix != prefixes.end (); prefix++)
+    {
+      routes.push_back (fib::Route (Create<Name> (*prefix), face, metric));
+    }
+  fib->AddBulk (routes);
+}
+
 void
 StackHelper::AddRoute (Ptr<Node> node, const std::string &prefix, uint32_t faceId, int32_t metric)
 {
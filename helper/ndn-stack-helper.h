@@ -27,6 +27,8 @@
 #include "ns3/object-factory.h"
 #include "ns3/nstime.h"
 
+#include <vector>
+
 namespace ns3 {
 
 class Node;
@@ -164,6 +166,66 @@ public:
   void
   EnableLimits (bool enable = true, Time avgRtt=Seconds(0.1), uint32_t avgContentObject=1100, uint32_t avgInterest=40);
 
+  /**
+   * @brief Enable unified name tree (disabled by default)
+   *
+   * When enabled, FIB and PIT entries are additionally indexed in a single trie (ns3::ndn::NameTree),
+   * which allows forwarding strategy to resolve both PIT and FIB entries for an Interest
+   * (and PIT entries for a Data) in one lookup.  Separate FIB and PIT objects are still
+   * installed and can be used as before.
+   *
+   * @param enable Enable or disable name tree
+   */
+  void
+  EnableNameTree (bool enable = true);
+
+  /**
+   * @brief Enable per-node filter of seen nonces (disabled by default)
+   *
+   * When enabled, duplicate Interests are detected using ns3::ndn::NonceFilter, which remembers
+   * (name, nonce) pairs for the configured lifetime, independent from PIT entries.
+   * Nonces are no longer recorded in PIT entries.
+   *
+   * @param enable Enable or disable nonce filter
+   * @param attr1..attr4 Attributes of ns3::ndn::NonceFilter (e.g., "Capacity", "FalsePositiveRate", "Lifetime", "Buckets")
+   */
+  void
+  EnableNonceFilter (bool enable = true,
+                     const std::string &attr1 = "", const std::string &value1 = "",
+                     const std::string &attr2 = "", const std::string &value2 = "",
+                     const std::string &attr3 = "", const std::string &value3 = "",
+                     const std::string &attr4 = "", const std::string &value4 = "");
+
+  /**
+   * @brief Enable per-face and per-prefix PIT quotas (disabled by default)
+   *
+   * When enabled, ns3::ndn::pit::AdmissionControl bounds number of PIT entries in which a face can be
+   * recorded as incoming ("MaxEntriesPerFace") and number of pending PIT entries per FIB prefix
+   * ("MaxEntriesPerPrefix").  Interests exceeding the quota are dropped (or NACKed, if forwarding
+   * strategy supports NACKs and they are enabled).
+   *
+   * @param enable Enable or disable PIT quotas
+   * @param attr1..attr2 Attributes of ns3::ndn::pit::AdmissionControl
+   */
+  void
+  EnablePitQuotas (bool enable = true,
+                   const std::string &attr1 = "", const std::string &value1 = "",
+                   const std::string &attr2 = "", const std::string &value2 = "");
+
+  /**
+   * @brief Set wire format used to encode Interest and ContentObject packets ("ndnSIM" by default)
+   *
+   * "TLV" selects compact NDN-TLV style encoding with variable-length types and lengths.
+   * Packets are encoded without knowledge about the node, so the format applies to the whole
+   * simulation.  Nodes accept packets in any of the supported formats.
+   *
+   * Shortcut for HeaderHelper::SetWireFormat, should be called before simulation starts.
+   *
+   * @param format Wire format: "ndnSIM" or "TLV"
+   */
+  static void
+  SetWireFormat (const std::string &format);
+
   /**
    * \brief Install Ndn stack on the node
    *
@@ -249,6 +311,20 @@ public:
   static void
   AddRoute (Ptr<Node> node, const std::string &prefix, Ptr<Face> face, int32_t metric);
 
+  /**
+   * \brief Add a batch of forwarding entries to FIB
+   *
+   * Equivalent to calling AddRoute for each prefix, but all entries are installed with a single
+   * Fib::AddBulk call.  Installation is faster if prefixes are sorted.
+   *
+   * \param node     Node
+   * \param prefixes Routing prefixes
+   * \param face     Face
+   * \param metric   Routing metric
+   */
+  static void
+  AddRoutes (Ptr<Node> node, const std::vector<std::string> &prefixes, Ptr<Face> face, int32_t metric);
+
   /**
    * @brief Add forwarding entry to FIB (work only with point-to-point links)
    *
@@ -294,12 +370,17 @@ private:
   ObjectFactory m_contentStoreFactory;
   ObjectFactory m_pitFactory;
   ObjectFactory m_fibFactory;
+  ObjectFactory m_nonceFilterFactory;
+  ObjectFactory m_admissionControlFactory;
 
   bool     m_limitsEnabled;
   Time     m_avgRtt;
   uint32_t m_avgContentObjectSize;
   uint32_t m_avgInterestSize;
   bool     m_needSetDefaultRoutes;
+  bool     m_nameTreeEnabled;
+  bool     m_nonceFilterEnabled;
+  bool     m_pitQuotasEnabled;
 
   std::list< std::pair<TypeId, NetDeviceFaceCreateCallback> > m_netDeviceCallbacks;
 };
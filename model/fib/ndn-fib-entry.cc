@@ -28,7 +28,9 @@
 #define NDN_RTO_ALPHA 0.125
 #define NDN_RTO_BETA 0.25
 #define NDN_RTO_K 4
+#define NDN_SATISFACTION_ALPHA 0.125
 
+#include <algorithm>
 #include <boost/ref.hpp>
 #include <boost/lambda/lambda.hpp>
 #include <boost/lambda/bind.hpp>
@@ -50,6 +52,105 @@ struct FaceMetricByFace
   type;
 };
 
+/**
+ * @brief Modifier setting routing cost and status of the record at once
+ *
+ * Record can be moved after each modification, so both fields should be changed by a single modify call
+ */
+struct SetRoutingCostAndStatus
+{
+  SetRoutingCostAndStatus (int32_t routingCost, FaceMetric::Status status)
+    : m_routingCost (routingCost)
+    , m_status (status)
+  {
+  }
+
+  void
+  operator () (FaceMetric &record) const
+  {
+    record.SetRoutingCost (m_routingCost);
+    record.SetStatus (m_status);
+  }
+
+  int32_t m_routingCost;
+  FaceMetric::Status m_status;
+};
+
+/**
+ * @brief Order of records in FaceMetricList: by status, then by routing cost
+ */
+struct FaceMetricLess
+{
+  bool
+  operator () (const FaceMetric &a, const FaceMetric &b) const
+  {
+    if (a.GetStatus () != b.GetStatus ())
+      return a.GetStatus () < b.GetStatus ();
+    return a.GetRoutingCost () < b.GetRoutingCost ();
+  }
+};
+
+FaceMetricList::const_iterator
+FaceMetricList::find (const Ptr<Face> &face) const
+{
+  for (const_iterator item = m_list.begin (); item != m_list.end (); item++)
+    {
+      if (item->GetFace () == face)
+        return item;
+    }
+  return m_list.end ();
+}
+
+std::pair<FaceMetricList::iterator, bool>
+FaceMetricList::insert (const FaceMetric &metric)
+{
+  const_iterator existing = find (metric.GetFace ());
+  if (existing != m_list.end ())
+    return std::make_pair (existing, false);
+
+  container::iterator position = std::upper_bound (m_list.begin (), m_list.end (), metric, FaceMetricLess ());
+  return std::make_pair (const_iterator (m_list.insert (position, metric)), true);
+}
+
+FaceMetricList::size_type
+FaceMetricList::erase (const Ptr<Face> &face)
+{
+  const_iterator item = find (face);
+  if (item == m_list.end ())
+    return 0;
+
+  erase (item);
+  return 1;
+}
+
+void
+FaceMetricList::erase (iterator position)
+{
+  m_list.erase (m_list.begin () + (position - m_list.begin ()));
+}
+
+FaceMetricList::iterator
+FaceMetricList::Reposition (container::size_type pos)
+{
+  FaceMetricLess less;
+
+  // move towards the beginning, while previous record is worse
+  while (pos > 0 && less (m_list[pos], m_list[pos - 1]))
+    {
+      std::swap (m_list[pos], m_list[pos - 1]);
+      pos --;
+    }
+
+  // move towards the end, while next record is better
+  while (pos + 1 < m_list.size () && less (m_list[pos + 1], m_list[pos]))
+    {
+      std::swap (m_list[pos], m_list[pos + 1]);
+      pos ++;
+    }
+
+  return m_list.begin () + pos;
+}
+
 
 void
 FaceMetric::UpdateRtt (const Time &rttSample)
@@ -72,6 +173,12 @@ FaceMetric::UpdateRtt (const Time &rttSample)
     }
 }
 
+void
+FaceMetric::UpdateSatisfactionRatio (bool satisfied)
+{
+  m_satisfactionRatio = (1 - NDN_SATISFACTION_ALPHA) * m_satisfactionRatio + NDN_SATISFACTION_ALPHA * (satisfied ? 1.0 : 0.0);
+}
+
 /////////////////////////////////////////////////////////////////////
 
 void
@@ -81,11 +188,19 @@ Entry::UpdateFaceRtt (Ptr<Face> face, const Time &sample)
   NS_ASSERT_MSG (record != m_faces.get<i_face> ().end (),
                  "Update status can be performed only on existing faces of CcxnFibEntry");
 
-  m_faces.modify (record,
-                  ll::bind (&FaceMetric::UpdateRtt, ll::_1, sample));
+  // RTT does not affect the order, so record can be updated in place
+  const_cast<FaceMetric&> (*record).UpdateRtt (sample);
+}
+
+void
+Entry::UpdateFaceSatisfaction (Ptr<Face> face, bool satisfied)
+{
+  FaceMetricByFace::type::iterator record = m_faces.get<i_face> ().find (face);
+  if (record == m_faces.get<i_face> ().end ())
+    return;
 
-  // reordering random access index same way as by metric index
-  m_faces.get<i_nth> ().rearrange (m_faces.get<i_metric> ().begin ());
+  // satisfaction ratio does not affect the order, so record can be updated in place
+  const_cast<FaceMetric&> (*record).UpdateSatisfactionRatio (satisfied);
 }
 
 void
@@ -97,11 +212,11 @@ Entry::UpdateStatus (Ptr<Face> face, FaceMetric::Status status)
   NS_ASSERT_MSG (record != m_faces.get<i_face> ().end (),
                  "Update status can be performed only on existing faces of CcxnFibEntry");
 
+  if (record->GetStatus () == status)
+    return; // nothing changed, ranking stays the same
+
   m_faces.modify (record,
                   ll::bind (&FaceMetric::SetStatus, ll::_1, status));
-
-  // reordering random access index same way as by metric index
-  m_faces.get<i_nth> ().rearrange (m_faces.get<i_metric> ().begin ());
 }
 
 void
@@ -121,15 +236,9 @@ Entry::AddOrUpdateRoutingMetric (Ptr<Face> face, int32_t metric)
     if (record->GetRoutingCost () > metric || record->GetStatus () == FaceMetric::NDN_FIB_RED)
       {
         m_faces.modify (record,
-                        ll::bind (&FaceMetric::SetRoutingCost, ll::_1, metric));
-
-        m_faces.modify (record,
-                        ll::bind (&FaceMetric::SetStatus, ll::_1, FaceMetric::NDN_FIB_YELLOW));
+                        SetRoutingCostAndStatus (metric, FaceMetric::NDN_FIB_YELLOW));
       }
   }
-
-  // reordering random access index same way as by metric index
-  m_faces.get<i_nth> ().rearrange (m_faces.get<i_metric> ().begin ());
 }
 
 void
@@ -150,18 +259,28 @@ Entry::SetRealDelayToProducer (Ptr<Face> face, Time delay)
 void
 Entry::Invalidate ()
 {
+  // all records get the same metric, so the order is not changed
   for (FaceMetricByFace::type::iterator face = m_faces.begin ();
        face != m_faces.end ();
        face++)
     {
-      m_faces.modify (face,
-                      ll::bind (&FaceMetric::SetRoutingCost, ll::_1, std::numeric_limits<uint16_t>::max ()));
-
-      m_faces.modify (face,
-                      ll::bind (&FaceMetric::SetStatus, ll::_1, FaceMetric::NDN_FIB_RED));
+      FaceMetric &record = const_cast<FaceMetric&> (*face);
+      record.SetRoutingCost (std::numeric_limits<uint16_t>::max ());
+      record.SetStatus (FaceMetric::NDN_FIB_RED);
     }
 }
 
+void
+Entry::Invalidate (Ptr<Face> face)
+{
+  FaceMetricByFace::type::iterator record = m_faces.get<i_face> ().find (face);
+  if (record == m_faces.get<i_face> ().end ())
+    return;
+
+  m_faces.modify (record,
+                  SetRoutingCostAndStatus (std::numeric_limits<uint16_t>::max (), FaceMetric::NDN_FIB_RED));
+}
+
 const FaceMetric &
 Entry::FindBestCandidate (uint32_t skip/* = 0*/) const
 {
@@ -28,14 +28,8 @@
 #include "ns3/ndn-limits.h"
 #include "ns3/traced-value.h"
 
-#include <boost/multi_index_container.hpp>
-#include <boost/multi_index/tag.hpp>
-#include <boost/multi_index/ordered_index.hpp>
-#include <boost/multi_index/composite_key.hpp>
-#include <boost/multi_index/hashed_index.hpp>
-#include <boost/multi_index/random_access_index.hpp>
-#include <boost/multi_index/member.hpp>
-#include <boost/multi_index/mem_fun.hpp>
+#include <vector>
+#include <boost/shared_ptr.hpp>
 
 namespace ns3 {
 namespace ndn {
@@ -73,11 +67,12 @@ public:
     , m_routingCost (cost)
     , m_sRtt   (Seconds (0))
     , m_rttVar (Seconds (0))
+    , m_satisfactionRatio (1.0)
     , m_realDelay (Seconds (0))
   { }
 
   /**
-   * \brief Comparison operator used by boost::multi_index::identity<>
+   * \brief Comparison operator (identity of the face)
    */
   bool
   operator< (const FaceMetric &fm) const { return *m_face < *fm.m_face; } // return identity of the face
@@ -101,6 +96,40 @@ public:
   void
   UpdateRtt (const Time &rttSample);
 
+  /**
+   * @brief Get smoothed RTT (zero if RTT has not been measured yet)
+   */
+  Time
+  GetSRtt () const
+  {
+    return m_sRtt;
+  }
+
+  /**
+   * @brief Get RTT variation
+   */
+  Time
+  GetRttVar () const
+  {
+    return m_rttVar;
+  }
+
+  /**
+   * \brief Update moving average of the fraction of Interests satisfied via the face
+   * \param satisfied Whether Interest has been satisfied (false if it timed out or was NACKed)
+   */
+  void
+  UpdateSatisfactionRatio (bool satisfied);
+
+  /**
+   * @brief Get moving average of the fraction of Interests satisfied via the face (1.0 initially)
+   */
+  double
+  GetSatisfactionRatio () const
+  {
+    return m_satisfactionRatio;
+  }
+
   /**
    * @brief Get current status of FIB entry
    */
@@ -116,7 +145,9 @@ public:
   void
   SetStatus (Status status)
   {
-    m_status.Set (status);
+    if (m_statusTrace)
+      m_statusTrace->Set (status);
+    m_status = status;
   }
 
   /**
@@ -157,11 +188,16 @@ public:
 
   /**
    * @brief Get direct access to status trace
+   *
+   * Trace is allocated on the first request, so metrics that are never traced do not pay for it.
+   * Trace is shared between copies of the metric (e.g., when record is moved inside the container)
    */
   TracedValue<Status> &
   GetStatusTrace ()
   {
-    return m_status;
+    if (!m_statusTrace)
+      m_statusTrace.reset (new TracedValue<Status> (m_status));
+    return *m_statusTrace;
   }
 
 private:
@@ -170,15 +206,18 @@ private:
 private:
   Ptr<Face> m_face; ///< Face
 
-  TracedValue<Status> m_status; ///< \brief Status of the next hop:
-				///<		- NDN_FIB_GREEN
-				///<		- NDN_FIB_YELLOW
-				///<		- NDN_FIB_RED
+  Status m_status; ///< \brief Status of the next hop:
+		   ///<		- NDN_FIB_GREEN
+		   ///<		- NDN_FIB_YELLOW
+		   ///<		- NDN_FIB_RED
+
+  boost::shared_ptr< TracedValue<Status> > m_statusTrace; ///< \brief Status trace (allocated only if requested)
 
   int32_t m_routingCost; ///< \brief routing protocol cost (interpretation of the value depends on the underlying routing protocol)
 
   Time m_sRtt;         ///< \brief smoothed round-trip time
   Time m_rttVar;       ///< \brief round-trip time variation
+  double m_satisfactionRatio; ///< \brief moving average of the fraction of satisfied Interests
 
   Time m_realDelay;    ///< \brief real propagation delay to the producer, calculated based on NS-3 p2p link delays
 };
@@ -189,46 +228,128 @@ class i_metric {};
 class i_nth {};
 /// @endcond
 
+/**
+ * \ingroup ndn
+ * \brief Flat list of FIB next hops, ordered by (status, routing cost)
+ *
+ * FIB entries usually have just a few next hops, so a sorted vector is much more compact
+ * than a multi-index container, and linear search by face is as fast as a tree lookup.
+ *
+ * For compatibility, the list mimics the subset of boost::multi_index interface:
+ * all "indexes" (i_face, i_metric, i_nth) are the same list ordered by metric.
+ * Records cannot be changed directly, only through modify (), which keeps the order.
+ */
+class FaceMetricList
+{
+public:
+  typedef std::vector<FaceMetric> container;
+  typedef container::const_iterator iterator;
+  typedef container::const_iterator const_iterator;
+  typedef container::size_type size_type;
+  typedef FaceMetric value_type;
+
+  /// @brief Compatibility with boost::multi_index: index of any tag is the list itself
+  template<class Tag>
+  struct index
+  {
+    typedef FaceMetricList type;
+  };
+
+  /// @brief Compatibility with boost::multi_index: index of any tag is the list itself
+  template<class Tag>
+  FaceMetricList &
+  get () { return *this; }
+
+  /// @brief Compatibility with boost::multi_index: index of any tag is the list itself
+  template<class Tag>
+  const FaceMetricList &
+  get () const { return *this; }
+
+  const_iterator
+  begin () const { return m_list.begin (); }
+
+  const_iterator
+  end () const { return m_list.end (); }
+
+  size_type
+  size () const { return m_list.size (); }
+
+  bool
+  empty () const { return m_list.empty (); }
+
+  const FaceMetric &
+  operator[] (size_type n) const { return m_list[n]; }
+
+  /**
+   * @brief Find record for the face (linear search)
+   */
+  const_iterator
+  find (const Ptr<Face> &face) const;
+
+  /**
+   * @brief Insert new record (after all records with the same metric)
+   * @returns iterator to the inserted record and true, or iterator to the existing record for the face and false
+   */
+  std::pair<iterator, bool>
+  insert (const FaceMetric &metric);
+
+  /**
+   * @brief Apply modifier to the record and restore the order
+   *
+   * Unlike boost::multi_index modify, `position` and all other iterators are invalidated, because the record
+   * can be moved to a different place in the list.  If several fields need to be changed, they should be
+   * changed by a single modifier, not by several modify calls through the same iterator.
+   *
+   * @returns always true (for compatibility with boost::multi_index)
+   */
+  template<class Modifier>
+  bool
+  modify (iterator position, Modifier mod);
+
+  /**
+   * @brief Remove record for the face (if exists)
+   * @returns number of removed records
+   */
+  size_type
+  erase (const Ptr<Face> &face);
+
+  void
+  erase (iterator position);
+
+  void
+  clear () { m_list.clear (); }
+
+private:
+  /**
+   * @brief Move record at position `pos` to its place according to the metric
+   */
+  iterator
+  Reposition (container::size_type pos);
+
+private:
+  container m_list;
+};
+
+template<class Modifier>
+bool
+FaceMetricList::modify (iterator position, Modifier mod)
+{
+  container::size_type pos = position - m_list.begin ();
+  mod (m_list[pos]);
+  Reposition (pos);
+  return true;
+}
 
 /**
  * \ingroup ndn
- * \brief Typedef for indexed face container of Entry
+ * \brief Typedef for face container of Entry
  *
- * Currently, there are 2 indexes:
- * - by face (used to find record and update metric)
- * - by metric (face ranking)
- * - random access index (for fast lookup on nth face). Order is
- *   maintained manually to be equal to the 'by metric' order
+ * Previously, it was a multi-index container with 3 indexes (by face, by metric, and random access).
+ * Now all of them are represented by a single flat list, ordered by metric
  */
 struct FaceMetricContainer
 {
-  /// @cond include_hidden
-  typedef boost::multi_index::multi_index_container<
-    FaceMetric,
-    boost::multi_index::indexed_by<
-      // For fast access to elements using Face
-      boost::multi_index::ordered_unique<
-        boost::multi_index::tag<i_face>,
-        boost::multi_index::const_mem_fun<FaceMetric,Ptr<Face>,&FaceMetric::GetFace>
-      >,
-
-      // List of available faces ordered by (status, m_routingCost)
-      boost::multi_index::ordered_non_unique<
-        boost::multi_index::tag<i_metric>,
-        boost::multi_index::composite_key<
-          FaceMetric,
-          boost::multi_index::const_mem_fun<FaceMetric,FaceMetric::Status,&FaceMetric::GetStatus>,
-          boost::multi_index::const_mem_fun<FaceMetric,int32_t,&FaceMetric::GetRoutingCost>
-        >
-      >,
-
-      // To optimize nth candidate selection (sacrifice a little bit space to gain speed)
-      boost::multi_index::random_access<
-        boost::multi_index::tag<i_nth>
-      >
-    >
-   > type;
-  /// @endcond
+  typedef FaceMetricList type;
 };
 
 /**
@@ -282,12 +403,30 @@ public:
   void
   Invalidate ();
 
+  /**
+   * @brief Invalidate single face
+   *
+   * Set routing metric of the face to max and status to RED (the same way as Invalidate does)
+   */
+  void
+  Invalidate (Ptr<Face> face);
+
   /**
    * @brief Update RTT averages for the face
+   *
+   * RTT does not affect ranking of the faces, so no reordering is performed
    */
   void
   UpdateFaceRtt (Ptr<Face> face, const Time &sample);
 
+  /**
+   * @brief Update satisfaction ratio of the face (nothing is done if face is not part of the entry)
+   *
+   * Satisfaction ratio does not affect ranking of the faces, so no reordering is performed
+   */
+  void
+  UpdateFaceSatisfaction (Ptr<Face> face, bool satisfied);
+
   /**
    * \brief Get prefix for the FIB entry
    */
@@ -324,7 +463,7 @@ public:
   Ptr<Fib> m_fib; ///< \brief FIB to which entry is added
 
   Ptr<const Name> m_prefix; ///< \brief Prefix of the FIB entry
-  FaceMetricContainer::type m_faces; ///< \brief Indexed list of faces
+  FaceMetricContainer::type m_faces; ///< \brief List of faces, ordered by metric
 
   bool m_needsProbing;      ///< \brief flag indicating that probing should be performed
 };
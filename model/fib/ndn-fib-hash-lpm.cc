@@ -0,0 +1,372 @@
+/* -*- Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil -*- */
+/*
+ * Copyright (c) 2011 University of California, Los Angeles
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ * Author: Alexander Afanasyev <alexander.afanasyev@ucla.edu>
+ */
+
+#include "ndn-fib-hash-lpm.h"
+
+#include "ns3/ndn-interest.h"
+#include "ns3/ndnSIM/model/ndn-name-tree.h"
+
+#include "ns3/log.h"
+
+#include <algorithm>
+#include <boost/foreach.hpp>
+#include <boost/functional/hash.hpp>
+
+NS_LOG_COMPONENT_DEFINE ("ndn.fib.HashLpmImpl");
+
+namespace ns3 {
+namespace ndn {
+namespace fib {
+
+NS_OBJECT_ENSURE_REGISTERED (HashLpmImpl);
+
+TypeId
+HashLpmImpl::GetTypeId (void)
+{
+  static TypeId tid = TypeId ("ns3::ndn::fib::HashLpm")
+    .SetParent<FibImpl> ()
+    .SetGroupName ("Ndn")
+    .AddConstructor<HashLpmImpl> ()
+  ;
+  return tid;
+}
+
+HashLpmImpl::HashLpmImpl ()
+  : m_needsRebuild (true)
+  , m_generation (1)
+{
+}
+
+void
+HashLpmImpl::NotifyNewAggregate ()
+{
+  if (GetObject<NameTree> () != 0)
+    {
+      NS_FATAL_ERROR ("ns3::ndn::fib::HashLpm cannot be used together with the unified name tree, "
+                      "which bypasses FIB lookups");
+    }
+
+  super::NotifyNewAggregate ();
+}
+
+void
+HashLpmImpl::DoDispose (void)
+{
+  m_levels.clear ();
+  m_needsRebuild = true;
+
+  super::DoDispose ();
+}
+
+Ptr<Entry>
+HashLpmImpl::LongestPrefixMatch (const Interest &interest)
+{
+  if (m_needsRebuild)
+    Rebuild ();
+
+  if (m_levels.empty ())
+    return 0;
+
+  const Name &name = interest.GetName ();
+  CalculateHashes (name, m_levels.size () - 1, m_hashes);
+
+  Ptr<Entry> bestMatch = 0;
+  int32_t lo = 0;
+  int32_t hi = m_levels.size () - 1;
+  while (lo <= hi)
+    {
+      int32_t mid = (lo + hi) / 2;
+
+      level::iterator record = m_levels[mid].end ();
+      if (static_cast<uint32_t> (mid) < m_hashes.size ())
+        record = FindRecord (name, mid, m_hashes[mid]);
+
+      if (record != m_levels[mid].end ())
+        {
+          // longer match could exist
+          Ptr<Entry> match = GetBestMatch (record->second, name, mid);
+          if (match != 0)
+            bestMatch = match;
+          lo = mid + 1;
+        }
+      else
+        {
+          hi = mid - 1;
+        }
+    }
+
+  return bestMatch;
+}
+
+Ptr<Entry>
+HashLpmImpl::Add (const Ptr<const Name> &prefix, Ptr<Face> face, int32_t metric)
+{
+  uint32_t size = GetSize ();
+  Ptr<Entry> entry = super::Add (prefix, face, metric);
+  if (GetSize () != size && !m_needsRebuild)
+    {
+      if (entry->GetPrefix ().size () < m_levels.size ())
+        {
+          AddRecords (entry);
+          m_generation ++;
+        }
+      else
+        {
+          // search range should be extended
+          m_needsRebuild = true;
+        }
+    }
+
+  return entry;
+}
+
+void
+HashLpmImpl::AddBulk (const RouteList &routes)
+{
+  uint32_t size = GetSize ();
+  super::AddBulk (routes);
+  if (GetSize () != size)
+    m_needsRebuild = true;
+}
+
+void
+HashLpmImpl::Remove (const Ptr<const Name> &prefix)
+{
+  if (!m_needsRebuild)
+    {
+      super::super::iterator item = super::super::find_exact (*prefix);
+      if (item != super::super::end ())
+        {
+          RemoveRecords (item->payload ());
+          m_generation ++;
+        }
+    }
+
+  super::Remove (prefix);
+}
+
+void
+HashLpmImpl::RemoveFromAll (Ptr<Face> face)
+{
+  if (m_needsRebuild)
+    {
+      super::RemoveFromAll (face);
+      return;
+    }
+
+  // entries that have only this face will be removed
+  std::vector< Ptr<Entry> > candidates;
+  for (Ptr<Entry> entry = Begin (); entry != End (); entry = Next (entry))
+    {
+      if (entry->m_faces.size () == 0 ||
+          (entry->m_faces.size () == 1 && entry->m_faces.find (face) != entry->m_faces.end ()))
+        {
+          candidates.push_back (entry);
+        }
+    }
+
+  super::RemoveFromAll (face);
+
+  BOOST_FOREACH (Ptr<Entry> entry, candidates)
+    {
+      super::super::iterator item = super::super::find_exact (entry->GetPrefix ());
+      if (item == super::super::end () || item->payload () != entry)
+        {
+          RemoveRecords (entry);
+          m_generation ++;
+        }
+    }
+}
+
+void
+HashLpmImpl::Rebuild ()
+{
+  NS_LOG_FUNCTION (this);
+
+  m_levels.clear ();
+  m_needsRebuild = false;
+  m_generation ++;
+
+  uint32_t maxLength = 0;
+  for (Ptr<Entry> entry = Begin (); entry != End (); entry = Next (entry))
+    {
+      maxLength = std::max<uint32_t> (maxLength, entry->GetPrefix ().size ());
+    }
+
+  if (GetSize () == 0)
+    return;
+
+  // lengths [0, 2^k - 1], so each length is reachable via the binary search
+  uint32_t range = 1;
+  while (range - 1 < maxLength)
+    range <<= 1;
+  m_levels.resize (range);
+
+  for (Ptr<Entry> entry = Begin (); entry != End (); entry = Next (entry))
+    {
+      AddRecords (entry);
+    }
+
+  NS_LOG_DEBUG ("Rebuilt " << m_levels.size () << " levels for " << GetSize () << " prefixes");
+}
+
+void
+HashLpmImpl::AddRecords (Ptr<Entry> entry)
+{
+  const Name &prefix = entry->GetPrefix ();
+  uint32_t length = prefix.size ();
+  CalculateHashes (prefix, length, m_hashes);
+
+  // place markers on the binary search path towards the prefix
+  int32_t lo = 0;
+  int32_t hi = m_levels.size () - 1;
+  while (lo <= hi)
+    {
+      int32_t mid = (lo + hi) / 2;
+      if (static_cast<uint32_t> (mid) > length)
+        {
+          hi = mid - 1;
+          continue;
+        }
+
+      level::iterator record = FindRecord (prefix, mid, m_hashes[mid]);
+      if (record == m_levels[mid].end ())
+        {
+          Record newRecord;
+          newRecord.m_name = entry->m_prefix;
+          newRecord.m_generation = 0; // best match is not yet known
+          newRecord.m_refs = 0;
+          record = m_levels[mid].insert (std::make_pair (m_hashes[mid], newRecord));
+        }
+
+      record->second.m_refs ++;
+      if (static_cast<uint32_t> (mid) == length)
+        {
+          record->second.m_entry = entry;
+          break;
+        }
+
+      lo = mid + 1;
+    }
+}
+
+void
+HashLpmImpl::RemoveRecords (Ptr<Entry> entry)
+{
+  const Name &prefix = entry->GetPrefix ();
+  uint32_t length = prefix.size ();
+  CalculateHashes (prefix, length, m_hashes);
+
+  // the same path as in AddRecords
+  int32_t lo = 0;
+  int32_t hi = m_levels.size () - 1;
+  while (lo <= hi)
+    {
+      int32_t mid = (lo + hi) / 2;
+      if (static_cast<uint32_t> (mid) > length)
+        {
+          hi = mid - 1;
+          continue;
+        }
+
+      level::iterator record = FindRecord (prefix, mid, m_hashes[mid]);
+      NS_ASSERT (record != m_levels[mid].end ());
+
+      if (static_cast<uint32_t> (mid) == length)
+        record->second.m_entry = 0;
+
+      if (-- record->second.m_refs == 0)
+        m_levels[mid].erase (record);
+
+      if (static_cast<uint32_t> (mid) == length)
+        break;
+
+      lo = mid + 1;
+    }
+}
+
+HashLpmImpl::level::iterator
+HashLpmImpl::FindRecord (const Name &name, uint32_t length, std::size_t hash)
+{
+  std::pair<level::iterator, level::iterator> range = m_levels[length].equal_range (hash);
+  for (level::iterator item = range.first; item != range.second; item++)
+    {
+      // hash can collide, so names should be compared
+      Name::const_iterator a = name.begin ();
+      Name::const_iterator b = item->second.m_name->begin ();
+      uint32_t i = 0;
+      for (; i < length && *a == *b; i++, a++, b++)
+        ;
+
+      if (i == length)
+        return item;
+    }
+  return m_levels[length].end ();
+}
+
+Ptr<Entry>
+HashLpmImpl::GetBestMatch (Record &record, const Name &name, uint32_t length)
+{
+  if (record.m_generation == m_generation)
+    return record.m_bestMatch;
+
+  // no backtracking is needed for the search itself, shorter prefixes are probed only once
+  // per record after each FIB change
+  record.m_bestMatch = record.m_entry;
+  for (int32_t l = static_cast<int32_t> (length) - 1; record.m_bestMatch == 0 && l >= 0; l--)
+    {
+      level::iterator prefix = FindRecord (name, l, m_hashes[l]);
+      if (prefix == m_levels[l].end ())
+        continue;
+
+      if (prefix->second.m_entry != 0)
+        record.m_bestMatch = prefix->second.m_entry;
+      else if (prefix->second.m_generation == m_generation)
+        {
+          // best match of the shorter prefix is up to date
+          record.m_bestMatch = prefix->second.m_bestMatch;
+          break;
+        }
+    }
+
+  record.m_generation = m_generation;
+  return record.m_bestMatch;
+}
+
+void
+HashLpmImpl::CalculateHashes (const Name &name, uint32_t maxLength, std::vector<std::size_t> &hashes)
+{
+  hashes.clear ();
+
+  std::size_t seed = 0;
+  hashes.push_back (seed);
+  BOOST_FOREACH (const std::string &component, name)
+    {
+      if (hashes.size () > maxLength)
+        break;
+
+      boost::hash_combine (seed, component);
+      hashes.push_back (seed);
+    }
+}
+
+} // namespace fib
+} // namespace ndn
+} // namespace ns3
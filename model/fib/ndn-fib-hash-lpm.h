@@ -0,0 +1,160 @@
+/* -*- Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil -*- */
+/*
+ * Copyright (c) 2011 University of California, Los Angeles
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ * Author: Alexander Afanasyev <alexander.afanasyev@ucla.edu>
+ */
+
+#ifndef _NDN_FIB_HASH_LPM_H_
+#define	_NDN_FIB_HASH_LPM_H_
+
+#include "ndn-fib-impl.h"
+
+#include <vector>
+#include <boost/unordered_map.hpp>
+
+namespace ns3 {
+namespace ndn {
+namespace fib {
+
+/**
+ * \ingroup ndn
+ * \brief FIB with longest prefix match based on binary search on prefix length
+ *
+ * In addition to the trie (which is still used to store and iterate entries), FIB keeps
+ * per-prefix-length hash tables keyed by hash of the first N name components.  Longest prefix
+ * match does binary search on the prefix length (M. Waldvogel et al., "Scalable high speed IP
+ * routing lookups"), so the number of hash table probes is logarithmic in the maximum
+ * prefix length, not linear in the length of the name.
+ *
+ * To guide the search, marker records are placed on the binary search path towards each prefix.
+ * Each record (marker or real prefix) caches its best matching prefix, so no backtracking is necessary.
+ *
+ * Hash tables are updated incrementally: records are reference counted by the prefixes whose search
+ * paths go through them, and cached best matching prefixes are recalculated on the next visit after
+ * FIB has changed.  Hash tables are rebuilt from the trie only after AddBulk and when a new prefix is
+ * longer than the search range.
+ *
+ * This FIB should not be used together with the unified name tree (StackHelper::EnableNameTree):
+ * forwarding strategy resolves FIB entries through the name tree and the hash tables would be just
+ * an overhead.  Such combination is rejected when FIB is aggregated to the node.
+ */
+class HashLpmImpl : public FibImpl
+{
+public:
+  typedef FibImpl super;
+
+  /**
+   * \brief Interface ID
+   *
+   * \return interface ID
+   */
+  static TypeId GetTypeId ();
+
+  /**
+   * \brief Constructor
+   */
+  HashLpmImpl ();
+
+  virtual Ptr<Entry>
+  LongestPrefixMatch (const Interest &interest);
+
+  using FibImpl::Add;
+
+  virtual Ptr<Entry>
+  Add (const Ptr<const Name> &prefix, Ptr<Face> face, int32_t metric);
+
+  virtual void
+  AddBulk (const RouteList &routes);
+
+  virtual void
+  Remove (const Ptr<const Name> &prefix);
+
+  virtual void
+  RemoveFromAll (Ptr<Face> face);
+
+protected:
+  // inherited from Object class
+  virtual void NotifyNewAggregate (); ///< @brief Notify when object is aggregated
+  virtual void DoDispose (); ///< @brief Perform cleanup
+
+private:
+  /**
+   * @brief Record in the per-length hash table (either real prefix or marker)
+   */
+  struct Record
+  {
+    Ptr<const Name> m_name; ///< @brief Name, first N components of which are represented by the record
+    Ptr<Entry> m_entry;     ///< @brief FIB entry with exactly this prefix (0 if record is just a marker)
+    Ptr<Entry> m_bestMatch; ///< @brief FIB entry with the longest prefix of the record (0 if none), valid only in m_generation
+    uint32_t m_generation;  ///< @brief FIB generation, in which m_bestMatch has been calculated
+    uint32_t m_refs;        ///< @brief Number of prefixes with search path through the record
+  };
+
+  typedef boost::unordered_multimap<std::size_t, Record> level; ///< @brief hash of the first N components => record
+
+  /**
+   * @brief Rebuild per-length hash tables from the trie
+   */
+  void
+  Rebuild ();
+
+  /**
+   * @brief Add (or reference existing) records on the search path towards the FIB entry
+   */
+  void
+  AddRecords (Ptr<Entry> entry);
+
+  /**
+   * @brief Dereference records on the search path towards the FIB entry (unused records are removed)
+   */
+  void
+  RemoveRecords (Ptr<Entry> entry);
+
+  /**
+   * @brief Find record for the first `length` components of the name
+   */
+  level::iterator
+  FindRecord (const Name &name, uint32_t length, std::size_t hash);
+
+  /**
+   * @brief Get best matching prefix of the record for the first `length` components of the name
+   *
+   * If FIB has changed since it was calculated, best matching prefix is recalculated by probing
+   * shorter prefixes of the name (m_hashes should contain hashes of the name)
+   */
+  Ptr<Entry>
+  GetBestMatch (Record &record, const Name &name, uint32_t length);
+
+  /**
+   * @brief Calculate hashes of all prefixes of the name (hashes[i] is hash of the first i components)
+   */
+  static void
+  CalculateHashes (const Name &name, uint32_t maxLength, std::vector<std::size_t> &hashes);
+
+private:
+  std::vector<level> m_levels; ///< @brief Hash tables for each prefix length
+  bool m_needsRebuild;         ///< @brief Flag indicating that hash tables should be rebuilt from the trie
+  uint32_t m_generation;       ///< @brief Incremented on each FIB change to invalidate cached best matching prefixes
+
+  std::vector<std::size_t> m_hashes; ///< @brief Buffer for prefix hashes (to avoid allocations on every lookup)
+};
+
+} // namespace fib
+} // namespace ndn
+} // namespace ns3
+
+#endif	/* _NDN_FIB_HASH_LPM_H_ */
@@ -29,6 +29,7 @@
 #include "ns3/names.h"
 #include "ns3/log.h"
 
+#include <algorithm>
 #include <boost/ref.hpp>
 #include <boost/lambda/lambda.hpp>
 #include <boost/lambda/bind.hpp>
@@ -60,6 +61,11 @@ FibImpl::FibImpl ()
 void
 FibImpl::NotifyNewAggregate ()
 {
+  if (m_nameTree == 0)
+    {
+      m_nameTree = GetObject<NameTree> ();
+    }
+
   Object::NotifyNewAggregate ();
 }
 
@@ -67,6 +73,8 @@ void
 FibImpl::DoDispose (void)
 {
   clear ();
+  m_nameTree = 0;
+
   Object::DoDispose ();
 }
 
@@ -115,6 +123,9 @@ FibImpl::Add (const Ptr<const Name> &prefix, Ptr<Face> face, int32_t metric)
           Ptr<EntryImpl> newEntry = Create<EntryImpl> (this, prefix);
           newEntry->SetTrie (result.first);
           result.first->set_payload (newEntry);
+
+          if (m_nameTree != 0)
+            m_nameTree->SetFibEntry (*prefix, newEntry);
         }
   
       super::modify (result.first,
@@ -133,6 +144,104 @@ FibImpl::Add (const Ptr<const Name> &prefix, Ptr<Face> face, int32_t metric)
     return 0;
 }
 
+namespace {
+
+/**
+ * @brief Order of routes by prefix (needed to reuse trie path of the previous route)
+ */
+struct RoutePrefixLess
+{
+  bool
+  operator () (const Route &a, const Route &b) const
+  {
+    return *a.m_prefix < *b.m_prefix;
+  }
+};
+
+} // namespace
+
+void
+FibImpl::AddBulk (const RouteList &routes)
+{
+  NS_LOG_FUNCTION (this << routes.size ());
+
+  const RouteList *sorted = &routes;
+  RouteList sortedCopy;
+  for (size_t i = 1; i < routes.size (); i++)
+    {
+      if (RoutePrefixLess () (routes[i], routes[i - 1]))
+        {
+          sortedCopy = routes;
+          std::stable_sort (sortedCopy.begin (), sortedCopy.end (), RoutePrefixLess ());
+          sorted = &sortedCopy;
+          break;
+        }
+    }
+
+  std::vector< Ptr<Entry> > newEntries;
+
+  // path[i] is the trie node for the first i components of the previous prefix (path is cut short
+  // if nodes of the previous prefix have been pruned)
+  std::vector<super::iterator> path (1, &super::getTrie ());
+  const Name *previous = 0;
+
+  for (RouteList::const_iterator route = sorted->begin (); route != sorted->end (); route++)
+    {
+      const Name &prefix = *route->m_prefix;
+
+      Name::const_iterator component = prefix.begin ();
+      size_t common = 0;
+      if (previous != 0)
+        {
+          Name::const_iterator previousComponent = previous->begin ();
+          while (component != prefix.end () && previousComponent != previous->end () &&
+                 common + 1 < path.size () && *component == *previousComponent)
+            {
+              component++;
+              previousComponent++;
+              common++;
+            }
+        }
+      path.resize (common + 1);
+
+      for (; component != prefix.end (); component++)
+        {
+          path.push_back (path.back ()->find_or_create_child (*component));
+        }
+      previous = &prefix;
+
+      super::iterator item = path.back ();
+      if (item->payload () == 0)
+        {
+          Ptr<EntryImpl> newEntry = Create<EntryImpl> (this, route->m_prefix);
+          newEntry->SetTrie (item);
+          if (!super::insert_payload (item, newEntry))
+            {
+              // do not leave empty nodes in the trie; path stays valid only up to the closest remaining parent
+              super::iterator remaining = item->prune ();
+              while (path.back () != remaining)
+                path.pop_back ();
+              continue;
+            }
+
+          if (m_nameTree != 0)
+            m_nameTree->SetFibEntry (prefix, newEntry);
+
+          newEntries.push_back (newEntry);
+        }
+
+      item->payload ()->AddOrUpdateRoutingMetric (route->m_face, route->m_metric);
+      super::getPolicy ().update (super::s_iterator_to (item));
+    }
+
+  if (!newEntries.empty ())
+    {
+      // notify forwarding strategy about all new FIB entries at once
+      NS_ASSERT (this->GetObject<ForwardingStrategy> () != 0);
+      this->GetObject<ForwardingStrategy> ()->DidAddFibEntries (newEntries);
+    }
+}
+
 void
 FibImpl::Remove (const Ptr<const Name> &prefix)
 {
@@ -145,6 +254,9 @@ FibImpl::Remove (const Ptr<const Name> &prefix)
       NS_ASSERT (this->GetObject<ForwardingStrategy> () != 0);
       this->GetObject<ForwardingStrategy> ()->WillRemoveFibEntry (fibEntry->payload ());
 
+      if (m_nameTree != 0)
+        m_nameTree->RemoveFibEntry (*prefix, fibEntry->payload ());
+
       super::erase (fibEntry);
     }
   // else do nothing
@@ -213,7 +325,10 @@ FibImpl::RemoveFromAll (Ptr<Face> face)
           // notify forwarding strategy about soon be removed FIB entry
           NS_ASSERT (this->GetObject<ForwardingStrategy> () != 0);
           this->GetObject<ForwardingStrategy> ()->WillRemoveFibEntry (trieNode->payload ());
-          
+
+          if (m_nameTree != 0)
+            m_nameTree->RemoveFibEntry (trieNode->payload ()->GetPrefix (), trieNode->payload ());
+
           trieNode = super::parent_trie::recursive_iterator (trieNode->erase ());
         }
     }
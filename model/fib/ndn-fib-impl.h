@@ -26,6 +26,7 @@
 
 #include "../../utils/trie/trie-with-policy.h"
 #include "../../utils/trie/counting-policy.h"
+#include "../ndn-name-tree.h"
 
 namespace ns3 {
 namespace ndn {
@@ -97,6 +98,9 @@ public:
   virtual Ptr<Entry>
   Add (const Ptr<const Name> &prefix, Ptr<Face> face, int32_t metric);
 
+  virtual void
+  AddBulk (const RouteList &routes);
+
   virtual void
   Remove (const Ptr<const Name> &prefix);
 
@@ -142,6 +146,9 @@ private:
    */
   void
   RemoveFace (super::parent_trie &item, Ptr<Face> face);
+
+private:
+  Ptr<NameTree> m_nameTree; ///< \brief Link to the unified name tree (if enabled)
 };
 
 } // namespace fib
@@ -26,12 +26,38 @@
 
 #include "ns3/ndn-fib-entry.h"
 
+#include <vector>
+
 namespace ns3 {
 namespace ndn {
 
 class Interest;
 typedef Interest InterestHeader;
 
+namespace fib {
+
+/**
+ * @ingroup ndn
+ * @brief Route to be installed into FIB using Fib::AddBulk
+ */
+struct Route
+{
+  Route (const Ptr<const Name> &prefix, Ptr<Face> face, int32_t metric)
+    : m_prefix (prefix)
+    , m_face (face)
+    , m_metric (metric)
+  {
+  }
+
+  Ptr<const Name> m_prefix; ///< \brief Prefix
+  Ptr<Face> m_face;         ///< \brief Forwarding face
+  int32_t m_metric;         ///< \brief Routing metric
+};
+
+typedef std::vector<Route> RouteList; ///< \brief List of routes (preferably sorted by prefix)
+
+} // namespace fib
+
 /**
  * \ingroup ndn
  * \brief Class implementing FIB functionality
@@ -103,6 +129,18 @@ public:
   virtual Ptr<fib::Entry>
   Add (const Ptr<const Name> &prefix, Ptr<Face> face, int32_t metric) = 0;
 
+  /**
+   * \brief Add or update a batch of FIB entries
+   *
+   * The result is the same as calling Add for each route, but forwarding strategy is notified
+   * about all new entries at once (ForwardingStrategy::DidAddFibEntries).  When routes are sorted
+   * by prefix, implementation can reuse the lookup of the previous prefix for the next one.
+   *
+   * @param routes	List of routes
+   */
+  virtual void
+  AddBulk (const fib::RouteList &routes) = 0;
+
   /**
    * @brief Remove FIB entry
    *
@@ -129,7 +129,38 @@ Nacks::DidReceiveDuplicateInterest (Ptr<Face> inFace,
           NS_LOG_DEBUG ("No FwHopCountTag tag associated with received duplicated Interest");
         }
 
-      inFace->Send (nack);
+      inFace->SendInterest (nackHeader, nack);
+      m_outNacks (nackHeader, inFace);
+    }
+}
+
+void
+Nacks::DidExceedPitQuota (Ptr<Face> inFace,
+                          Ptr<const Interest> header,
+                          Ptr<const Packet> origPacket,
+                          Ptr<pit::Entry> pitEntry)
+{
+  super::DidExceedPitQuota (inFace, header, origPacket, pitEntry);
+
+  if (m_nacksEnabled)
+    {
+      NS_LOG_DEBUG ("Sending NACK_CONGESTION");
+      Ptr<Interest> nackHeader = Create<Interest> (*header);
+      nackHeader->SetNack (Interest::NACK_CONGESTION);
+      Ptr<Packet> nack = Create<Packet> ();
+      nack->AddHeader (*nackHeader);
+
+      FwHopCountTag hopCountTag;
+      if (origPacket->PeekPacketTag (hopCountTag))
+        {
+          nack->AddPacketTag (hopCountTag);
+        }
+      else
+        {
+          NS_LOG_DEBUG ("No FwHopCountTag tag associated with rejected Interest");
+        }
+
+      inFace->SendInterest (nackHeader, nack);
       m_outNacks (nackHeader, inFace);
     }
 }
@@ -157,10 +188,11 @@ Nacks::DidExhaustForwardingOptions (Ptr<Face> inFace,
           NS_LOG_DEBUG ("No FwHopCountTag tag associated with original Interest");
         }
 
+      Ptr<const Packet> prepared = Face::PrepareMulticast (packet); // shared by all incoming faces
       BOOST_FOREACH (const pit::IncomingFace &incoming, pitEntry->GetIncoming ())
         {
           NS_LOG_DEBUG ("Send NACK for " << boost::cref (nackHeader->GetName ()) << " to " << boost::cref (*incoming.m_face));
-          incoming.m_face->Send (packet->Copy ());
+          incoming.m_face->SendMulticastInterest (nackHeader, prepared);
 
           m_outNacks (nackHeader, incoming.m_face);
         }
@@ -54,6 +54,13 @@ protected:
                                Ptr<const Packet> packet,
                                Ptr<pit::Entry> pitEntry);
 
+  // from super
+  virtual void
+  DidExceedPitQuota (Ptr<Face> inFace,
+                     Ptr<const Interest> header,
+                     Ptr<const Packet> packet,
+                     Ptr<pit::Entry> pitEntry);
+
   // from super
   virtual void
   DidExhaustForwardingOptions (Ptr<Face> inFace,
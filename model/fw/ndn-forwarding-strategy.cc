@@ -29,6 +29,10 @@
 #include "ns3/ndn-fib.h"
 #include "ns3/ndn-content-store.h"
 #include "ns3/ndn-face.h"
+#include "ns3/ndn-header-helper.h"
+#include "ns3/ndnSIM/model/ndn-name-tree.h"
+#include "ns3/ndnSIM/model/ndn-nonce-filter.h"
+#include "ns3/ndnSIM/model/pit/ndn-pit-admission-control.h"
 
 #include "ns3/assert.h"
 #include "ns3/ptr.h"
@@ -122,6 +126,18 @@ ForwardingStrategy::NotifyNewAggregate ()
     {
       m_contentStore = GetObject<ContentStore> ();
     }
+  if (m_nameTree == 0)
+    {
+      m_nameTree = GetObject<NameTree> ();
+    }
+  if (m_nonceFilter == 0)
+    {
+      m_nonceFilter = GetObject<NonceFilter> ();
+    }
+  if (m_admissionControl == 0)
+    {
+      m_admissionControl = GetObject<pit::AdmissionControl> ();
+    }
 
   Object::NotifyNewAggregate ();
 }
@@ -132,6 +148,9 @@ ForwardingStrategy::DoDispose ()
   m_pit = 0;
   m_contentStore = 0;
   m_fib = 0;
+  m_nameTree = 0;
+  m_nonceFilter = 0;
+  m_admissionControl = 0;
 
   Object::DoDispose ();
 }
@@ -143,12 +162,59 @@ ForwardingStrategy::OnInterest (Ptr<Face> inFace,
 {
   m_inInterests (header, inFace);
 
-  Ptr<pit::Entry> pitEntry = m_pit->Lookup (*header);
+  // nonces are remembered per node, even after PIT entry is gone, so looped Interests are detected
+  // even if the PIT entry for them has already been satisfied or timed out
+  bool isDuplicated = false;
+  if (m_nonceFilter != 0)
+    {
+      isDuplicated = !m_nonceFilter->Add (header->GetName (), header->GetNonce ());
+    }
+
+  Ptr<pit::Entry> pitEntry;
+  Ptr<fib::Entry> fibEntry;
+  if (m_nameTree != 0)
+    {
+      // resolve both PIT and FIB in a single walk
+      boost::tie (pitEntry, fibEntry) = m_nameTree->Lookup (header->GetName ());
+    }
+  else
+    {
+      pitEntry = m_pit->Lookup (*header);
+    }
+
+  if (m_nonceFilter == 0 && pitEntry != 0)
+    {
+      isDuplicated = pitEntry->IsNonceSeen (header->GetNonce ());
+    }
+
+  if (isDuplicated)
+    {
+      // incoming face is still recorded in the live PIT entry (if any), but new PIT entry
+      // is never created for the looped Interest, so duplicates are not subject to PIT quotas
+      DidReceiveDuplicateInterest (inFace, header, origPacket, pitEntry);
+      return;
+    }
+
+  if (pitEntry == 0 && m_nameTree == 0 && m_admissionControl != 0)
+    {
+      // FIB entry is needed to check per-prefix quota, reuse it to create PIT entry
+      fibEntry = m_fib->LongestPrefixMatch (*header);
+    }
+
+  if (m_admissionControl != 0 && !m_admissionControl->CanAdmit (inFace, pitEntry, fibEntry))
+    {
+      DidExceedPitQuota (inFace, header, origPacket, pitEntry);
+      return;
+    }
+
   bool similarInterest = true;
   if (pitEntry == 0)
     {
       similarInterest = false;
-      pitEntry = m_pit->Create (header);
+      if (m_nameTree != 0 || m_admissionControl != 0)
+        pitEntry = m_pit->Create (header, fibEntry);
+      else
+        pitEntry = m_pit->Create (header);
       if (pitEntry != 0)
         {
           DidCreatePitEntry (inFace, header, origPacket, pitEntry);
@@ -160,17 +226,9 @@ ForwardingStrategy::OnInterest (Ptr<Face> inFace,
         }
     }
 
-  bool isDuplicated = true;
-  if (!pitEntry->IsNonceSeen (header->GetNonce ()))
+  if (m_nonceFilter == 0) // otherwise nonce has been already recorded in the filter
     {
       pitEntry->AddSeenNonce (header->GetNonce ());
-      isDuplicated = false;
-    }
-
-  if (isDuplicated)
-    {
-      DidReceiveDuplicateInterest (inFace, header, origPacket, pitEntry);
-      return;
     }
 
   Ptr<Packet> contentObject;
@@ -181,6 +239,22 @@ ForwardingStrategy::OnInterest (Ptr<Face> inFace,
     {
       NS_ASSERT (contentObjectHeader != 0);
 
+      if (contentObjectHeader->GetHopCount () != header->GetHopCount ())
+        {
+          // same as with FwHopCountTag, hop count in the header continues from the Interest
+          Ptr<ContentObject> hopCountHeader = Create<ContentObject> (*contentObjectHeader);
+          hopCountHeader->SetHopCount (header->GetHopCount ());
+
+          if (header->GetHopCount () < 0 || contentObjectHeader->GetHopCount () < 0 ||
+              !HeaderHelper::SetHopCount (contentObject, header->GetHopCount ()))
+            {
+              // presence of the hop count changes size of the header, so it has to be re-encoded
+              contentObject->RemoveAtStart (contentObjectHeader->GetSerializedSize ());
+              contentObject->AddHeader (*hopCountHeader);
+            }
+          contentObjectHeader = hopCountHeader;
+        }
+
       FwHopCountTag hopCountTag;
       if (origPacket->PeekPacketTag (hopCountTag))
         {
@@ -229,7 +303,7 @@ ForwardingStrategy::OnData (Ptr<Face> inFace,
   m_inData (header, payload, inFace);
 
   // Lookup PIT entry
-  Ptr<pit::Entry> pitEntry = m_pit->Lookup (*header);
+  Ptr<pit::Entry> pitEntry = (m_nameTree != 0) ? m_nameTree->LookupData (header->GetName ()) : m_pit->Lookup (*header);
   if (pitEntry == 0)
     {
       bool cached = false;
@@ -287,7 +361,7 @@ ForwardingStrategy::OnData (Ptr<Face> inFace,
       SatisfyPendingInterest (inFace, header, payload, origPacket, pitEntry);
 
       // Lookup another PIT entry
-      pitEntry = m_pit->Lookup (*header);
+      pitEntry = (m_nameTree != 0) ? m_nameTree->LookupData (header->GetName ()) : m_pit->Lookup (*header);
     }
 }
 
@@ -307,6 +381,15 @@ ForwardingStrategy::FailedToCreatePitEntry (Ptr<Face> inFace,
   m_dropInterests (header, inFace);
 }
 
+void
+ForwardingStrategy::DidExceedPitQuota (Ptr<Face> inFace,
+                                       Ptr<const Interest> header,
+                                       Ptr<const Packet> origPacket,
+                                       Ptr<pit::Entry> pitEntry)
+{
+  m_dropInterests (header, inFace);
+}
+
 void
 ForwardingStrategy::DidReceiveDuplicateInterest (Ptr<Face> inFace,
                                                  Ptr<const Interest> header,
@@ -318,7 +401,8 @@ ForwardingStrategy::DidReceiveDuplicateInterest (Ptr<Face> inFace,
   // !!!! IMPORTANT CHANGE !!!! Duplicate interests will create incoming face entry !!!! //
   //                                                                                     //
   /////////////////////////////////////////////////////////////////////////////////////////
-  pitEntry->AddIncoming (inFace);
+  if (pitEntry != 0) // nonce filter can detect looped Interest after its PIT entry is gone
+    pitEntry->AddIncoming (inFace);
   m_dropInterests (header, inFace);
 }
 
@@ -391,10 +475,13 @@ ForwardingStrategy::SatisfyPendingInterest (Ptr<Face> inFace,
   if (inFace != 0)
     pitEntry->RemoveIncoming (inFace);
 
+  // the same packet (with hop count incremented only once) is shared by all incoming faces
+  Ptr<const Packet> packet = Face::PrepareMulticast (origPacket);
+
   //satisfy all pending incoming Interests
   BOOST_FOREACH (const pit::IncomingFace &incoming, pitEntry->GetIncoming ())
     {
-      bool ok = incoming.m_face->Send (origPacket->Copy ());
+      bool ok = incoming.m_face->SendMulticastData (header, packet);
 
       DidSendOutData (inFace, incoming.m_face, header, payload, origPacket, pitEntry);
       NS_LOG_DEBUG ("Satisfy " << *incoming.m_face);
@@ -573,7 +660,7 @@ ForwardingStrategy::TrySendOutInterest (Ptr<Face> inFace,
 
   //transmission
   Ptr<Packet> packetToSend = origPacket->Copy ();
-  bool successSend = outFace->Send (packetToSend);
+  bool successSend = outFace->SendInterest (header, packetToSend);
   if (!successSend)
     {
       m_dropInterests (header, outFace);
@@ -629,6 +716,17 @@ ForwardingStrategy::DidAddFibEntry (Ptr<fib::Entry> fibEntry)
   // do nothing here
 }
 
+void
+ForwardingStrategy::DidAddFibEntries (const std::vector< Ptr<fib::Entry> > &fibEntries)
+{
+  for (std::vector< Ptr<fib::Entry> >::const_iterator entry = fibEntries.begin ();
+       entry != fibEntries.end ();
+       entry++)
+    {
+      DidAddFibEntry (*entry);
+    }
+}
+
 void
 ForwardingStrategy::WillRemoveFibEntry (Ptr<fib::Entry> fibEntry)
 {
@@ -26,6 +26,8 @@
 #include "ns3/object.h"
 #include "ns3/traced-callback.h"
 
+#include <vector>
+
 namespace ns3 {
 namespace ndn {
 
@@ -38,11 +40,13 @@ typedef Interest InterestHeader;
 typedef ContentObject ContentObjectHeader;
 
 class Pit;
-namespace pit { class Entry; }
+namespace pit { class Entry; class AdmissionControl; }
 class FibFaceMetric;
 class Fib;
 namespace fib { class Entry; }
 class ContentStore;
+class NameTree;
+class NonceFilter;
 
 /**
  * \ingroup ndn
@@ -123,6 +127,16 @@ public:
   virtual void
   DidAddFibEntry (Ptr<fib::Entry> fibEntry);
 
+  /**
+   * @brief Event fired once when a batch of FIB entries is added to FIB (Fib::AddBulk)
+   *
+   * Default implementation calls DidAddFibEntry for each entry
+   *
+   * @param fibEntries FIB entries that were added
+   */
+  virtual void
+  DidAddFibEntries (const std::vector< Ptr<fib::Entry> > &fibEntries);
+
   /**
    * @brief Fired just before FIB entry will be removed from FIB
    * @param fibEntry FIB entry that will be removed
@@ -168,6 +182,26 @@ protected:
                           Ptr<const Interest> header,
                           Ptr<const Packet> origPacket);
 
+  /**
+   * @brief An event that is fired every time an Interest is not admitted to PIT by pit::AdmissionControl
+   *
+   * Quotas are checked only for Interests that would add state to PIT (new entry or new incoming face
+   * record), duplicate Interests are detected before the check.
+   *
+   * This even is the last action that is performed before the Interest processing is halted.
+   * Default implementation drops the Interest
+   *
+   * @param inFace  incoming face
+   * @param header  deserialized Interest header
+   * @param origPacket  original packet
+   * @param pitEntry an existing PIT entry for the Interest (0 if there is no entry)
+   */
+  virtual void
+  DidExceedPitQuota (Ptr<Face> inFace,
+                     Ptr<const Interest> header,
+                     Ptr<const Packet> origPacket,
+                     Ptr<pit::Entry> pitEntry);
+
   /**
    * @brief An event that is fired every time a duplicated Interest is received
    *
@@ -177,6 +211,7 @@ protected:
    * @param header  deserialized Interest header
    * @param origPacket  original packet
    * @param pitEntry an existing PIT entry, corresponding to the duplicated Interest
+   *                 (0, if duplicate is detected by the per-node nonce filter and there is no live PIT entry)
    *
    * @see DidReceiveDuplicateInterest, DidSuppressSimilarInterest, DidForwardSimilarInterest, ShouldSuppressIncomingInterest
    */
@@ -475,6 +510,9 @@ protected:
   Ptr<Pit> m_pit; ///< \brief Reference to PIT to which this forwarding strategy is associated
   Ptr<Fib> m_fib; ///< \brief FIB
   Ptr<ContentStore> m_contentStore; ///< \brief Content store (for caching purposes only)
+  Ptr<NameTree> m_nameTree; ///< \brief Unified name tree (optional, used to resolve PIT and FIB in a single lookup)
+  Ptr<NonceFilter> m_nonceFilter; ///< \brief Per-node filter of seen nonces (optional, replaces nonces recorded in PIT entries)
+  Ptr<pit::AdmissionControl> m_admissionControl; ///< \brief Per-face and per-prefix PIT quotas (optional)
 
   bool m_cacheUnsolicitedData;
   bool m_detectRetransmissions;
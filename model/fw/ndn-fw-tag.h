@@ -22,6 +22,15 @@
 #ifndef NDNSIM_FW_TAG_H
 #define NDNSIM_FW_TAG_H
 
+#include <map>
+#include <typeinfo>
+#include <stdint.h>
+
+#include <boost/shared_ptr.hpp>
+#include <boost/make_shared.hpp>
+
+#include "ns3/ndnSIM/utils/ndn-object-pool.h"
+
 namespace ns3 {
 namespace ndn {
 namespace fw {
@@ -29,12 +38,90 @@ namespace fw {
 /**
  * \ingroup ndn
  * \brief Abstract class for the forwarding strategy tag, which can be added to PIT entries
+ *
+ * Each tag type is assigned a slot index (on first use), so PIT entries can keep tags
+ * in a compact array and access them by index instead of searching through a list
  */
 class Tag
 {
 public:
   virtual ~Tag () { };
+
+  /**
+   * @brief Get slot index assigned to the tag type (new index is assigned if the type is seen for the first time)
+   *
+   * This call involves a lookup in the registry. Use TagSlot<T>::Get () when type is known at compile time
+   */
+  static inline uint32_t
+  GetSlot (const std::type_info &type);
+};
+
+/**
+ * \ingroup ndn
+ * \brief Registry of forwarding strategy tag types
+ *
+ * Slot index for the type T is looked up only once, all subsequent calls just return the cached value
+ */
+template<class T>
+struct TagSlot
+{
+  /**
+   * @brief Get slot index of the tag type T
+   */
+  static inline uint32_t
+  Get ()
+  {
+    static const uint32_t slot = Tag::GetSlot (typeid (T));
+    return slot;
+  }
+};
+
+/// @cond include_hidden
+struct TypeInfoLess
+{
+  bool
+  operator () (const std::type_info *a, const std::type_info *b) const
+  {
+    return a->before (*b);
+  }
 };
+/// @endcond
+
+/**
+ * \ingroup ndn
+ * \brief Create forwarding strategy tag of type T
+ *
+ * The tag and its reference counter are placed in one memory block, which is returned to the pool
+ * when the tag is released and reused for the next tag of the same type
+ */
+template<class T>
+inline boost::shared_ptr<T>
+MakeTag ()
+{
+  return boost::allocate_shared<T> (ObjectPoolAllocator<T> ());
+}
+
+/**
+ * \ingroup ndn
+ * \brief Create forwarding strategy tag of type T, passing one argument to the constructor
+ * @see MakeTag ()
+ */
+template<class T, class A1>
+inline boost::shared_ptr<T>
+MakeTag (const A1 &a1)
+{
+  return boost::allocate_shared<T> (ObjectPoolAllocator<T> (), a1);
+}
+
+inline uint32_t
+Tag::GetSlot (const std::type_info &type)
+{
+  typedef std::map<const std::type_info *, uint32_t, TypeInfoLess> slot_map;
+  static slot_map slots;
+
+  std::pair<slot_map::iterator, bool> item = slots.insert (std::make_pair (&type, static_cast<uint32_t> (slots.size ())));
+  return item.first->second;
+}
 
 } // namespace fw
 } // namespace ndn
@@ -28,6 +28,8 @@
 #include "best-route.h"
 #include "flooding.h"
 #include "smart-flooding.h"
+#include "rtt-adaptive.h"
+#include "weighted-multipath.h"
 
 namespace ns3 {
 namespace ndn {
@@ -36,6 +38,8 @@ namespace fw {
 extern template class PerOutFaceLimits<BestRoute>;
 extern template class PerOutFaceLimits<Flooding>;
 extern template class PerOutFaceLimits<SmartFlooding>;
+extern template class PerOutFaceLimits<RttAdaptive>;
+extern template class PerOutFaceLimits<WeightedMultipath>;
 
 template class PerFibLimits< PerOutFaceLimits<BestRoute> >;
 typedef PerFibLimits< PerOutFaceLimits<BestRoute> > PerFibLimitsPerOutFaceLimitsBestRoute;
@@ -49,6 +53,14 @@ template class PerFibLimits< PerOutFaceLimits<SmartFlooding> >;
 typedef PerFibLimits< PerOutFaceLimits<SmartFlooding> > PerFibLimitsPerOutFaceLimitsSmartFlooding;
 NS_OBJECT_ENSURE_REGISTERED (PerFibLimitsPerOutFaceLimitsSmartFlooding);
 
+template class PerFibLimits< PerOutFaceLimits<RttAdaptive> >;
+typedef PerFibLimits< PerOutFaceLimits<RttAdaptive> > PerFibLimitsPerOutFaceLimitsRttAdaptive;
+NS_OBJECT_ENSURE_REGISTERED (PerFibLimitsPerOutFaceLimitsRttAdaptive);
+
+template class PerFibLimits< PerOutFaceLimits<WeightedMultipath> >;
+typedef PerFibLimits< PerOutFaceLimits<WeightedMultipath> > PerFibLimitsPerOutFaceLimitsWeightedMultipath;
+NS_OBJECT_ENSURE_REGISTERED (PerFibLimitsPerOutFaceLimitsWeightedMultipath);
+
 #ifdef DOXYGEN
 // /**
 //  * \brief Strategy implementing per-fib-per-out-face limits on top of BestRoute strategy
@@ -65,6 +77,16 @@ class Flooding::PerOutFaceLimits::PerFibLimits : public ::ns3::ndn::fw::PerFibLi
  */
 class SmartFlooding::PerOutFaceLimits::PerFibLimits : public ::ns3::ndn::fw::PerFibLimits< ::ns3::ndn::fw::PerOutFaceLimits<SmartFlooding> > { };
 
+/**
+ * \brief Strategy implementing per-fib-per-out-face limits on top of RttAdaptive strategy
+ */
+class RttAdaptive::PerOutFaceLimits::PerFibLimits : public ::ns3::ndn::fw::PerFibLimits< ::ns3::ndn::fw::PerOutFaceLimits<RttAdaptive> > { };
+
+/**
+ * \brief Strategy implementing per-fib-per-out-face limits on top of WeightedMultipath strategy
+ */
+class WeightedMultipath::PerOutFaceLimits::PerFibLimits : public ::ns3::ndn::fw::PerFibLimits< ::ns3::ndn::fw::PerOutFaceLimits<WeightedMultipath> > { };
+
 #endif
 
 } // namespace fw
@@ -27,6 +27,8 @@
 #include "best-route.h"
 #include "flooding.h"
 #include "smart-flooding.h"
+#include "rtt-adaptive.h"
+#include "weighted-multipath.h"
 
 namespace ns3 {
 namespace ndn {
@@ -44,6 +46,14 @@ template class PerOutFaceLimits<SmartFlooding>;
 typedef PerOutFaceLimits<SmartFlooding> PerOutFaceLimitsSmartFlooding;
 NS_OBJECT_ENSURE_REGISTERED (PerOutFaceLimitsSmartFlooding);
 
+template class PerOutFaceLimits<RttAdaptive>;
+typedef PerOutFaceLimits<RttAdaptive> PerOutFaceLimitsRttAdaptive;
+NS_OBJECT_ENSURE_REGISTERED (PerOutFaceLimitsRttAdaptive);
+
+template class PerOutFaceLimits<WeightedMultipath>;
+typedef PerOutFaceLimits<WeightedMultipath> PerOutFaceLimitsWeightedMultipath;
+NS_OBJECT_ENSURE_REGISTERED (PerOutFaceLimitsWeightedMultipath);
+
 #ifdef DOXYGEN
 // /**
 //  * \brief Strategy implementing per-out-face limits on top of BestRoute strategy
@@ -59,6 +69,16 @@ class Flooding::PerOutFaceLimits : public ::ns3::ndn::fw::PerOutFaceLimits<Flood
  * \brief Strategy implementing per-out-face limits on top of SmartFlooding strategy
  */
 class SmartFlooding::PerOutFaceLimits : public ::ns3::ndn::fw::PerOutFaceLimits<SmartFlooding> { };
+
+/**
+ * \brief Strategy implementing per-out-face limits on top of RttAdaptive strategy
+ */
+class RttAdaptive::PerOutFaceLimits : public ::ns3::ndn::fw::PerOutFaceLimits<RttAdaptive> { };
+
+/**
+ * \brief Strategy implementing per-out-face limits on top of WeightedMultipath strategy
+ */
+class WeightedMultipath::PerOutFaceLimits : public ::ns3::ndn::fw::PerOutFaceLimits<WeightedMultipath> { };
 #endif
 
 } // namespace fw
@@ -0,0 +1,187 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2011 University of California, Los Angeles
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ * Author: Alexander Afanasyev <alexander.afanasyev@ucla.edu>
+ */
+
+#include "rtt-adaptive.h"
+
+#include "ns3/ndn-interest.h"
+#include "ns3/ndn-pit.h"
+#include "ns3/ndn-pit-entry.h"
+#include "ns3/ndn-fib.h"
+
+#include "ns3/assert.h"
+#include "ns3/log.h"
+#include "ns3/double.h"
+
+#include <limits>
+#include <vector>
+#include <algorithm>
+#include <boost/foreach.hpp>
+#include <boost/ref.hpp>
+
+namespace ns3 {
+namespace ndn {
+namespace fw {
+
+NS_OBJECT_ENSURE_REGISTERED (RttAdaptive);
+
+LogComponent RttAdaptive::g_log = LogComponent (RttAdaptive::GetLogName ().c_str ());
+
+std::string
+RttAdaptive::GetLogName ()
+{
+  return super::GetLogName ()+".RttAdaptive";
+}
+
+
+TypeId
+RttAdaptive::GetTypeId (void)
+{
+  static TypeId tid = TypeId ("ns3::ndn::fw::RttAdaptive")
+    .SetGroupName ("Ndn")
+    .SetParent <super> ()
+    .AddConstructor <RttAdaptive> ()
+
+    .AddAttribute ("ProbingProbability", "Probability to send a copy of Interest to an alternative face",
+                   DoubleValue (0.05),
+                   MakeDoubleAccessor (&RttAdaptive::m_probingProbability),
+                   MakeDoubleChecker<double> (0.0, 1.0))
+
+    .AddAttribute ("MinSatisfactionRatio", "Lower bound of the face satisfaction ratio used to calculate the score of the face",
+                   DoubleValue (0.01),
+                   MakeDoubleAccessor (&RttAdaptive::m_minSatisfactionRatio),
+                   MakeDoubleChecker<double> (0.0001, 1.0))
+    ;
+  return tid;
+}
+
+RttAdaptive::RttAdaptive ()
+  : m_probingProbability (0.05)
+  , m_minSatisfactionRatio (0.01)
+  , m_random (0.0, 1.0)
+{
+}
+
+double
+RttAdaptive::GetScore (const fib::FaceMetric &metricFace) const
+{
+  if (metricFace.GetSRtt ().IsZero ())
+    return std::numeric_limits<double>::infinity ();
+
+  return metricFace.GetSRtt ().ToDouble (Time::S) /
+    std::max (metricFace.GetSatisfactionRatio (), m_minSatisfactionRatio);
+}
+
+bool
+RttAdaptive::DoPropagateInterest (Ptr<Face> inFace,
+                                  Ptr<const Interest> header,
+                                  Ptr<const Packet> origPacket,
+                                  Ptr<pit::Entry> pitEntry)
+{
+  NS_LOG_FUNCTION (this << header->GetName ());
+
+  Ptr<fib::Entry> fibEntry = pitEntry->GetFibEntry ();
+
+  std::vector<Candidate> candidates;
+  BOOST_FOREACH (const fib::FaceMetric &metricFace, fibEntry->m_faces.get<fib::i_metric> ())
+    {
+      if (metricFace.GetStatus () == fib::FaceMetric::NDN_FIB_RED) // all non-red faces are in front
+        break;
+
+      candidates.push_back (Candidate (GetScore (metricFace), metricFace.GetFace ()));
+    }
+  // equally scored (e.g., not yet measured) faces stay in the order of the routing cost
+  std::stable_sort (candidates.begin (), candidates.end (), CandidateLess ());
+
+  int propagatedCount = 0;
+
+  std::vector<Candidate>::iterator best = candidates.begin ();
+  for (; best != candidates.end (); best++)
+    {
+      NS_LOG_DEBUG ("Trying " << boost::cref (*best->second) << " with score " << best->first);
+      if (TrySendOutInterest (inFace, best->second, header, origPacket, pitEntry))
+        {
+          propagatedCount++;
+          break;
+        }
+    }
+
+  if (best != candidates.end () && candidates.size () > 1 &&
+      (fibEntry->m_needsProbing || m_random.GetValue () < m_probingProbability))
+    {
+      // probe faces without measurements first
+      std::vector<Candidate>::iterator first = best + 1;
+      while (first != candidates.end () && first->first != std::numeric_limits<double>::infinity ())
+        first++;
+      if (first == candidates.end ())
+        first = candidates.begin ();
+
+      std::vector<Ptr<Face> > alternatives;
+      for (std::vector<Candidate>::iterator candidate = first; candidate != candidates.end (); candidate++)
+        {
+          if (candidate != best)
+            alternatives.push_back (candidate->second);
+        }
+
+      if (!alternatives.empty ())
+        {
+          Ptr<Face> probe = alternatives[m_random.GetInteger (0, alternatives.size () - 1)];
+
+          NS_LOG_DEBUG ("Probing " << boost::cref (*probe));
+          if (TrySendOutInterest (inFace, probe, header, origPacket, pitEntry))
+            {
+              propagatedCount++;
+              fibEntry->m_needsProbing = false;
+            }
+        }
+    }
+
+  NS_LOG_INFO ("Propagated to " << propagatedCount << " faces");
+  return propagatedCount > 0;
+}
+
+void
+RttAdaptive::WillEraseTimedOutPendingInterest (Ptr<pit::Entry> pitEntry)
+{
+  if (pitEntry->GetOutgoing ().size () > 0)
+    pitEntry->GetFibEntry ()->m_needsProbing = true;
+
+  super::WillEraseTimedOutPendingInterest (pitEntry);
+}
+
+void
+RttAdaptive::DidReceiveValidNack (Ptr<Face> inFace,
+                                  uint32_t nackCode,
+                                  Ptr<const Interest> header,
+                                  Ptr<const Packet> origPacket,
+                                  Ptr<pit::Entry> pitEntry)
+{
+  if (inFace != 0 &&
+      (nackCode == Interest::NACK_CONGESTION ||
+       nackCode == Interest::NACK_GIVEUP_PIT))
+    {
+      pitEntry->GetFibEntry ()->m_needsProbing = true;
+    }
+
+  super::DidReceiveValidNack (inFace, nackCode, header, origPacket, pitEntry);
+}
+
+} // namespace fw
+} // namespace ndn
+} // namespace ns3
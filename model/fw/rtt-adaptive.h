@@ -0,0 +1,108 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2011 University of California, Los Angeles
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ * Author: Alexander Afanasyev <alexander.afanasyev@ucla.edu>
+ */
+
+
+#ifndef NDNSIM_RTT_ADAPTIVE_H
+#define NDNSIM_RTT_ADAPTIVE_H
+
+#include "satisfaction-ratio.h"
+#include "ns3/log.h"
+#include "ns3/random-variable.h"
+
+namespace ns3 {
+namespace ndn {
+
+namespace fib {
+class FaceMetric;
+}
+
+namespace fw {
+
+/**
+ * \ingroup ndn
+ * \brief RTT-aware adaptive strategy
+ *
+ * Interest is sent to a single non-RED face with the best score, where score is smoothed RTT of
+ * the face divided by the measured fraction of Interests satisfied via the face.  Faces without
+ * RTT measurements are ranked after measured ones, in the order of the routing cost.
+ *
+ * To discover better paths, a copy of Interest is sent to one of the alternative faces (faces
+ * without measurements are preferred) with ProbingProbability, or after an Interest for the same
+ * FIB entry has timed out or has been NACKed (fib::Entry::m_needsProbing).
+ */
+class RttAdaptive :
+    public SatisfactionRatio
+{
+private:
+  typedef SatisfactionRatio super;
+
+public:
+  static TypeId
+  GetTypeId ();
+
+  /**
+   * @brief Helper function to retrieve logging name for the forwarding strategy
+   */
+  static std::string
+  GetLogName ();
+
+  /**
+   * @brief Default constructor
+   */
+  RttAdaptive ();
+
+  // from super
+  virtual bool
+  DoPropagateInterest (Ptr<Face> incomingFace,
+                       Ptr<const Interest> header,
+                       Ptr<const Packet> origPacket,
+                       Ptr<pit::Entry> pitEntry);
+
+protected:
+  virtual void
+  WillEraseTimedOutPendingInterest (Ptr<pit::Entry> pitEntry);
+
+  virtual void
+  DidReceiveValidNack (Ptr<Face> incomingFace,
+                       uint32_t nackCode,
+                       Ptr<const Interest> header,
+                       Ptr<const Packet> origPacket,
+                       Ptr<pit::Entry> pitEntry);
+
+  /**
+   * @brief Get score of the face (smaller is better, infinity if RTT has not been measured yet)
+   */
+  double
+  GetScore (const fib::FaceMetric &metricFace) const;
+
+protected:
+  static LogComponent g_log;
+
+private:
+  double m_probingProbability;  ///< \brief Probability to probe an alternative face
+  double m_minSatisfactionRatio; ///< \brief Lower bound of the satisfaction ratio used in the score
+  UniformVariable m_random;
+};
+
+} // namespace fw
+} // namespace ndn
+} // namespace ns3
+
+#endif // NDNSIM_RTT_ADAPTIVE_H
@@ -0,0 +1,89 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2011 University of California, Los Angeles
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ * Author: Alexander Afanasyev <alexander.afanasyev@ucla.edu>
+ */
+
+#include "satisfaction-ratio.h"
+
+#include "ns3/ndn-interest.h"
+#include "ns3/ndn-pit.h"
+#include "ns3/ndn-pit-entry.h"
+#include "ns3/ndn-fib.h"
+
+namespace ns3 {
+namespace ndn {
+namespace fw {
+
+NS_OBJECT_ENSURE_REGISTERED (SatisfactionRatio);
+
+TypeId
+SatisfactionRatio::GetTypeId (void)
+{
+  static TypeId tid = TypeId ("ns3::ndn::fw::SatisfactionRatio")
+    .SetGroupName ("Ndn")
+    .SetParent <super> ()
+    ;
+  return tid;
+}
+
+void
+SatisfactionRatio::WillSatisfyPendingInterest (Ptr<Face> inFace,
+                                               Ptr<pit::Entry> pitEntry)
+{
+  if (inFace != 0 &&
+      pitEntry->GetOutgoing ().find (inFace) != pitEntry->GetOutgoing ().end ())
+    {
+      pitEntry->GetFibEntry ()->UpdateFaceSatisfaction (inFace, true);
+    }
+
+  super::WillSatisfyPendingInterest (inFace, pitEntry);
+}
+
+void
+SatisfactionRatio::WillEraseTimedOutPendingInterest (Ptr<pit::Entry> pitEntry)
+{
+  for (pit::Entry::out_container::iterator face = pitEntry->GetOutgoing ().begin ();
+       face != pitEntry->GetOutgoing ().end ();
+       face ++)
+    {
+      pitEntry->GetFibEntry ()->UpdateFaceSatisfaction (face->m_face, false);
+    }
+
+  super::WillEraseTimedOutPendingInterest (pitEntry);
+}
+
+void
+SatisfactionRatio::DidReceiveValidNack (Ptr<Face> inFace,
+                                        uint32_t nackCode,
+                                        Ptr<const Interest> header,
+                                        Ptr<const Packet> origPacket,
+                                        Ptr<pit::Entry> pitEntry)
+{
+  if (inFace != 0 &&
+      (nackCode == Interest::NACK_CONGESTION ||
+       nackCode == Interest::NACK_GIVEUP_PIT))
+    {
+      pitEntry->GetFibEntry ()->UpdateFaceSatisfaction (inFace, false);
+    }
+
+  super::DidReceiveValidNack (inFace, nackCode, header, origPacket, pitEntry);
+}
+
+} // namespace fw
+} // namespace ndn
+} // namespace ns3
@@ -0,0 +1,84 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2011 University of California, Los Angeles
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ * Author: Alexander Afanasyev <alexander.afanasyev@ucla.edu>
+ */
+
+#ifndef NDNSIM_SATISFACTION_RATIO_H
+#define NDNSIM_SATISFACTION_RATIO_H
+
+#include "green-yellow-red.h"
+
+#include <utility>
+
+namespace ns3 {
+namespace ndn {
+namespace fw {
+
+/**
+ * \ingroup ndn
+ * \brief Base for strategies that rank faces using the fraction of satisfied Interests
+ *
+ * Keeps fib::FaceMetric::GetSatisfactionRatio up to date: Data received via an outgoing face of
+ * the PIT entry counts as a success for the face, while timeout of the PIT entry (for all its
+ * outgoing faces) and congestion or PIT give-up NACKs count as failures.
+ */
+class SatisfactionRatio :
+    public GreenYellowRed
+{
+private:
+  typedef GreenYellowRed super;
+
+public:
+  static TypeId
+  GetTypeId ();
+
+protected:
+  virtual void
+  WillSatisfyPendingInterest (Ptr<Face> inFace,
+                              Ptr<pit::Entry> pitEntry);
+
+  virtual void
+  WillEraseTimedOutPendingInterest (Ptr<pit::Entry> pitEntry);
+
+  virtual void
+  DidReceiveValidNack (Ptr<Face> incomingFace,
+                       uint32_t nackCode,
+                       Ptr<const Interest> header,
+                       Ptr<const Packet> origPacket,
+                       Ptr<pit::Entry> pitEntry);
+
+  typedef std::pair<double, Ptr<Face> > Candidate; ///< @brief (score, face)
+
+  /**
+   * @brief Order candidates by score (smaller score first)
+   */
+  struct CandidateLess
+  {
+    bool
+    operator () (const Candidate &a, const Candidate &b) const
+    {
+      return a.first < b.first;
+    }
+  };
+};
+
+} // namespace fw
+} // namespace ndn
+} // namespace ns3
+
+#endif // NDNSIM_SATISFACTION_RATIO_H
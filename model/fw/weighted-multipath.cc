@@ -0,0 +1,194 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2011 University of California, Los Angeles
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ * Author: Alexander Afanasyev <alexander.afanasyev@ucla.edu>
+ */
+
+#include "weighted-multipath.h"
+
+#include "ns3/ndn-interest.h"
+#include "ns3/ndn-pit.h"
+#include "ns3/ndn-pit-entry.h"
+#include "ns3/ndn-fib.h"
+#include "ns3/ndn-limits.h"
+
+#include "ns3/node.h"
+
+#include "ns3/assert.h"
+#include "ns3/log.h"
+#include "ns3/double.h"
+#include "ns3/uinteger.h"
+
+#include <math.h>
+#include <vector>
+#include <algorithm>
+#include <boost/foreach.hpp>
+#include <boost/ref.hpp>
+#include <boost/functional/hash.hpp>
+
+namespace ns3 {
+namespace ndn {
+namespace fw {
+
+NS_OBJECT_ENSURE_REGISTERED (WeightedMultipath);
+
+LogComponent WeightedMultipath::g_log = LogComponent (WeightedMultipath::GetLogName ().c_str ());
+
+std::string
+WeightedMultipath::GetLogName ()
+{
+  return super::GetLogName ()+".WeightedMultipath";
+}
+
+
+TypeId
+WeightedMultipath::GetTypeId (void)
+{
+  static TypeId tid = TypeId ("ns3::ndn::fw::WeightedMultipath")
+    .SetGroupName ("Ndn")
+    .SetParent <super> ()
+    .AddConstructor <WeightedMultipath> ()
+
+    .AddAttribute ("FlowPrefixLength", "Number of first name components that identify a flow (0 means the whole name, "
+                   "i.e., every Interest is distributed independently). Interests of the same flow stick to the same face",
+                   UintegerValue (0),
+                   MakeUintegerAccessor (&WeightedMultipath::m_flowPrefixLength),
+                   MakeUintegerChecker<uint32_t> ())
+
+    .AddAttribute ("MinSatisfactionRatio", "Lower bound of the face satisfaction ratio used to calculate the weight of the face",
+                   DoubleValue (0.01),
+                   MakeDoubleAccessor (&WeightedMultipath::m_minSatisfactionRatio),
+                   MakeDoubleChecker<double> (0.0001, 1.0))
+    ;
+  return tid;
+}
+
+WeightedMultipath::WeightedMultipath ()
+  : m_flowPrefixLength (0)
+  , m_minSatisfactionRatio (0.01)
+  , m_nodeId (0)
+{
+}
+
+void
+WeightedMultipath::NotifyNewAggregate ()
+{
+  Ptr<Node> node = GetObject<Node> ();
+  if (node != 0)
+    {
+      m_nodeId = node->GetId ();
+    }
+
+  super::NotifyNewAggregate ();
+}
+
+namespace {
+
+/**
+ * @brief Mix hash of the flow with node and face IDs (splitmix64 finalizer)
+ *
+ * Without the node ID, all nodes with the same face IDs would make correlated choices for the same
+ * flow, e.g., the flow that goes to the first face on one hop would go to the first face on every hop
+ *
+ * @returns pseudo-random number in (0, 1)
+ */
+double
+GetUniform (uint64_t flowHash, uint32_t nodeId, uint32_t faceId)
+{
+  uint64_t key = (static_cast<uint64_t> (nodeId) << 32) | faceId;
+  uint64_t hash = flowHash ^ ((key + 1) * 0x9E3779B97F4A7C15ULL);
+  hash = (hash ^ (hash >> 30)) * 0xBF58476D1CE4E5B9ULL;
+  hash = (hash ^ (hash >> 27)) * 0x94D049BB133111EBULL;
+  hash = hash ^ (hash >> 31);
+
+  return ((hash >> 11) + 0.5) / 9007199254740992.0; // 2^53
+}
+
+} // namespace
+
+double
+WeightedMultipath::GetWeight (const fib::FaceMetric &metricFace) const
+{
+  double capacity = 1.0;
+  Ptr<Limits> limits = metricFace.GetFace ()->GetObject<Limits> ();
+  if (limits != 0 && limits->IsEnabled () && limits->GetMaxRate () > 0)
+    capacity = limits->GetMaxRate ();
+
+  return capacity * std::max (metricFace.GetSatisfactionRatio (), m_minSatisfactionRatio);
+}
+
+uint64_t
+WeightedMultipath::GetFlowHash (const Name &name) const
+{
+  std::size_t seed = 0;
+  uint32_t length = 0;
+  BOOST_FOREACH (const std::string &component, name)
+    {
+      if (m_flowPrefixLength > 0 && length >= m_flowPrefixLength)
+        break;
+
+      boost::hash_combine (seed, component);
+      length++;
+    }
+  return seed;
+}
+
+bool
+WeightedMultipath::DoPropagateInterest (Ptr<Face> inFace,
+                                        Ptr<const Interest> header,
+                                        Ptr<const Packet> origPacket,
+                                        Ptr<pit::Entry> pitEntry)
+{
+  NS_LOG_FUNCTION (this << header->GetName ());
+
+  uint64_t flowHash = GetFlowHash (header->GetName ());
+
+  // weighted rendezvous hashing: face with the smallest -ln(U)/weight wins,
+  // which happens with probability proportional to the weight of the face
+  std::vector<Candidate> candidates;
+  BOOST_FOREACH (const fib::FaceMetric &metricFace, pitEntry->GetFibEntry ()->m_faces.get<fib::i_metric> ())
+    {
+      if (metricFace.GetStatus () == fib::FaceMetric::NDN_FIB_RED) // all non-red faces are in front
+        break;
+
+      double score = -log (GetUniform (flowHash, m_nodeId, metricFace.GetFace ()->GetId ())) / GetWeight (metricFace);
+      candidates.push_back (Candidate (score, metricFace.GetFace ()));
+    }
+  std::sort (candidates.begin (), candidates.end (), CandidateLess ());
+
+  int propagatedCount = 0;
+
+  // if the selected face cannot be used (e.g., limit is reached), the next one in the flow's order is tried
+  BOOST_FOREACH (const Candidate &candidate, candidates)
+    {
+      NS_LOG_DEBUG ("Trying " << boost::cref (*candidate.second) << " with score " << candidate.first);
+      if (!TrySendOutInterest (inFace, candidate.second, header, origPacket, pitEntry))
+        {
+          continue;
+        }
+
+      propagatedCount++;
+      break; // do only once
+    }
+
+  NS_LOG_INFO ("Propagated to " << propagatedCount << " faces");
+  return propagatedCount > 0;
+}
+
+} // namespace fw
+} // namespace ndn
+} // namespace ns3
@@ -0,0 +1,110 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2011 University of California, Los Angeles
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ * Author: Alexander Afanasyev <alexander.afanasyev@ucla.edu>
+ */
+
+
+#ifndef NDNSIM_WEIGHTED_MULTIPATH_H
+#define NDNSIM_WEIGHTED_MULTIPATH_H
+
+#include "satisfaction-ratio.h"
+#include "ns3/log.h"
+
+namespace ns3 {
+namespace ndn {
+
+class Name;
+
+namespace fib {
+class FaceMetric;
+}
+
+namespace fw {
+
+/**
+ * \ingroup ndn
+ * \brief Strategy distributing Interests between all non-RED faces in proportion to their weights
+ *
+ * Weight of the face is the maximum rate of the face (if Limits are aggregated to the face, e.g.,
+ * when strategy is used with PerOutFaceLimits, otherwise all faces have equal capacity), multiplied
+ * by the fraction of Interests recently satisfied via the face.  Timeouts and NACKs immediately
+ * reduce the weight, shifting the load to other faces.
+ *
+ * Face for the Interest is selected using weighted rendezvous hashing of the flow (first
+ * FlowPrefixLength components of the Interest name) and the face: each face gets a share of flows
+ * proportional to its weight, Interests of the same flow stick to the same face, and when a weight
+ * changes only a proportional part of the flows moves to another face.
+ */
+class WeightedMultipath :
+    public SatisfactionRatio
+{
+private:
+  typedef SatisfactionRatio super;
+
+public:
+  static TypeId
+  GetTypeId ();
+
+  /**
+   * @brief Helper function to retrieve logging name for the forwarding strategy
+   */
+  static std::string
+  GetLogName ();
+
+  /**
+   * @brief Default constructor
+   */
+  WeightedMultipath ();
+
+  // from super
+  virtual bool
+  DoPropagateInterest (Ptr<Face> incomingFace,
+                       Ptr<const Interest> header,
+                       Ptr<const Packet> origPacket,
+                       Ptr<pit::Entry> pitEntry);
+
+protected:
+  virtual void
+  NotifyNewAggregate ();
+
+  /**
+   * @brief Get weight of the face (always positive)
+   */
+  double
+  GetWeight (const fib::FaceMetric &metricFace) const;
+
+  /**
+   * @brief Get hash of the flow, to which Interest belongs
+   */
+  uint64_t
+  GetFlowHash (const Name &name) const;
+
+protected:
+  static LogComponent g_log;
+
+private:
+  uint32_t m_flowPrefixLength;   ///< \brief Number of name components identifying the flow (0 means the whole name)
+  double m_minSatisfactionRatio; ///< \brief Lower bound of the satisfaction ratio used in the weight
+  uint32_t m_nodeId;             ///< \brief ID of the node, mixed into the hash so nodes split flows independently
+};
+
+} // namespace fw
+} // namespace ndn
+} // namespace ns3
+
+#endif // NDNSIM_WEIGHTED_MULTIPATH_H
@@ -102,6 +102,7 @@ AppFace::SendImpl (Ptr<Packet> p)
       switch (type)
         {
         case HeaderHelper::INTEREST_NDNSIM:
+        case HeaderHelper::INTEREST_TLV:
           {
             Ptr<Interest> header = Create<Interest> ();
             p->RemoveHeader (*header);
@@ -114,6 +115,7 @@ AppFace::SendImpl (Ptr<Packet> p)
             break;
           }
         case HeaderHelper::CONTENT_OBJECT_NDNSIM:
+        case HeaderHelper::CONTENT_OBJECT_TLV:
           {
             static ContentObjectTail tail;
             Ptr<ContentObject> header = Create<ContentObject> ();
@@ -137,6 +139,54 @@ AppFace::SendImpl (Ptr<Packet> p)
     }
 }
 
+bool
+AppFace::SendInterestImpl (Ptr<const Interest> header, Ptr<Packet> p)
+{
+  NS_LOG_FUNCTION (this << p);
+
+  // header has been parsed by the forwarder already, just skip its serialized form
+  p->RemoveAtStart (header->GetSerializedSize ());
+
+  if (header->GetHopCount () >= 0)
+    {
+      // Face has incremented hop count only in the serialized header
+      Ptr<Interest> delivered = Create<Interest> (*header);
+      delivered->SetHopCount (header->GetHopCount () + 1);
+      header = delivered;
+    }
+
+  if (header->GetNack () > 0)
+    m_app->OnNack (header, p);
+  else
+    m_app->OnInterest (header, p);
+
+  return true;
+}
+
+bool
+AppFace::SendDataImpl (Ptr<const ContentObject> header, Ptr<Packet> p)
+{
+  NS_LOG_FUNCTION (this << p);
+
+  static ContentObjectTail tail;
+
+  // header has been parsed by the forwarder already, just skip its serialized form
+  p->RemoveAtStart (header->GetSerializedSize ());
+  p->RemoveAtEnd (tail.GetSerializedSize ());
+
+  if (header->GetHopCount () >= 0)
+    {
+      // Face has incremented hop count only in the serialized header
+      Ptr<ContentObject> delivered = Create<ContentObject> (*header);
+      delivered->SetHopCount (header->GetHopCount () + 1);
+      header = delivered;
+    }
+
+  m_app->OnContentObject (header, p/*payload*/);
+
+  return true;
+}
+
 std::ostream&
 AppFace::Print (std::ostream& os) const
 {
@@ -70,6 +70,18 @@ protected:
   virtual bool
   SendImpl (Ptr<Packet> p);
 
+  /**
+   * \brief Deliver Interest to the application, reusing already parsed header
+   */
+  virtual bool
+  SendInterestImpl (Ptr<const Interest> header, Ptr<Packet> p);
+
+  /**
+   * \brief Deliver Data to the application, reusing already parsed header
+   */
+  virtual bool
+  SendDataImpl (Ptr<const ContentObject> header, Ptr<Packet> p);
+
 public:
   virtual std::ostream&
   Print (std::ostream &os) const;
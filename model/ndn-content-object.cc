@@ -20,8 +20,10 @@
  */
 
 #include "ndn-content-object.h"
+#include "ndn-tlv.h"
 
 #include "ns3/log.h"
+#include "ns3/ndn-header-helper.h"
 
 #include <boost/foreach.hpp>
 
@@ -48,6 +50,8 @@ ContentObject::GetTypeId (void)
 
 ContentObject::ContentObject ()
   : m_signature (0)
+  , m_hopCount (-1)
+  , m_serializedSize (0)
 {
   memset(m_hash, 0, HASH_SIZE + 1);
 }
@@ -56,12 +60,14 @@ void
 ContentObject::SetName (Ptr<Name> name)
 {
   m_name = name;
+  m_serializedSize = 0;
 }
 
 void
 ContentObject::SetName (const Name &name)
 {
   m_name = Create<Name> (name);
+  m_serializedSize = 0;
 }
 
 const Name&
@@ -82,6 +88,7 @@ void
 ContentObject::SetTimestamp (const Time &timestamp)
 {
   m_timestamp = timestamp;
+  m_serializedSize = 0;
 }
 
 Time
@@ -94,6 +101,7 @@ void
 ContentObject::SetFreshness (const Time &freshness)
 {
   m_freshness = freshness;
+  m_serializedSize = 0;
 }
 
 Time
@@ -106,6 +114,7 @@ void
 ContentObject::SetSignature (uint32_t signature)
 {
   m_signature = signature;
+  m_serializedSize = 0;
 }
 
 uint32_t
@@ -181,6 +190,7 @@ ContentObject::SetHash (std::string hash)
       m_hash[i] = hash[i];
     }
   m_hash[HASH_SIZE] = '\0';  
+  m_serializedSize = 0;
 }
 
 std::string
@@ -189,22 +199,60 @@ ContentObject::GetHash () const
   return std::string(m_hash, HASH_SIZE);
 }
 
+void
+ContentObject::SetHopCount (int32_t hopCount)
+{
+  if ((m_hopCount < 0) != (hopCount < 0)) // value has fixed size, so only presence matters
+    m_serializedSize = 0;
+  m_hopCount = hopCount;
+}
+
+int32_t
+ContentObject::GetHopCount () const
+{
+  return m_hopCount;
+}
+
 uint32_t
 ContentObject::GetSerializedSize () const
 {
-  uint32_t size = 2 + ((2 + 2) + (m_name->GetSerializedSize ()) + (2 + 2 + 4 + 2 + 2 + (2 + 0))) + HASH_SIZE;
-  if (m_signature != 0)
-    size += 4;
-  
-  NS_LOG_INFO ("Serialize size = " << size);
-  return size;
+  if (m_serializedSize != 0)
+    return m_serializedSize;
+
+  if (HeaderHelper::GetWireFormat () == HeaderHelper::WIRE_FORMAT_TLV)
+    {
+      m_serializedSize = tlv::SizeOfBlock (tlv::DATA, GetTlvValueSize ());
+    }
+  else
+    {
+      m_serializedSize = 2 + ((2 + 2) + (m_name->GetSerializedSize ()) + (2 + 2 + 4 + 2 + 2 + (2 + 0))) + HASH_SIZE;
+      if (m_signature != 0)
+        m_serializedSize += 4;
+      if (m_hopCount >= 0)
+        m_serializedSize += 4;
+    }
+
+  NS_LOG_INFO ("Serialize size = " << m_serializedSize);
+  return m_serializedSize;
 }
 
 void
 ContentObject::Serialize (Buffer::Iterator start) const
 {
+  if (HeaderHelper::GetWireFormat () == HeaderHelper::WIRE_FORMAT_TLV)
+    {
+      SerializeTlv (start);
+      return;
+    }
+
   start.WriteU8 (0x80); // version
-  start.WriteU8 (0x01); // packet type
+  if (m_hopCount >= 0)
+    {
+      start.WriteU8 (0x03); // packet type (ContentObject with hop count)
+      start.WriteHtonU32 (static_cast<uint32_t> (m_hopCount)); // fixed offset, see HeaderHelper::IncrementHopCount
+    }
+  else
+    start.WriteU8 (0x01); // packet type
 
   if (m_signature != 0)
     {
@@ -243,10 +291,21 @@ ContentObject::Deserialize (Buffer::Iterator start)
 {
   Buffer::Iterator i = start;
 
-  if (i.ReadU8 () != 0x80)
+  m_serializedSize = 0;
+
+  uint8_t version = i.ReadU8 ();
+  if (version == tlv::DATA)
+    return DeserializeTlv (start);
+
+  if (version != 0x80)
     throw new ContentObjectException ();
 
-  if (i.ReadU8 () != 0x01)
+  uint8_t type = i.ReadU8 ();
+  if (type == 0x03)
+    m_hopCount = static_cast<int32_t> (i.ReadNtohU32 () & 0x7FFFFFFF);
+  else if (type == 0x01)
+    m_hopCount = -1;
+  else
     throw new ContentObjectException ();
 
   uint32_t signatureLength = i.ReadU16 ();
@@ -293,6 +352,125 @@ ContentObject::Deserialize (Buffer::Iterator start)
   
   return i.GetDistanceFrom (start);
 }
+
+uint32_t
+ContentObject::GetTlvMetaInfoSize () const
+{
+  uint32_t size = 0;
+  if (m_freshness.ToInteger (Time::MS) > 0)
+    size += tlv::SizeOfBlock (tlv::FRESHNESS_PERIOD, tlv::SizeOfNonNegativeInteger (m_freshness.ToInteger (Time::MS)));
+
+  size += tlv::SizeOfBlock (tlv::TIMESTAMP, tlv::SizeOfNonNegativeInteger (m_timestamp.ToInteger (Time::MS)));
+  return size;
+}
+
+uint32_t
+ContentObject::GetTlvValueSize () const
+{
+  uint32_t size = tlv::SizeOfName (*m_name);
+  if (m_hopCount >= 0)
+    size += tlv::SizeOfBlock (tlv::HOP_COUNT, 4);
+  size += tlv::SizeOfBlock (tlv::META_INFO, GetTlvMetaInfoSize ());
+
+  if (m_signature != 0)
+    size += tlv::SizeOfBlock (tlv::SIGNATURE_VALUE, tlv::SizeOfNonNegativeInteger (m_signature));
+
+  size += tlv::SizeOfHash (tlv::CONTENT_HASH, m_hash);
+
+  return size;
+}
+
+void
+ContentObject::SerializeTlv (Buffer::Iterator start) const
+{
+  tlv::WriteBlockHeader (start, tlv::DATA, GetTlvValueSize ());
+
+  // hop count goes first, so HeaderHelper::IncrementHopCount finds it at a fixed offset
+  if (m_hopCount >= 0)
+    {
+      tlv::WriteBlockHeader (start, tlv::HOP_COUNT, 4);
+      start.WriteHtonU32 (static_cast<uint32_t> (m_hopCount));
+    }
+
+  tlv::WriteName (start, *m_name);
+
+  tlv::WriteBlockHeader (start, tlv::META_INFO, GetTlvMetaInfoSize ());
+  if (m_freshness.ToInteger (Time::MS) > 0)
+    tlv::WriteNonNegativeInteger (start, tlv::FRESHNESS_PERIOD, m_freshness.ToInteger (Time::MS));
+  tlv::WriteNonNegativeInteger (start, tlv::TIMESTAMP, m_timestamp.ToInteger (Time::MS));
+
+  if (m_signature != 0)
+    tlv::WriteNonNegativeInteger (start, tlv::SIGNATURE_VALUE, m_signature);
+
+  tlv::WriteHash (start, tlv::CONTENT_HASH, m_hash);
+}
+
+uint32_t
+ContentObject::DeserializeTlv (Buffer::Iterator start)
+{
+  Buffer::Iterator i = start;
+
+  if (tlv::ReadVarNumber (i) != tlv::DATA)
+    throw new ContentObjectException ();
+
+  uint64_t length = tlv::ReadVarNumber (i);
+  Buffer::Iterator value = i;
+
+  m_name = 0;
+  m_freshness = Seconds (0);
+  m_timestamp = Seconds (0);
+  m_signature = 0;
+  memset (m_hash, 0, HASH_SIZE + 1);
+  m_hopCount = -1;
+
+  while (i.GetDistanceFrom (value) < length)
+    {
+      uint64_t type = tlv::ReadVarNumber (i);
+      uint64_t blockLength = tlv::ReadVarNumber (i);
+
+      switch (type)
+        {
+        case tlv::NAME:
+          m_name = tlv::ReadName (i, blockLength);
+          break;
+        case tlv::META_INFO:
+          {
+            Buffer::Iterator metaInfo = i;
+            while (i.GetDistanceFrom (metaInfo) < blockLength)
+              {
+                uint64_t infoType = tlv::ReadVarNumber (i);
+                uint64_t infoLength = tlv::ReadVarNumber (i);
+                if (infoType == tlv::FRESHNESS_PERIOD)
+                  m_freshness = MilliSeconds (tlv::ReadNonNegativeInteger (i, infoLength));
+                else if (infoType == tlv::TIMESTAMP)
+                  m_timestamp = MilliSeconds (tlv::ReadNonNegativeInteger (i, infoLength));
+                else
+                  i.Next (infoLength);
+              }
+            break;
+          }
+        case tlv::SIGNATURE_VALUE:
+          m_signature = static_cast<uint32_t> (tlv::ReadNonNegativeInteger (i, blockLength));
+          break;
+        case tlv::CONTENT_HASH:
+          tlv::ReadHash (i, blockLength, m_hash);
+          break;
+        case tlv::HOP_COUNT:
+          if (blockLength != 4)
+            throw new ContentObjectException ();
+          m_hopCount = static_cast<int32_t> (i.ReadNtohU32 () & 0x7FFFFFFF);
+          break;
+        default:
+          i.Next (blockLength); // unknown elements are ignored
+          break;
+        }
+    }
+
+  if (m_name == 0 || i.GetDistanceFrom (value) != length)
+    throw new ContentObjectException ();
+
+  return i.GetDistanceFrom (start);
+}
   
 TypeId
 ContentObject::GetInstanceTypeId (void) const
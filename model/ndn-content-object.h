@@ -36,6 +36,8 @@
 
 #include "ndn-name.h"
 
+#include "ns3/ndnSIM/utils/ndn-object-pool.h"
+
 namespace ns3 {
 namespace ndn {
 
@@ -82,6 +84,8 @@ namespace ndn {
 class ContentObject : public SimpleRefCount<ContentObject,Header>
 {
 public:
+  NDN_OBJECT_POOL (ContentObject, 1024)
+
   /**
    * Constructor
    *
@@ -169,21 +173,47 @@ public:
   std::string
   GetHash () const;
 
+  /**
+   * @brief Set hop count, carried in the header
+   *
+   * When set, Face increments the hop count in place on each send (see HeaderHelper::IncrementHopCount),
+   * so FwHopCountTag is not needed.  Negative value (default) means that the content object does not carry hop count.
+   *
+   * @param hopCount number of hops (negative to remove hop count from the header)
+   */
+  void
+  SetHopCount (int32_t hopCount);
+
+  /**
+   * @brief Get hop count carried in the header (negative if not present)
+   */
+  int32_t
+  GetHopCount () const;
+
   //////////////////////////////////////////////////////////////////
 
   static TypeId GetTypeId (void); ///< @brief Get TypeId
   virtual TypeId GetInstanceTypeId (void) const; ///< @brief Get TypeId of the instance
   virtual void Print (std::ostream &os) const; ///< @brief Print out information about the Header into the stream
-  virtual uint32_t GetSerializedSize (void) const; ///< @brief Get size necessary to serialize the Header
+  virtual uint32_t GetSerializedSize (void) const; ///< @brief Get size necessary to serialize the Header (cached until any of the fields is changed)
   virtual void Serialize (Buffer::Iterator start) const; ///< @brief Serialize the Header
   virtual uint32_t Deserialize (Buffer::Iterator start); ///< @brief Deserialize the Header
 
+private:
+  uint32_t GetTlvMetaInfoSize () const; ///< @brief Get size of the value of MetaInfo TLV block
+  uint32_t GetTlvValueSize () const; ///< @brief Get size of the value of Data TLV block
+  void SerializeTlv (Buffer::Iterator start) const; ///< @brief Serialize the Header in TLV wire format
+  uint32_t DeserializeTlv (Buffer::Iterator start); ///< @brief Deserialize the Header from TLV wire format
+
 private:
   Ptr<Name> m_name;
   Time m_freshness;
   Time m_timestamp;
   uint32_t m_signature; // 0, means no signature, any other value application dependent (not a real signature)
   char m_hash[HASH_SIZE + 1];
+  int32_t m_hopCount; ///< @brief Hop count (negative if not present)
+
+  mutable uint32_t m_serializedSize; ///< @brief Cached serialized size (0 if needs to be recalculated)
 };
 
 typedef ContentObject ContentObjectHeader;
@@ -11,6 +11,8 @@
 #include "ns3/attribute.h"
 #include "ns3/attribute-helper.h"
 
+#include "ns3/ndnSIM/utils/ndn-object-pool.h"
+
 #include <string>
 #include <vector>
 
@@ -20,6 +22,8 @@ namespace ns3 {
     class Exclusion : public SimpleRefCount<Exclusion>
     {
     public:
+      NDN_OBJECT_POOL (Exclusion, 256)
+
       Exclusion();
 
       size_t GetSerializedSize() const;
@@ -32,6 +32,10 @@
 #include "ns3/random-variable.h"
 #include "ns3/pointer.h"
 
+#include "ns3/ndn-interest.h"
+#include "ns3/ndn-content-object.h"
+#include "ns3/ndn-header-helper.h"
+
 #include "ns3/ndnSIM/utils/ndn-fw-hop-count-tag.h"
 
 #include <boost/ref.hpp>
@@ -110,18 +114,118 @@ Face::RegisterProtocolHandler (ProtocolHandler handler)
   m_protocolHandler = handler;
 }
 
+void
+Face::RegisterParsedPacketHandlers (InterestHandler interestHandler, DataHandler dataHandler)
+{
+  NS_LOG_FUNCTION_NOARGS ();
+
+  m_interestHandler = interestHandler;
+  m_dataHandler = dataHandler;
+}
+
 bool
 Face::Send (Ptr<Packet> packet)
 {
   NS_LOG_FUNCTION (boost::cref (*this) << packet << packet->GetSize ());
   NS_LOG_DEBUG (*packet);
 
+  if (!PrepareToSend (packet))
+    return false;
+
+  return TraceSend (packet, SendImpl (packet));
+}
+
+bool
+Face::SendInterest (Ptr<const Interest> header, Ptr<Packet> packet)
+{
+  NS_LOG_FUNCTION (boost::cref (*this) << packet << packet->GetSize ());
+
+  if (!PrepareToSend (packet))
+    return false;
+
+  return TraceSend (packet, SendInterestImpl (header, packet));
+}
+
+bool
+Face::SendData (Ptr<const ContentObject> header, Ptr<Packet> packet)
+{
+  NS_LOG_FUNCTION (boost::cref (*this) << packet << packet->GetSize ());
+
+  if (!PrepareToSend (packet))
+    return false;
+
+  return TraceSend (packet, SendDataImpl (header, packet));
+}
+
+Ptr<Packet>
+Face::PrepareMulticast (Ptr<const Packet> packet)
+{
+  Ptr<Packet> prepared = packet->Copy ();
+  IncrementHopCount (prepared);
+  return prepared;
+}
+
+bool
+Face::SendMulticastInterest (Ptr<const Interest> header, Ptr<const Packet> prepared)
+{
+  NS_LOG_FUNCTION (boost::cref (*this) << prepared << prepared->GetSize ());
+
+  Ptr<Packet> packet = prepared->Copy (); // shares buffer and tags with the prepared packet
+  if (!IsUp ())
+    {
+      m_dropTrace (packet);
+      return false;
+    }
+
+  return TraceSend (packet, SendInterestImpl (header, packet));
+}
+
+bool
+Face::SendMulticastData (Ptr<const ContentObject> header, Ptr<const Packet> prepared)
+{
+  NS_LOG_FUNCTION (boost::cref (*this) << prepared << prepared->GetSize ());
+
+  Ptr<Packet> packet = prepared->Copy (); // shares buffer and tags with the prepared packet
+  if (!IsUp ())
+    {
+      m_dropTrace (packet);
+      return false;
+    }
+
+  return TraceSend (packet, SendDataImpl (header, packet));
+}
+
+bool
+Face::SendInterestImpl (Ptr<const Interest> header, Ptr<Packet> packet)
+{
+  return SendImpl (packet);
+}
+
+bool
+Face::SendDataImpl (Ptr<const ContentObject> header, Ptr<Packet> packet)
+{
+  return SendImpl (packet);
+}
+
+bool
+Face::PrepareToSend (Ptr<Packet> packet)
+{
   if (!IsUp ())
     {
       m_dropTrace (packet);
       return false;
     }
 
+  IncrementHopCount (packet);
+  return true;
+}
+
+void
+Face::IncrementHopCount (Ptr<Packet> packet)
+{
+  if (HeaderHelper::IncrementHopCount (packet))
+    return;
+
   FwHopCountTag hopCount;
   bool tagExists = packet->RemovePacketTag (hopCount);
   if (tagExists)
@@ -129,8 +233,11 @@ Face::Send (Ptr<Packet> packet)
       hopCount.Increment ();
       packet->AddPacketTag (hopCount);
     }
+}
 
-  bool ok = SendImpl (packet);
+bool
+Face::TraceSend (Ptr<Packet> packet, bool ok)
+{
   if (ok)
     {
       m_txTrace (packet);
@@ -160,6 +267,44 @@ Face::Receive (const Ptr<const Packet> &packet)
   return true;
 }
 
+bool
+Face::ReceiveInterest (Ptr<Interest> header, const Ptr<const Packet> &packet)
+{
+  NS_LOG_FUNCTION (boost::cref (*this) << packet << packet->GetSize ());
+
+  if (m_interestHandler.IsNull ())
+    return Receive (packet);
+
+  if (!IsUp ())
+    {
+      return false;
+    }
+
+  m_rxTrace (packet);
+  m_interestHandler (this, header, packet);
+
+  return true;
+}
+
+bool
+Face::ReceiveData (Ptr<ContentObject> header, Ptr<Packet> payload, const Ptr<const Packet> &packet)
+{
+  NS_LOG_FUNCTION (boost::cref (*this) << packet << packet->GetSize ());
+
+  if (m_dataHandler.IsNull ())
+    return Receive (packet);
+
+  if (!IsUp ())
+    {
+      return false;
+    }
+
+  m_rxTrace (packet);
+  m_dataHandler (this, header, payload, packet);
+
+  return true;
+}
+
 void
 Face::SetMetric (uint16_t metric)
 {
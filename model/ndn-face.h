@@ -38,6 +38,9 @@ class Node;
 
 namespace ndn {
 
+class Interest;
+class ContentObject;
+
 /**
  * \ingroup ndn
  * \defgroup ndn-face Faces
@@ -67,6 +70,25 @@ public:
    */
   typedef Callback<void,const Ptr<Face>&,const Ptr<const Packet>& > ProtocolHandler;
 
+  /**
+   * \brief NDN protocol handler for Interests, which header has already been parsed
+   *
+   * \param face Face from which packet has been received
+   * \param header Interest header
+   * \param packet Original packet
+   */
+  typedef Callback<void,const Ptr<Face>&,Ptr<Interest>,const Ptr<const Packet>& > InterestHandler;
+
+  /**
+   * \brief NDN protocol handler for Data packets, which header has already been parsed
+   *
+   * \param face Face from which packet has been received
+   * \param header ContentObject header
+   * \param payload Payload of the packet
+   * \param packet Original packet
+   */
+  typedef Callback<void,const Ptr<Face>&,Ptr<ContentObject>,Ptr<Packet>,const Ptr<const Packet>& > DataHandler;
+
   /**
    * \brief Default constructor
    */
@@ -89,6 +111,14 @@ public:
   virtual void
   RegisterProtocolHandler (ProtocolHandler handler);
 
+  /**
+   * \brief Register callbacks to call when packet with already parsed header arrives on the face
+   *
+   * If callbacks are not registered, such packets are passed to the handler registered with RegisterProtocolHandler
+   */
+  void
+  RegisterParsedPacketHandlers (InterestHandler interestHandler, DataHandler dataHandler);
+
   /**
    * \brief Send packet on a face
    *
@@ -101,6 +131,75 @@ public:
   bool
   Send (Ptr<Packet> p);
 
+  /**
+   * \brief Send Interest packet on a face
+   *
+   * Same as Send, but the already parsed header is passed along with the packet, so faces that
+   * deliver packets locally (e.g., AppFace) do not need to parse the packet again.  Hop count is
+   * incremented only in the packet, so the header keeps the value that was received
+   *
+   * \param header Interest header
+   * \param p smart pointer to the packet to send (including serialized header)
+   *
+   * @return false if either limit is reached
+   */
+  bool
+  SendInterest (Ptr<const Interest> header, Ptr<Packet> p);
+
+  /**
+   * \brief Send Data packet on a face
+   *
+   * Same as Send, but the already parsed header is passed along with the packet, so faces that
+   * deliver packets locally (e.g., AppFace) do not need to parse the packet again.  Hop count is
+   * incremented only in the packet, so the header keeps the value that was received
+   *
+   * \param header ContentObject header
+   * \param p smart pointer to the packet to send (including serialized header and trailer)
+   *
+   * @return false if either limit is reached
+   */
+  bool
+  SendData (Ptr<const ContentObject> header, Ptr<Packet> p);
+
+  /**
+   * \brief Prepare packet to be sent on multiple faces using SendMulticastInterest or SendMulticastData
+   *
+   * Hop count of the packet is incremented only once here, instead of doing it for every outgoing face
+   *
+   * \param packet original packet
+   * \returns copy of the packet with updated hop count, which should not be modified afterwards
+   */
+  static Ptr<Packet>
+  PrepareMulticast (Ptr<const Packet> packet);
+
+  /**
+   * \brief Send Interest packet, prepared with PrepareMulticast, on a face
+   *
+   * The face gets a lightweight copy of the prepared packet that shares the buffer and tags with
+   * all other copies, and is free to modify this copy
+   *
+   * \param header Interest header
+   * \param prepared packet returned by PrepareMulticast
+   *
+   * @return false if either limit is reached
+   */
+  bool
+  SendMulticastInterest (Ptr<const Interest> header, Ptr<const Packet> prepared);
+
+  /**
+   * \brief Send Data packet, prepared with PrepareMulticast, on a face
+   *
+   * The face gets a lightweight copy of the prepared packet that shares the buffer and tags with
+   * all other copies, and is free to modify this copy
+   *
+   * \param header ContentObject header
+   * \param prepared packet returned by PrepareMulticast
+   *
+   * @return false if either limit is reached
+   */
+  bool
+  SendMulticastData (Ptr<const ContentObject> header, Ptr<const Packet> prepared);
+
   /**
    * \brief Receive packet from application or another node and forward it to the Ndn stack
    *
@@ -108,6 +207,25 @@ public:
    */
   bool
   Receive (const Ptr<const Packet> &p);
+
+  /**
+   * \brief Receive Interest, which header has already been parsed (e.g., by application), and forward it to the Ndn stack
+   *
+   * \param header Interest header (should not be modified afterwards)
+   * \param p Original packet (including serialized header)
+   */
+  bool
+  ReceiveInterest (Ptr<Interest> header, const Ptr<const Packet> &p);
+
+  /**
+   * \brief Receive Data, which header has already been parsed (e.g., by application), and forward it to the Ndn stack
+   *
+   * \param header ContentObject header (should not be modified afterwards)
+   * \param payload Payload of the packet (with the same packet tags as the original packet)
+   * \param p Original packet (including serialized header and trailer)
+   */
+  bool
+  ReceiveData (Ptr<ContentObject> header, Ptr<Packet> payload, const Ptr<const Packet> &p);
   ////////////////////////////////////////////////////////////////////
 
   /**
@@ -202,15 +320,61 @@ protected:
   virtual bool
   SendImpl (Ptr<Packet> p) = 0;  
 
+  /**
+   * \brief Send Interest packet on a face (actual implementation)
+   *
+   * Default implementation calls SendImpl
+   *
+   * \param header Interest header
+   * \param p smart pointer to the packet to send (including serialized header)
+   */
+  virtual bool
+  SendInterestImpl (Ptr<const Interest> header, Ptr<Packet> p);
+
+  /**
+   * \brief Send Data packet on a face (actual implementation)
+   *
+   * Default implementation calls SendImpl
+   *
+   * \param header ContentObject header
+   * \param p smart pointer to the packet to send (including serialized header and trailer)
+   */
+  virtual bool
+  SendDataImpl (Ptr<const ContentObject> header, Ptr<Packet> p);
+
 private:
   Face (const Face &); ///< \brief Disabled copy constructor
   Face& operator= (const Face &); ///< \brief Disabled copy operator
+
+  /**
+   * \brief Common part of all send calls before the packet is passed to the implementation
+   * \returns false if packet cannot be sent
+   */
+  bool
+  PrepareToSend (Ptr<Packet> packet);
+
+  /**
+   * \brief Trace result of the send call
+   */
+  bool
+  TraceSend (Ptr<Packet> packet, bool ok);
+
+  /**
+   * \brief Increment hop count of the packet, carried either in the header or in FwHopCountTag
+   *
+   * Hop count in the header is overwritten in place (see HeaderHelper::IncrementHopCount).
+   * Packet tags cannot be modified in place, so the tag is removed and added back
+   */
+  static void
+  IncrementHopCount (Ptr<Packet> packet);
   
 protected:
   Ptr<Node> m_node; ///< \brief Smart pointer to Node
   
 private:
   ProtocolHandler m_protocolHandler; ///< Callback via which packets are getting send to Ndn stack
+  InterestHandler m_interestHandler; ///< Callback via which Interests with parsed headers are getting send to Ndn stack
+  DataHandler m_dataHandler;         ///< Callback via which Data packets with parsed headers are getting send to Ndn stack
   bool m_ifup; ///< \brief flag indicating that the interface is UP 
   uint32_t m_id; ///< \brief id of the interface in NDN stack (per-node uniqueness)
   uint32_t m_metric; ///< \brief metric of the face
@@ -19,10 +19,12 @@
  */
 
 #include "ndn-interest.h"
+#include "ndn-tlv.h"
 
 #include "ns3/log.h"
 #include "ns3/unused.h"
 #include "ns3/packet.h"
+#include "ns3/ndn-header-helper.h"
 
 NS_LOG_COMPONENT_DEFINE ("ndn.Interest");
 
@@ -31,6 +33,23 @@ namespace ndn {
 
 NS_OBJECT_ENSURE_REGISTERED (Interest);
 
+namespace {
+
+/**
+ * @brief Get empty exclusion filter, shared by all Interests that do not exclude anything
+ *
+ * Exclusion object is large (space for MAX_EXCLUSIONS hashes), so a separate object is allocated
+ * only when exclusions are added to the Interest
+ */
+Ptr<Exclusion>
+GetEmptyExclusion ()
+{
+  static Ptr<Exclusion> emptyExclusion = Create<Exclusion> ();
+  return emptyExclusion;
+}
+
+} // namespace
+
 TypeId
 Interest::GetTypeId (void)
 {
@@ -49,25 +68,27 @@ Interest::Interest ()
   , m_interestLifetime (Seconds (0))
   , m_nonce (0)
   , m_nackType (NORMAL_INTEREST)
+  , m_hopCount (-1)
   , m_exclusionNum (0)
+  , m_exclusion (GetEmptyExclusion ())
+  , m_serializedSize (0)
 {
-  m_exclusion = Create<Exclusion> ();
 }
 
 Interest::Interest (const Interest &interest)
-  : m_name                (Create<Name> (interest.GetName ()))
+  : m_name                (interest.m_name) // name is not modified after it is set to Interest
   , m_scope               (interest.m_scope)
   , m_interestLifetime    (interest.m_interestLifetime)
   , m_nonce               (interest.m_nonce)
   , m_nackType            (interest.m_nackType)
+  , m_hopCount            (interest.m_hopCount)
   , m_exclusionNum        (interest.m_exclusionNum)
+  , m_exclusion           (GetEmptyExclusion ())
+  , m_serializedSize      (interest.m_serializedSize)
 {
-  m_exclusion = Create<Exclusion> ();
-  // std::vector<std::string> hash_list = interest.GetExclusion().GetHashList();
-  // for (uint i = 0; i < hash_list.size(); i++)
-  //   {
-  //     m_exclusion->Add(hash_list.at(i));
-  //   }
+  // copy is re-encoded by Face when hop count is incremented, so exclusions should be preserved
+  if (interest.m_exclusion != GetEmptyExclusion ())
+    m_exclusion = Create<Exclusion> (*interest.m_exclusion);
 }
 
 Ptr<Interest>
@@ -83,12 +104,14 @@ void
 Interest::SetName (Ptr<Name> name)
 {
   m_name = name;
+  m_serializedSize = 0;
 }
 
 void
 Interest::SetName (const Name &name)
 {
   m_name = Create<Name> (name);
+  m_serializedSize = 0;
 }
 
 const Name&
@@ -108,6 +131,7 @@ void
 Interest::SetScope (int8_t scope)
 {
   m_scope = scope;
+  m_serializedSize = 0;
 }
 
 int8_t
@@ -120,6 +144,7 @@ void
 Interest::SetInterestLifetime (Time lifetime)
 {
   m_interestLifetime = lifetime;
+  m_serializedSize = 0;
 }
 
 Time
@@ -132,6 +157,7 @@ void
 Interest::SetNonce (uint32_t nonce)
 {
   m_nonce = nonce;
+  m_serializedSize = 0;
 }
 
 uint32_t
@@ -144,6 +170,7 @@ void
 Interest::SetNack (uint8_t nackType)
 {
   m_nackType = nackType;
+  m_serializedSize = 0;
 }
 
 uint8_t
@@ -152,10 +179,28 @@ Interest::GetNack () const
   return m_nackType;
 }
 
+void
+Interest::SetHopCount (int32_t hopCount)
+{
+  if ((m_hopCount < 0) != (hopCount < 0)) // value has fixed size, so only presence matters
+    m_serializedSize = 0;
+  m_hopCount = hopCount;
+}
+
+int32_t
+Interest::GetHopCount () const
+{
+  return m_hopCount;
+}
+
 void
 Interest::AddExclusion (char* hash)
 {
+  if (m_exclusion == GetEmptyExclusion ())
+    m_exclusion = Create<Exclusion> ();
+
   m_exclusion->Add(hash);
+  m_serializedSize = 0;
 }
 
 const Exclusion&
@@ -174,17 +219,35 @@ Interest::GetExclusionPtr () const
 uint32_t
 Interest::GetSerializedSize (void) const
 {
-  size_t size = 2 + (1 + 4 + 2 + 1 + (m_name->GetSerializedSize ()) + (2 + 0) + (2 + 0) + m_exclusion->GetSerializedSize ());
-  NS_LOG_INFO ("Serialize size = " << size);
+  if (m_serializedSize != 0)
+    return m_serializedSize;
 
-  return size;
+  if (HeaderHelper::GetWireFormat () == HeaderHelper::WIRE_FORMAT_TLV)
+    m_serializedSize = tlv::SizeOfBlock (tlv::INTEREST, GetTlvValueSize ());
+  else
+    m_serializedSize = 2 + (m_hopCount >= 0 ? 4 : 0) + (1 + 4 + 2 + 1 + (m_name->GetSerializedSize ()) + (2 + 0) + (2 + 0) + m_exclusion->GetSerializedSize ());
+  NS_LOG_INFO ("Serialize size = " << m_serializedSize);
+
+  return m_serializedSize;
 }
     
 void
 Interest::Serialize (Buffer::Iterator start) const
 {
+  if (HeaderHelper::GetWireFormat () == HeaderHelper::WIRE_FORMAT_TLV)
+    {
+      SerializeTlv (start);
+      return;
+    }
+
   start.WriteU8 (0x80); // version
-  start.WriteU8 (0x00); // packet type
+  if (m_hopCount >= 0)
+    {
+      start.WriteU8 (0x02); // packet type (Interest with hop count)
+      start.WriteHtonU32 (static_cast<uint32_t> (m_hopCount)); // fixed offset, see HeaderHelper::IncrementHopCount
+    }
+  else
+    start.WriteU8 (0x00); // packet type
 
   start.WriteU32 (m_nonce);
   start.WriteU8 (m_scope);
@@ -210,11 +273,22 @@ uint32_t
 Interest::Deserialize (Buffer::Iterator start)
 {
   Buffer::Iterator i = start;
-  
-  if (i.ReadU8 () != 0x80)
+
+  m_serializedSize = 0;
+
+  uint8_t version = i.ReadU8 ();
+  if (version == tlv::INTEREST)
+    return DeserializeTlv (start);
+
+  if (version != 0x80)
     throw new InterestException ();
 
-  if (i.ReadU8 () != 0x00)
+  uint8_t type = i.ReadU8 ();
+  if (type == 0x02)
+    m_hopCount = static_cast<int32_t> (i.ReadNtohU32 () & 0x7FFFFFFF);
+  else if (type == 0x00)
+    m_hopCount = -1;
+  else
     throw new InterestException ();
 
   m_nonce = i.ReadU32 ();
@@ -230,14 +304,192 @@ Interest::Deserialize (Buffer::Iterator start)
   i.ReadU16 ();
   i.ReadU16 ();
 
-  offset = m_exclusion->Deserialize (i);
-  i.Next (offset);
+  Buffer::Iterator exclusionCount = i;
+  if (exclusionCount.ReadU8 () == 0)
+    {
+      // do not allocate a new exclusion filter, if there is nothing to exclude
+      m_exclusion = GetEmptyExclusion ();
+      i.Next (1);
+    }
+  else
+    {
+      m_exclusion = Create<Exclusion> ();
+      offset = m_exclusion->Deserialize (i);
+      i.Next (offset);
+    }
 
   NS_ASSERT (GetSerializedSize () == (i.GetDistanceFrom (start)));
 
   return i.GetDistanceFrom (start);
 }
 
+uint32_t
+Interest::GetTlvExcludeSize () const
+{
+  uint32_t size = 0;
+  for (int item = 0; item < m_exclusion->size (); item++)
+    {
+      size += tlv::SizeOfHash (tlv::CONTENT_HASH, m_exclusion->m_hash[item]);
+    }
+  return size;
+}
+
+uint32_t
+Interest::GetTlvValueSize () const
+{
+  uint32_t size = tlv::SizeOfName (*m_name);
+
+  if (m_hopCount >= 0)
+    size += tlv::SizeOfBlock (tlv::HOP_COUNT, 4);
+
+  if (m_exclusion->size () > 0)
+    size += tlv::SizeOfBlock (tlv::SELECTORS, tlv::SizeOfBlock (tlv::EXCLUDE, GetTlvExcludeSize ()));
+
+  size += tlv::SizeOfBlock (tlv::NONCE, 4);
+
+  if (m_scope != 0xFF)
+    size += tlv::SizeOfBlock (tlv::SCOPE, tlv::SizeOfNonNegativeInteger (m_scope));
+
+  if (m_interestLifetime.ToInteger (Time::MS) > 0)
+    size += tlv::SizeOfBlock (tlv::INTEREST_LIFETIME,
+                              tlv::SizeOfNonNegativeInteger (m_interestLifetime.ToInteger (Time::MS)));
+
+  if (m_nackType != NORMAL_INTEREST)
+    size += tlv::SizeOfBlock (tlv::NACK, tlv::SizeOfNonNegativeInteger (m_nackType));
+
+  return size;
+}
+
+void
+Interest::SerializeTlv (Buffer::Iterator start) const
+{
+  tlv::WriteBlockHeader (start, tlv::INTEREST, GetTlvValueSize ());
+
+  // hop count goes first, so HeaderHelper::IncrementHopCount finds it at a fixed offset
+  if (m_hopCount >= 0)
+    {
+      tlv::WriteBlockHeader (start, tlv::HOP_COUNT, 4);
+      start.WriteHtonU32 (static_cast<uint32_t> (m_hopCount));
+    }
+
+  tlv::WriteName (start, *m_name);
+
+  if (m_exclusion->size () > 0)
+    {
+      uint32_t excludeSize = GetTlvExcludeSize ();
+      tlv::WriteBlockHeader (start, tlv::SELECTORS, tlv::SizeOfBlock (tlv::EXCLUDE, excludeSize));
+      tlv::WriteBlockHeader (start, tlv::EXCLUDE, excludeSize);
+      for (int item = 0; item < m_exclusion->size (); item++)
+        {
+          tlv::WriteHash (start, tlv::CONTENT_HASH, m_exclusion->m_hash[item]);
+        }
+    }
+
+  tlv::WriteBlockHeader (start, tlv::NONCE, 4);
+  start.WriteHtonU32 (m_nonce);
+
+  if (m_scope != 0xFF)
+    tlv::WriteNonNegativeInteger (start, tlv::SCOPE, m_scope);
+
+  if (m_interestLifetime.ToInteger (Time::MS) > 0)
+    tlv::WriteNonNegativeInteger (start, tlv::INTEREST_LIFETIME, m_interestLifetime.ToInteger (Time::MS));
+
+  if (m_nackType != NORMAL_INTEREST)
+    tlv::WriteNonNegativeInteger (start, tlv::NACK, m_nackType);
+
+}
+
+uint32_t
+Interest::DeserializeTlv (Buffer::Iterator start)
+{
+  Buffer::Iterator i = start;
+
+  if (tlv::ReadVarNumber (i) != tlv::INTEREST)
+    throw new InterestException ();
+
+  uint64_t length = tlv::ReadVarNumber (i);
+  Buffer::Iterator value = i;
+
+  m_name = 0;
+  m_scope = 0xFF;
+  m_interestLifetime = Seconds (0);
+  m_nonce = 0;
+  m_nackType = NORMAL_INTEREST;
+  m_hopCount = -1;
+  m_exclusion = GetEmptyExclusion ();
+
+  while (i.GetDistanceFrom (value) < length)
+    {
+      uint64_t type = tlv::ReadVarNumber (i);
+      uint64_t blockLength = tlv::ReadVarNumber (i);
+
+      switch (type)
+        {
+        case tlv::NAME:
+          m_name = tlv::ReadName (i, blockLength);
+          break;
+        case tlv::SELECTORS:
+          {
+            Buffer::Iterator selectors = i;
+            while (i.GetDistanceFrom (selectors) < blockLength)
+              {
+                uint64_t selectorType = tlv::ReadVarNumber (i);
+                uint64_t selectorLength = tlv::ReadVarNumber (i);
+                if (selectorType != tlv::EXCLUDE)
+                  {
+                    i.Next (selectorLength);
+                    continue;
+                  }
+
+                Buffer::Iterator exclude = i;
+                while (i.GetDistanceFrom (exclude) < selectorLength)
+                  {
+                    uint64_t hashType = tlv::ReadVarNumber (i);
+                    uint64_t hashLength = tlv::ReadVarNumber (i);
+                    if (hashType != tlv::CONTENT_HASH)
+                      {
+                        i.Next (hashLength);
+                        continue;
+                      }
+
+                    char hash[HASH_SIZE + 1];
+                    tlv::ReadHash (i, hashLength, hash);
+                    AddExclusion (hash);
+                  }
+              }
+            break;
+          }
+        case tlv::NONCE:
+          if (blockLength != 4)
+            throw new InterestException ();
+          m_nonce = i.ReadNtohU32 ();
+          break;
+        case tlv::SCOPE:
+          m_scope = static_cast<uint8_t> (tlv::ReadNonNegativeInteger (i, blockLength));
+          break;
+        case tlv::INTEREST_LIFETIME:
+          m_interestLifetime = MilliSeconds (tlv::ReadNonNegativeInteger (i, blockLength));
+          break;
+        case tlv::NACK:
+          m_nackType = static_cast<uint8_t> (tlv::ReadNonNegativeInteger (i, blockLength));
+          break;
+        case tlv::HOP_COUNT:
+          if (blockLength != 4)
+            throw new InterestException ();
+          m_hopCount = static_cast<int32_t> (i.ReadNtohU32 () & 0x7FFFFFFF);
+          break;
+        default:
+          i.Next (blockLength); // unknown elements are ignored
+          break;
+        }
+    }
+
+  if (m_name == 0 || i.GetDistanceFrom (value) != length)
+    throw new InterestException ();
+
+  return i.GetDistanceFrom (start);
+}
+
 TypeId
 Interest::GetInstanceTypeId (void) const
 {
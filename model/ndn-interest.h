@@ -34,6 +34,8 @@
 #include "ndn-name.h"
 #include "ndn-exclusion.h"
 
+#include "ns3/ndnSIM/utils/ndn-object-pool.h"
+
 namespace ns3 {
 
 class Packet;
@@ -95,6 +97,8 @@ namespace ndn {
 class Interest : public SimpleRefCount<Interest, Header>
 {
 public:
+  NDN_OBJECT_POOL (Interest, 1024)
+
   /**
    * \brief Constructor
    *
@@ -239,6 +243,23 @@ public:
   uint8_t
   GetNack () const;
 
+  /**
+   * @brief Set hop count, carried in the header
+   *
+   * When set, Face increments the hop count in place on each send (see HeaderHelper::IncrementHopCount),
+   * so FwHopCountTag is not needed.  Negative value (default) means that the Interest does not carry hop count.
+   *
+   * @param[in] hopCount number of hops (negative to remove hop count from the header)
+   */
+  void
+  SetHopCount (int32_t hopCount);
+
+  /**
+   * @brief Get hop count carried in the header (negative if not present)
+   */
+  int32_t
+  GetHopCount () const;
+
   //////////////////////////////////////////////////////////////////
 
   static TypeId GetTypeId (void); ///< @brief Get TypeId of the class
@@ -252,6 +273,9 @@ public:
   /**
    * \brief Get the size of Interest packet
    * Returns the Interest packet size after serialization
+   *
+   * The size is calculated once and cached until any of the fields is changed (name should not be
+   * modified after it is set to Interest)
    */
   virtual uint32_t GetSerializedSize (void) const;
   
@@ -275,15 +299,43 @@ public:
   static Ptr<Interest>
   GetInterest (Ptr<Packet> packet);
   
+private:
+  /**
+   * @brief Get size of the value of Interest TLV block
+   */
+  uint32_t
+  GetTlvValueSize () const;
+
+  /**
+   * @brief Get size of the value of Exclude TLV block
+   */
+  uint32_t
+  GetTlvExcludeSize () const;
+
+  /**
+   * @brief Serialize Interest in TLV wire format
+   */
+  void
+  SerializeTlv (Buffer::Iterator start) const;
+
+  /**
+   * @brief Deserialize Interest from TLV wire format
+   */
+  uint32_t
+  DeserializeTlv (Buffer::Iterator start);
+
 private:
   Ptr<Name> m_name;    ///< Interest name
   uint8_t m_scope;                ///< 0xFF not set, 0 local scope, 1 this host, 2 immediate neighborhood
   Time  m_interestLifetime;      ///< InterestLifetime
   uint32_t m_nonce;              ///< Nonce. not used if zero
   uint8_t  m_nackType;           ///< Negative Acknowledgement type
+  int32_t  m_hopCount;           ///< Hop count (negative if not present)
 
   uint16_t m_exclusionNum;       ///< The number of execluded content objects
   Ptr<Exclusion> m_exclusion;    ///< The digests of the excluded content objects
+
+  mutable uint32_t m_serializedSize; ///< Cached serialized size (0 if needs to be recalculated)
 };
 
 typedef Interest InterestHeader;
@@ -31,6 +31,7 @@
 #include "ns3/pointer.h"
 #include "ns3/simulator.h"
 #include "ns3/random-variable.h"
+#include "ns3/unused.h"
 
 #include "ns3/ndn-header-helper.h"
 #include "ns3/ndn-pit.h"
@@ -144,6 +145,8 @@ L3Protocol::DoDispose (void)
       *i = 0;
     }
   m_faces.clear ();
+  m_facesById.clear ();
+  m_facesByNetDevice.clear ();
   m_node = 0;
 
   // Force delete on objects
@@ -161,10 +164,17 @@ L3Protocol::AddFace (const Ptr<Face> &face)
 
   // ask face to register in lower-layer stack
   face->RegisterProtocolHandler (MakeCallback (&L3Protocol::Receive, this));
+  face->RegisterParsedPacketHandlers (MakeCallback (&L3Protocol::ReceiveInterest, this),
+                                      MakeCallback (&L3Protocol::ReceiveData, this));
 
   m_faces.push_back (face);
+  m_facesById.push_back (face);
   m_faceCounter++;
 
+  Ptr<NetDeviceFace> netDeviceFace = DynamicCast<NetDeviceFace> (face);
+  if (netDeviceFace != 0)
+    m_facesByNetDevice.insert (std::make_pair (PeekPointer (netDeviceFace->GetNetDevice ()), face)); // first face for the device wins
+
   m_forwardingStrategy->AddFace (face); // notify that face is added
   return face->GetId ();
 }
@@ -174,6 +184,7 @@ L3Protocol::RemoveFace (Ptr<Face> face)
 {
   // ask face to register in lower-layer stack
   face->RegisterProtocolHandler (MakeNullCallback<void,const Ptr<Face>&,const Ptr<const Packet>&> ());
+  face->RegisterParsedPacketHandlers (Face::InterestHandler (), Face::DataHandler ());
   Ptr<Pit> pit = GetObject<Pit> ();
 
   // just to be on a safe side. Do the process in two steps
@@ -199,6 +210,31 @@ L3Protocol::RemoveFace (Ptr<Face> face)
   NS_ASSERT_MSG (face_it != m_faces.end (), "Attempt to remove face that doesn't exist");
   m_faces.erase (face_it);
 
+  NS_ASSERT (face->GetId () < m_facesById.size ());
+  m_facesById[face->GetId ()] = 0;
+
+  Ptr<NetDeviceFace> netDeviceFace = DynamicCast<NetDeviceFace> (face);
+  if (netDeviceFace != 0)
+    {
+      Ptr<NetDevice> netDevice = netDeviceFace->GetNetDevice ();
+      NetDeviceFaceMap::iterator item = m_facesByNetDevice.find (PeekPointer (netDevice));
+      if (item != m_facesByNetDevice.end () && item->second == face)
+        {
+          m_facesByNetDevice.erase (item);
+
+          // the next face for the same device (in the order faces were added) takes its place
+          BOOST_FOREACH (const Ptr<Face> &otherFace, m_faces)
+            {
+              Ptr<NetDeviceFace> otherNetDeviceFace = DynamicCast<NetDeviceFace> (otherFace);
+              if (otherNetDeviceFace != 0 && otherNetDeviceFace->GetNetDevice () == netDevice)
+                {
+                  m_facesByNetDevice.insert (std::make_pair (PeekPointer (netDevice), otherFace));
+                  break;
+                }
+            }
+        }
+    }
+
   GetObject<Fib> ()->RemoveFromAll (face);
   m_forwardingStrategy->RemoveFace (face); // notify that face is removed
 }
@@ -213,26 +249,20 @@ L3Protocol::GetFace (uint32_t index) const
 Ptr<Face>
 L3Protocol::GetFaceById (uint32_t index) const
 {
-  BOOST_FOREACH (const Ptr<Face> &face, m_faces) // this function is not supposed to be called often, so linear search is fine
-    {
-      if (face->GetId () == index)
-        return face;
-    }
-  return 0;
+  if (index >= m_facesById.size ())
+    return 0;
+
+  return m_facesById[index]; // face IDs are assigned sequentially by AddFace
 }
 
 Ptr<Face>
 L3Protocol::GetFaceByNetDevice (Ptr<NetDevice> netDevice) const
 {
-  BOOST_FOREACH (const Ptr<Face> &face, m_faces) // this function is not supposed to be called often, so linear search is fine
-    {
-      Ptr<NetDeviceFace> netDeviceFace = DynamicCast<NetDeviceFace> (face);
-      if (netDeviceFace == 0) continue;
+  NetDeviceFaceMap::const_iterator face = m_facesByNetDevice.find (PeekPointer (netDevice));
+  if (face == m_facesByNetDevice.end ())
+    return 0;
 
-      if (netDeviceFace->GetNetDevice () == netDevice)
-        return face;
-    }
-  return 0;
+  return face->second;
 }
 
 uint32_t
@@ -252,32 +282,30 @@ L3Protocol::Receive (const Ptr<Face> &face, const Ptr<const Packet> &p)
 
   NS_LOG_LOGIC ("Packet from face " << *face << " received on node " <<  m_node->GetId ());
 
-  Ptr<Packet> packet = p->Copy (); // give upper layers a rw copy of the packet
   try
     {
       HeaderHelper::Type type = HeaderHelper::GetNdnHeaderType (p);
       switch (type)
         {
         case HeaderHelper::INTEREST_NDNSIM:
+        case HeaderHelper::INTEREST_TLV:
           {
-            s_interestCounter ++;
             Ptr<Interest> header = Create<Interest> ();
 
             // Deserialization. Exception may be thrown
-            packet->RemoveHeader (*header);
-            NS_ASSERT_MSG (packet->GetSize () == 0, "Payload of Interests should be zero");
+            // (Interest has no payload, so header is read directly from the original packet, without making a copy)
+            uint32_t headerSize = p->PeekHeader (*header);
+            NS_ASSERT_MSG (p->GetSize () == headerSize, "Payload of Interests should be zero");
+            NS_UNUSED (headerSize);
 
-            m_forwardingStrategy->OnInterest (face, header, p/*original packet*/);
-            // if (header->GetNack () > 0)
-            //   OnNack (face, header, p/*original packet*/);
-            // else
-            //   OnInterest (face, header, p/*original packet*/);
+            ReceiveInterest (face, header, p/*original packet*/);
             break;
           }
         case HeaderHelper::CONTENT_OBJECT_NDNSIM:
+        case HeaderHelper::CONTENT_OBJECT_TLV:
           {
-            s_dataCounter ++;
             Ptr<ContentObject> header = Create<ContentObject> ();
+            Ptr<Packet> packet = p->Copy (); // give upper layers a rw copy of the payload
 
             static ContentObjectTail contentObjectTrailer; //there is no data in this object
 
@@ -285,7 +313,7 @@ L3Protocol::Receive (const Ptr<Face> &face, const Ptr<const Packet> &p)
             packet->RemoveHeader (*header);
             packet->RemoveTrailer (contentObjectTrailer);
 
-            m_forwardingStrategy->OnData (face, header, packet/*payload*/, p/*original packet*/);
+            ReceiveData (face, header, packet/*payload*/, p/*original packet*/);
             break;
           }
         case HeaderHelper::INTEREST_CCNB:
@@ -304,6 +332,30 @@ L3Protocol::Receive (const Ptr<Face> &face, const Ptr<const Packet> &p)
     }
 }
 
+void
+L3Protocol::ReceiveInterest (const Ptr<Face> &face, Ptr<Interest> header, const Ptr<const Packet> &p)
+{
+  if (!face->IsUp ())
+    return;
+
+  s_interestCounter ++;
+  m_forwardingStrategy->OnInterest (face, header, p/*original packet*/);
+  // if (header->GetNack () > 0)
+  //   OnNack (face, header, p/*original packet*/);
+  // else
+  //   OnInterest (face, header, p/*original packet*/);
+}
+
+void
+L3Protocol::ReceiveData (const Ptr<Face> &face, Ptr<ContentObject> header, Ptr<Packet> payload, const Ptr<const Packet> &p)
+{
+  if (!face->IsUp ())
+    return;
+
+  s_dataCounter ++;
+  m_forwardingStrategy->OnData (face, header, payload, p/*original packet*/);
+}
+
 
 } //namespace ndn
 } //namespace ns3
@@ -23,6 +23,7 @@
 
 #include <list>
 #include <vector>
+#include <boost/unordered_map.hpp>
 
 #include "ns3/ptr.h"
 #include "ns3/net-device.h"
@@ -118,7 +119,7 @@ public:
   GetFace (uint32_t face) const;
   
   /**
-   * \brief Get face by face ID
+   * \brief Get face by face ID (constant time)
    * \param face The face ID number
    * \returns The NdnFace associated with the Ndn face number.
    */
@@ -132,7 +133,10 @@ public:
   RemoveFace (Ptr<Face> face);
 
   /**
-   * \brief Get face for NetDevice
+   * \brief Get face for NetDevice (constant time)
+   *
+   * If there are several faces for the same NetDevice, the earliest added face that still exists
+   * is returned
    */
   virtual Ptr<Face>
   GetFaceByNetDevice (Ptr<NetDevice> netDevice) const;
@@ -147,6 +151,18 @@ private:
   void
   Receive (const Ptr<Face> &face, const Ptr<const Packet> &p);
 
+  /**
+   * \brief Process Interest, which header has already been parsed (by lower layer or application)
+   */
+  void
+  ReceiveInterest (const Ptr<Face> &face, Ptr<Interest> header, const Ptr<const Packet> &p);
+
+  /**
+   * \brief Process Data packet, which header has already been parsed (by lower layer or application)
+   */
+  void
+  ReceiveData (const Ptr<Face> &face, Ptr<ContentObject> header, Ptr<Packet> payload, const Ptr<const Packet> &p);
+
 protected:
   virtual void DoDispose (void); ///< @brief Do cleanup
 
@@ -163,6 +179,10 @@ private:
 private:
   uint32_t m_faceCounter; ///< \brief counter of faces. Increased every time a new face is added to the stack
   FaceList m_faces; ///< \brief list of faces that belongs to ndn stack on this node
+  FaceList m_facesById; ///< \brief faces indexed by face ID (0 for removed faces)
+
+  typedef boost::unordered_map<const NetDevice*, Ptr<Face> > NetDeviceFaceMap;
+  NetDeviceFaceMap m_facesByNetDevice; ///< \brief faces indexed by NetDevice (only for NetDeviceFace)
 
   static uint64_t s_interestCounter;
   static uint64_t s_dataCounter;
@@ -0,0 +1,237 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil -*- */
+/*
+ * Copyright (c) 2011 University of California, Los Angeles
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ * Author: Alexander Afanasyev <alexander.afanasyev@ucla.edu>
+ */
+
+#include "ndn-name-tree.h"
+
+#include "ns3/log.h"
+
+NS_LOG_COMPONENT_DEFINE ("ndn.NameTree");
+
+namespace ns3 {
+namespace ndn {
+
+NS_OBJECT_ENSURE_REGISTERED (NameTree);
+
+namespace
+{
+/**
+ * @brief Collects exact PIT match and the longest FIB match while walking the tree
+ */
+template<class Iterator>
+struct InterestVisitor
+{
+  InterestVisitor () : m_fibEntry (0) { }
+
+  void
+  operator () (Iterator node)
+  {
+    if (node->payload () != 0 && node->payload ()->m_fibEntry != 0)
+      m_fibEntry = node->payload ()->m_fibEntry;
+  }
+
+  Ptr<fib::Entry> m_fibEntry;
+};
+
+/**
+ * @brief Collects the longest PIT match with non-empty list of incoming faces
+ */
+template<class Iterator>
+struct DataVisitor
+{
+  DataVisitor () : m_pitEntry (0) { }
+
+  void
+  operator () (Iterator node)
+  {
+    if (node->payload () != 0 &&
+        node->payload ()->m_pitEntry != 0 &&
+        !node->payload ()->m_pitEntry->GetIncoming ().empty ())
+      m_pitEntry = node->payload ()->m_pitEntry;
+  }
+
+  pit::Entry *m_pitEntry;
+};
+}
+
+TypeId
+NameTree::GetTypeId ()
+{
+  static TypeId tid = TypeId ("ns3::ndn::NameTree")
+    .SetGroupName ("Ndn")
+    .SetParent<Object> ()
+    .AddConstructor<NameTree> ()
+    ;
+  return tid;
+}
+
+NameTree::NameTree ()
+  : m_trie ("")
+  , m_size (0)
+{
+}
+
+NameTree::~NameTree ()
+{
+}
+
+void
+NameTree::DoDispose ()
+{
+  m_trie.clear ();
+  m_size = 0;
+
+  Object::DoDispose ();
+}
+
+boost::tuple< Ptr<pit::Entry>, Ptr<fib::Entry> >
+NameTree::Lookup (const Name &name)
+{
+  InterestVisitor<trie::iterator> visitor;
+  std::pair<trie::iterator, bool> last = m_trie.walk (name, visitor);
+
+  Ptr<pit::Entry> pitEntry;
+  if (last.second && last.first->payload () != 0)
+    {
+      pitEntry = last.first->payload ()->m_pitEntry;
+    }
+
+  return boost::make_tuple (pitEntry, visitor.m_fibEntry);
+}
+
+Ptr<pit::Entry>
+NameTree::LookupData (const Name &name)
+{
+  DataVisitor<trie::iterator> visitor;
+  m_trie.walk (name, visitor);
+
+  return visitor.m_pitEntry;
+}
+
+void
+NameTree::SetFibEntry (const Name &prefix, Ptr<fib::Entry> fibEntry)
+{
+  NS_LOG_FUNCTION (this << prefix);
+
+  trie::iterator node = FindOrCreate (prefix);
+  if (node->payload ()->IsEmpty ())
+    m_size ++;
+
+  node->payload ()->m_fibEntry = fibEntry;
+}
+
+void
+NameTree::RemoveFibEntry (const Name &prefix, Ptr<fib::Entry> fibEntry)
+{
+  NS_LOG_FUNCTION (this << prefix);
+
+  trie::iterator foundItem, lastItem;
+  bool reachLast;
+  boost::tie (foundItem, reachLast, lastItem) = m_trie.find (prefix);
+
+  if (!reachLast || lastItem->payload () == 0 || lastItem->payload ()->m_fibEntry != fibEntry)
+    return;
+
+  lastItem->payload ()->m_fibEntry = 0;
+  Cleanup (lastItem);
+}
+
+void
+NameTree::SetPitEntry (const Name &name, Ptr<pit::Entry> pitEntry)
+{
+  NS_LOG_FUNCTION (this << name);
+
+  trie::iterator node = FindOrCreate (name);
+  if (node->payload ()->IsEmpty ())
+    m_size ++;
+
+  node->payload ()->m_pitEntry = PeekPointer (pitEntry);
+}
+
+void
+NameTree::RemovePitEntry (const Name &name, const pit::Entry *pitEntry)
+{
+  trie::iterator foundItem, lastItem;
+  bool reachLast;
+  boost::tie (foundItem, reachLast, lastItem) = m_trie.find (name);
+
+  if (!reachLast || lastItem->payload () == 0 || lastItem->payload ()->m_pitEntry != pitEntry)
+    return;
+
+  NS_LOG_FUNCTION (this << name);
+
+  lastItem->payload ()->m_pitEntry = 0;
+  Cleanup (lastItem);
+}
+
+uint32_t
+NameTree::GetSize () const
+{
+  return m_size;
+}
+
+void
+NameTree::Print (std::ostream &os) const
+{
+  // !!! unordered_set imposes "random" order of item in the same level !!!
+  trie::const_recursive_iterator item (m_trie), end (0);
+  for (; item != end; item++)
+    {
+      if (item->payload () == 0) continue;
+
+      if (item->payload ()->m_fibEntry != 0)
+        os << item->payload ()->m_fibEntry->GetPrefix () << "\t[FIB] " << *item->payload ()->m_fibEntry << "\n";
+      if (item->payload ()->m_pitEntry != 0)
+        os << item->payload ()->m_pitEntry->GetPrefix () << "\t[PIT] " << *item->payload ()->m_pitEntry << "\n";
+    }
+}
+
+NameTree::trie::iterator
+NameTree::FindOrCreate (const Name &name)
+{
+  trie::iterator foundItem, lastItem;
+  bool reachLast;
+  boost::tie (foundItem, reachLast, lastItem) = m_trie.find (name);
+
+  if (reachLast && lastItem->payload () != 0)
+    return lastItem;
+
+  std::pair<trie::iterator, bool> result = m_trie.insert (name, Create<name_tree::Entry> ());
+  return result.first;
+}
+
+void
+NameTree::Cleanup (trie::iterator node)
+{
+  if (node->payload ()->IsEmpty ())
+    {
+      m_size --;
+      node->erase (); // will also prune empty parents
+    }
+}
+
+std::ostream &
+operator << (std::ostream &os, const NameTree &nameTree)
+{
+  nameTree.Print (os);
+  return os;
+}
+
+} // namespace ndn
+} // namespace ns3
@@ -0,0 +1,191 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil -*- */
+/*
+ * Copyright (c) 2011 University of California, Los Angeles
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ * Author: Alexander Afanasyev <alexander.afanasyev@ucla.edu>
+ */
+
+#ifndef _NDN_NAME_TREE_H_
+#define _NDN_NAME_TREE_H_
+
+#include "ns3/object.h"
+#include "ns3/ptr.h"
+#include "ns3/simple-ref-count.h"
+
+#include "ns3/ndn-name.h"
+#include "ns3/ndn-fib-entry.h"
+#include "ns3/ndn-pit-entry.h"
+
+#include "../utils/trie/trie.h"
+#include "../utils/trie/empty-policy.h"
+
+#include <boost/tuple/tuple.hpp>
+
+namespace ns3 {
+namespace ndn {
+
+namespace name_tree {
+
+/**
+ * @ingroup ndn
+ * @brief Entry of the unified name tree
+ *
+ * Holds references to table entries that are registered for exactly the same name.
+ * The entry does not own PIT entry, PIT is responsible to remove the reference
+ * before the entry is destroyed.
+ */
+class Entry : public SimpleRefCount<Entry>
+{
+public:
+  /**
+   * @brief Default constructor
+   */
+  Entry ()
+    : m_pitEntry (0)
+  {
+  }
+
+  /**
+   * @brief Check whether entry holds references to any table entry
+   */
+  bool
+  IsEmpty () const
+  {
+    return m_fibEntry == 0 && m_pitEntry == 0;
+  }
+
+public:
+  Ptr<fib::Entry> m_fibEntry; ///< \brief FIB entry registered for exactly this prefix
+  pit::Entry *m_pitEntry;     ///< \brief PIT entry for exactly this name (not owned)
+};
+
+} // namespace name_tree
+
+/**
+ * @ingroup ndn
+ * @brief Unified name tree, indexing FIB and PIT entries in the same trie
+ *
+ * When name tree is aggregated to the node, FIB and PIT register their entries in the tree,
+ * so the forwarding strategy can resolve exact PIT match and longest FIB match for the incoming
+ * Interest (or longest non-empty PIT match for the incoming Data) with a single trie walk.
+ *
+ * FIB and PIT remain the owners of their entries (separate Fib and Pit objects are still available
+ * and behave exactly as before), name tree is just an index on top of them.
+ */
+class NameTree : public Object
+{
+public:
+  /**
+   * \brief Interface ID
+   *
+   * \return interface ID
+   */
+  static TypeId
+  GetTypeId ();
+
+  /**
+   * @brief Default constructor
+   */
+  NameTree ();
+
+  /**
+   * @brief Virtual destructor
+   */
+  virtual
+  ~NameTree ();
+
+  /**
+   * @brief Resolve PIT and FIB entries for the Interest name in a single walk
+   * @param name Interest name
+   * @returns tuple of PIT entry with exactly the same name (or 0) and FIB entry with
+   *          the longest matching prefix (or 0)
+   */
+  boost::tuple< Ptr<pit::Entry>, Ptr<fib::Entry> >
+  Lookup (const Name &name);
+
+  /**
+   * @brief Find PIT entry with the longest prefix of the Data name that still has incoming faces
+   *
+   * Equivalent to Pit::Lookup (const ContentObject &)
+   */
+  Ptr<pit::Entry>
+  LookupData (const Name &name);
+
+  /**
+   * @brief Register FIB entry for the prefix
+   */
+  void
+  SetFibEntry (const Name &prefix, Ptr<fib::Entry> fibEntry);
+
+  /**
+   * @brief Remove reference to FIB entry (if the prefix is registered with this entry)
+   */
+  void
+  RemoveFibEntry (const Name &prefix, Ptr<fib::Entry> fibEntry);
+
+  /**
+   * @brief Register PIT entry for the name
+   */
+  void
+  SetPitEntry (const Name &name, Ptr<pit::Entry> pitEntry);
+
+  /**
+   * @brief Remove reference to PIT entry (if the name is registered with this entry)
+   *
+   * Should be called by PIT each time entry is removed from PIT
+   */
+  void
+  RemovePitEntry (const Name &name, const pit::Entry *pitEntry);
+
+  /**
+   * @brief Get number of names registered in the tree
+   */
+  uint32_t
+  GetSize () const;
+
+  /**
+   * @brief Print out name tree contents
+   */
+  void
+  Print (std::ostream &os) const;
+
+protected:
+  // inherited from Object class
+  virtual void DoDispose (); ///< @brief Do cleanup
+
+private:
+  typedef ndnSIM::trie< Name,
+                        ndnSIM::smart_pointer_payload_traits<name_tree::Entry>,
+                        ndnSIM::empty_policy_traits::policy_hook_type > trie;
+
+  trie::iterator
+  FindOrCreate (const Name &name);
+
+  void
+  Cleanup (trie::iterator node);
+
+private:
+  trie m_trie;
+  uint32_t m_size; ///< \brief Number of non-empty entries in the tree
+};
+
+std::ostream &
+operator << (std::ostream &os, const NameTree &nameTree);
+
+} // namespace ndn
+} // namespace ns3
+
+#endif // _NDN_NAME_TREE_H_
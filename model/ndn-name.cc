@@ -24,6 +24,10 @@
 #include "ns3/log.h"
 
 #include <iostream>
+#include <iterator>
+#include <algorithm>
+#include <ctype.h>
+#include <string.h>
 
 using namespace std;
 
@@ -34,41 +38,146 @@ namespace ndn {
 
 ATTRIBUTE_HELPER_CPP (Name);
 
+namespace {
+
+const size_t MAX_URI_LENGTH = 30000; ///< @brief same limit as for the serialized name
+
+/**
+ * @brief Get value of the hex digit (-1 if character is not a hex digit)
+ */
+int
+HexDigitValue (char c)
+{
+  if (c >= '0' && c <= '9')
+    return c - '0';
+  if (c >= 'A' && c <= 'F')
+    return c - 'A' + 10;
+  if (c >= 'a' && c <= 'f')
+    return c - 'a' + 10;
+  return -1;
+}
+
+/**
+ * @brief Append URI representation of the component to the string
+ *
+ * Octets that AppendUri would not read back as-is (slash, percent, whitespace, and non-printable
+ * characters) are encoded as %XX, so the printed name can be parsed back into the same name
+ */
+void
+AppendEscapedComponent (std::string &uri, const std::string &component)
+{
+  static const char hexDigits[] = "0123456789ABCDEF";
+
+  uri.push_back ('/');
+  for (std::string::const_iterator i = component.begin (); i != component.end (); i++)
+    {
+      unsigned char value = static_cast<unsigned char> (*i);
+      if (value == '/' || value == '%' || isspace (value) || !isprint (value))
+        {
+          uri.push_back ('%');
+          uri.push_back (hexDigits[value >> 4]);
+          uri.push_back (hexDigits[value & 0x0F]);
+        }
+      else
+        uri.push_back (*i);
+    }
+}
+
+} // namespace
+
 Name::Name (/* root */)
+  : m_serializedSize (2)
 {
 }
 
 Name::Name (const std::list<boost::reference_wrapper<const std::string> > &components)
+  : m_serializedSize (0)
 {
+  m_prefix.reserve (components.size ());
   BOOST_FOREACH (const boost::reference_wrapper<const std::string> &component, components)
     {
-      Add (component.get ());
+      m_prefix.push_back (component.get ());
     }
 }
 
 Name::Name (const std::list<std::string> &components)
+  : m_prefix (components.begin (), components.end ())
+  , m_serializedSize (0)
+{
+}
+
+Name::Name (const std::vector<std::string> &components)
+  : m_prefix (components)
+  , m_serializedSize (0)
 {
-  BOOST_FOREACH (const std::string &component, components)
-    {
-      Add (component);
-    }
 }
 
 Name::Name (const std::string &prefix)
+  : m_serializedSize (2)
 {
-  istringstream is (prefix);
-  is >> *this;
+  AppendUri (prefix.c_str (), prefix.size ());
 }
 
 Name::Name (const char *prefix)
+  : m_serializedSize (2)
 {
   NS_ASSERT (prefix != 0);
 
-  istringstream is (prefix);
-  is >> *this;
+  AppendUri (prefix, strlen (prefix));
+}
+
+Name &
+Name::AppendUri (const char *uri, size_t length)
+{
+  if (length >= MAX_URI_LENGTH)
+    NS_FATAL_ERROR ("Name is too long (> 30kbytes)");
+
+  size_t addedSize = 0;
+  const char *end = uri + length;
+  const char *position = uri;
+
+  // there cannot be more components than slashes plus one
+  m_prefix.reserve (m_prefix.size () + std::count (uri, end, '/') + 1);
+  while (position != end)
+    {
+      const char *componentEnd = std::find (position, end, '/');
+
+      std::string *component = 0; // component is created only when there is something to put there
+      for (; position != componentEnd; position++)
+        {
+          char value = *position;
+          if (isspace (static_cast<unsigned char> (value)))
+            continue;
+
+          if (value == '%' && componentEnd - position > 2 &&
+              HexDigitValue (position[1]) >= 0 && HexDigitValue (position[2]) >= 0)
+            {
+              value = static_cast<char> ((HexDigitValue (position[1]) << 4) | HexDigitValue (position[2]));
+              position += 2;
+            }
+
+          if (component == 0)
+            {
+              m_prefix.push_back (std::string ());
+              component = &m_prefix.back ();
+              component->reserve (componentEnd - position);
+              addedSize += 2;
+            }
+          component->push_back (value);
+          addedSize ++;
+        }
+
+      if (position != end)
+        position ++; // skip slash
+    }
+
+  if (m_serializedSize != 0)
+    m_serializedSize += addedSize;
+
+  return *this;
 }
 
-const std::list<std::string> &
+const std::vector<std::string> &
 Name::GetComponents () const
 {
   return m_prefix;
@@ -91,7 +200,7 @@ Name::GetSubComponents (size_t num) const
   NS_ASSERT_MSG (0<=num && num<=m_prefix.size (), "Invalid number of subcomponents requested");
 
   std::list<boost::reference_wrapper<const std::string> > subComponents;
-  std::list<std::string>::const_iterator component = m_prefix.begin();
+  const_iterator component = m_prefix.begin ();
   for (size_t i=0; i<num; i++, component++)
     {
       subComponents.push_back (boost::ref (*component));
@@ -104,11 +213,8 @@ Name
 Name::cut (size_t minusComponents) const
 {
   Name retval;
-  std::list<std::string>::const_iterator component = m_prefix.begin ();
-  for (uint32_t i = 0; i < m_prefix.size () - minusComponents; i++, component++)
-    {
-      retval.Add (*component);
-    }
+  retval.m_prefix.assign (m_prefix.begin (), m_prefix.end () - minusComponents);
+  retval.m_serializedSize = 0;
 
   return retval;
 }
@@ -116,9 +222,12 @@ Name::cut (size_t minusComponents) const
 size_t
 Name::GetSerializedSize () const
 {
+  if (m_serializedSize != 0)
+    return m_serializedSize;
+
   size_t nameSerializedSize = 2;
 
-  for (std::list<std::string>::const_iterator i = this->begin ();
+  for (const_iterator i = this->begin ();
        i != this->end ();
        i++)
     {
@@ -126,6 +235,7 @@ Name::GetSerializedSize () const
     }
   NS_ASSERT_MSG (nameSerializedSize < 30000, "Name is too long (> 30kbytes)");
 
+  m_serializedSize = nameSerializedSize;
   return nameSerializedSize;
 }
 
@@ -136,7 +246,7 @@ Name::Serialize (Buffer::Iterator start) const
 
   i.WriteU16 (static_cast<uint16_t> (this->GetSerializedSize ()-2));
 
-  for (std::list<std::string>::const_iterator item = this->begin ();
+  for (const_iterator item = this->begin ();
        item != this->end ();
        item++)
     {
@@ -153,28 +263,52 @@ Name::Deserialize (Buffer::Iterator start)
   Buffer::Iterator i = start;
 
   uint16_t nameLength = i.ReadU16 ();
+
+  // count components first, so they are stored without reallocations
+  Buffer::Iterator scan = i;
+  size_t nComponents = 0;
+  for (uint16_t remaining = nameLength; remaining >= 2; nComponents++)
+    {
+      uint16_t length = scan.ReadU16 ();
+      if (length > remaining - 2)
+        break;
+
+      scan.Next (length);
+      remaining -= 2 + length;
+    }
+  m_prefix.reserve (m_prefix.size () + nComponents);
+
   while (nameLength > 0)
     {
       uint16_t length = i.ReadU16 ();
       nameLength = nameLength - 2 - length;
 
-      uint8_t tmp[length];
-      i.Read (tmp, length);
-
-      this->Add (string (reinterpret_cast<const char*> (tmp), length));
+      AppendComponent (i, length);
     }
 
   return i.GetDistanceFrom (start);
 }
 
+Name &
+Name::AppendComponent (Buffer::Iterator &i, uint32_t length)
+{
+  m_prefix.push_back (std::string (length, '\0'));
+  if (length > 0)
+    i.Read (reinterpret_cast<uint8_t*> (&m_prefix.back ()[0]), length);
+
+  if (m_serializedSize != 0)
+    m_serializedSize += 2 + length;
+
+  return *this;
+}
+
 void
 Name::Print (std::ostream &os) const
 {
-  for (const_iterator i=m_prefix.begin(); i!=m_prefix.end(); i++)
-    {
-      os << "/" << *i;
-    }
-  if (m_prefix.size ()==0) os << "/";
+  if (m_prefix.size ()==0)
+    os << "/";
+  else
+    os << ToString ();
 }
 
 std::string
@@ -183,8 +317,7 @@ Name::ToString () const
   std::string ret_value;
   for (const_iterator i=m_prefix.begin(); i!=m_prefix.end(); i++)
     {
-      ret_value.append("/");
-      ret_value.append(*i);
+      AppendEscapedComponent (ret_value, *i);
     }
   return ret_value;
 }
@@ -199,23 +332,9 @@ operator << (std::ostream &os, const Name &components)
 std::istream &
 operator >> (std::istream &is, Name &components)
 {
-  istream_iterator<char> eos; // end of stream
-
-  std::string component = "";
-  istream_iterator<char> it (is);
-  for (; it != eos; it++)
-    {
-      if (*it == '/')
-        {
-          if (component != "")
-              components.Add (component);
-          component = "";
-        }
-      else
-        component.push_back (*it);
-    }
-  if (component != "")
-      components.Add (component);
+  // read the whole stream at once, without per-character formatted input
+  std::string uri ((istreambuf_iterator<char> (is)), istreambuf_iterator<char> ());
+  components.AppendUri (uri.c_str (), uri.size ());
 
   is.clear ();
   // NS_LOG_ERROR (components << ", bad: " << is.bad () <<", fail: " << is.fail ());
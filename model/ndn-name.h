@@ -29,11 +29,14 @@
 #include <string>
 #include <algorithm>
 #include <list>
+#include <vector>
 #include "ns3/object.h"
 #include "ns3/buffer.h"
 
 #include <boost/ref.hpp>
 
+#include "ns3/ndnSIM/utils/ndn-object-pool.h"
+
 namespace ns3 {
 namespace ndn {
 
@@ -49,8 +52,10 @@ namespace ndn {
 class Name : public SimpleRefCount<Name>
 {
 public:
-  typedef std::list<std::string>::iterator       iterator;
-  typedef std::list<std::string>::const_iterator const_iterator;
+  NDN_OBJECT_POOL (Name, 4096)
+
+  typedef std::vector<std::string>::iterator       iterator;
+  typedef std::vector<std::string>::const_iterator const_iterator;
 
   /**
    * \brief Constructor
@@ -71,21 +76,40 @@ public:
    * @param[in] components A list of strings
    */
   Name (const std::list<std::string> &components);
-  
+
+  /**
+   * \brief Constructor
+   * Creates a prefix from a vector of strings where every string represents a prefix component
+   * @param[in] components A vector of strings
+   */
+  Name (const std::vector<std::string> &components);
+
   /**
    * @brief Constructor
-   * Creates a prefix from the string (string is parsed using operator>>)
+   * Creates a prefix from the string (string is parsed using AppendUri)
    * @param[in] prefix A string representation of a prefix
    */
   Name (const std::string &prefix);
 
   /**
    * @brief Constructor
-   * Creates a prefix from the string (string is parsed using operator>>)
+   * Creates a prefix from the string (string is parsed using AppendUri)
    * @param[in] prefix A string representation of a prefix
    */
   Name (const char *prefix);
 
+  /**
+   * @brief Append components from URI representation of the name (e.g., /first/second%2Fthird)
+   *
+   * Components are separated by slashes, empty components are skipped, whitespace characters are
+   * ignored, and %XX sequences (XX is a hex number) are decoded into the corresponding octets
+   *
+   * @param[in] uri Pointer to the URI representation
+   * @param[in] length Length of the URI representation (simulation is aborted if it is not less than 30000)
+   */
+  Name &
+  AppendUri (const char *uri, size_t length);
+
   /**
    * \brief Generic Add method
    * Appends object of type T to the list of components
@@ -105,9 +129,9 @@ public:
 
   /**
    * \brief Get a name
-   * Returns a list of components (strings)
+   * Returns a vector of components (strings)
    */
-  const std::list<std::string> &
+  const std::vector<std::string> &
   GetComponents () const;
 
   /**
@@ -131,18 +155,25 @@ public:
 
   /**
    * \brief Print name
+   *
+   * Slashes, percent signs, whitespace, and non-printable characters inside components are
+   * printed as %XX, so the output can be parsed back using AppendUri
+   *
    * @param[in] os Stream to print
    */
   void Print (std::ostream &os) const;
 
   /**
-   * \brief Return the name in string representation
+   * \brief Return the name in string representation (escaped the same way as in Print)
    */ 
   std::string
   ToString () const;
 
   /**
    * @brief Get serialized size for ndnSIM packet encoding
+   *
+   * The size is maintained when components are added, so the call is O(1) unless the name has been
+   * modified via read-write iterators
    */
   size_t
   GetSerializedSize () const;
@@ -161,12 +192,33 @@ public:
   uint32_t
   Deserialize (Buffer::Iterator start);
 
+  /**
+   * @brief Append component read directly from the packet buffer
+   *
+   * Component storage is allocated once and filled straight from the buffer, without any
+   * intermediate copies
+   *
+   * @param[in,out] i buffer iterator (advanced by length octets)
+   * @param[in] length length of the component
+   */
+  Name &
+  AppendComponent (Buffer::Iterator &i, uint32_t length);
+
   /**
    * \brief Returns the size of Name
    */
   inline size_t
   size () const;
 
+  /**
+   * @brief Reserve space for the given total number of components
+   *
+   * Components are stored in a contiguous array, so reserving the space before components are
+   * appended one by one avoids reallocations of the array
+   */
+  inline void
+  reserve (size_t components);
+
   /**
    * @brief Get read-write begin() iterator
    */
@@ -206,7 +258,8 @@ public:
   typedef std::string partial_type;
 
 private:
-  std::list<std::string> m_prefix;                              ///< \brief a list of strings (components)
+  std::vector<std::string> m_prefix;                            ///< \brief components, stored contiguously
+  mutable size_t m_serializedSize;                              ///< \brief cached serialized size (0 if needs to be recalculated)
 };
 
 /**
@@ -231,9 +284,16 @@ Name::size () const
   return m_prefix.size ();
 }
 
+void
+Name::reserve (size_t components)
+{
+  m_prefix.reserve (components);
+}
+
 Name::iterator
 Name::begin ()
 {
+  m_serializedSize = 0; // components can be modified via iterator
   return m_prefix.begin ();
 }
 
@@ -252,6 +312,7 @@ Name::begin () const
 Name::iterator
 Name::end ()
 {
+  m_serializedSize = 0; // components can be modified via iterator
   return m_prefix.end ();
 }
 
@@ -288,6 +349,8 @@ Name::Add (const T &value)
   std::ostringstream os;
   os << value;
   m_prefix.push_back (os.str ());
+  if (m_serializedSize != 0)
+    m_serializedSize += 2 + m_prefix.back ().size ();
 
   return *this;
 }
@@ -0,0 +1,280 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil -*- */
+/*
+ * Copyright (c) 2011 University of California, Los Angeles
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ * Author: Alexander Afanasyev <alexander.afanasyev@ucla.edu>
+ */
+
+#include "ndn-nonce-filter.h"
+
+#include "ns3/ndn-name.h"
+
+#include "ns3/log.h"
+#include "ns3/simulator.h"
+#include "ns3/uinteger.h"
+#include "ns3/double.h"
+
+#include <math.h>
+#include <algorithm>
+#include <boost/foreach.hpp>
+#include <boost/functional/hash.hpp>
+
+NS_LOG_COMPONENT_DEFINE ("ndn.NonceFilter");
+
+namespace ns3 {
+namespace ndn {
+
+NS_OBJECT_ENSURE_REGISTERED (NonceFilter);
+
+TypeId
+NonceFilter::GetTypeId ()
+{
+  static TypeId tid = TypeId ("ns3::ndn::NonceFilter")
+    .SetGroupName ("Ndn")
+    .SetParent<Object> ()
+    .AddConstructor<NonceFilter> ()
+
+    .AddAttribute ("Lifetime", "Time during which seen nonces are remembered (should be positive)",
+                   TimeValue (Seconds (6.0)),
+                   MakeTimeAccessor (&NonceFilter::SetLifetime,
+                                     &NonceFilter::GetLifetime),
+                   MakeTimeChecker ())
+
+    .AddAttribute ("Buckets", "Number of buckets (nonces are forgotten in Lifetime/Buckets steps)",
+                   UintegerValue (4),
+                   MakeUintegerAccessor (&NonceFilter::SetBuckets,
+                                         &NonceFilter::GetBuckets),
+                   MakeUintegerChecker<uint32_t> (1))
+
+    .AddAttribute ("Capacity", "Expected number of nonces seen during Lifetime/Buckets period of time",
+                   UintegerValue (10000),
+                   MakeUintegerAccessor (&NonceFilter::SetCapacity,
+                                         &NonceFilter::GetCapacity),
+                   MakeUintegerChecker<uint32_t> (1))
+
+    .AddAttribute ("FalsePositiveRate", "Target probability that a new nonce is reported as already seen",
+                   DoubleValue (0.0001),
+                   MakeDoubleAccessor (&NonceFilter::SetFalsePositiveRate,
+                                       &NonceFilter::GetFalsePositiveRate),
+                   MakeDoubleChecker<double> (0.0, 1.0))
+
+    .AddAttribute ("MemoryUsage", "Get number of bytes used by the filter",
+                   TypeId::ATTR_GET,
+                   UintegerValue (0),
+                   MakeUintegerAccessor (&NonceFilter::GetMemoryUsage),
+                   MakeUintegerChecker<uint32_t> ())
+    ;
+  return tid;
+}
+
+NonceFilter::NonceFilter ()
+  : m_capacity (10000)
+  , m_falsePositiveRate (0.0001)
+  , m_nBuckets (4)
+  , m_nBits (0)
+  , m_nHashes (0)
+  , m_current (0)
+{
+}
+
+NonceFilter::~NonceFilter ()
+{
+}
+
+bool
+NonceFilter::Add (const Name &name, uint32_t nonce)
+{
+  Rotate ();
+
+  uint64_t hash = Hash (name, nonce);
+  for (uint32_t i = 0; i < m_buckets.size (); i++)
+    {
+      if (Check (m_buckets[i], hash))
+        return false;
+    }
+
+  std::vector<uint64_t> &bucket = m_buckets[m_current];
+  uint32_t h1 = static_cast<uint32_t> (hash);
+  uint32_t h2 = static_cast<uint32_t> (hash >> 32) | 1;
+  for (uint32_t i = 0; i < m_nHashes; i++)
+    {
+      uint32_t bit = (h1 + i * h2) % m_nBits;
+      bucket[bit >> 6] |= static_cast<uint64_t> (1) << (bit & 63);
+    }
+
+  return true;
+}
+
+bool
+NonceFilter::Contains (const Name &name, uint32_t nonce)
+{
+  Rotate ();
+
+  uint64_t hash = Hash (name, nonce);
+  for (uint32_t i = 0; i < m_buckets.size (); i++)
+    {
+      if (Check (m_buckets[i], hash))
+        return true;
+    }
+  return false;
+}
+
+uint32_t
+NonceFilter::GetMemoryUsage () const
+{
+  return m_buckets.size () * ((m_nBits + 63) / 64) * sizeof (uint64_t);
+}
+
+void
+NonceFilter::SetLifetime (const Time &lifetime)
+{
+  if (!lifetime.IsStrictlyPositive ())
+    {
+      NS_FATAL_ERROR ("Lifetime of the nonce filter should be positive (" << lifetime << " is specified)");
+    }
+
+  m_lifetime = lifetime;
+  m_buckets.clear (); // will be reallocated on the next use
+}
+
+Time
+NonceFilter::GetLifetime () const
+{
+  return m_lifetime;
+}
+
+void
+NonceFilter::SetCapacity (uint32_t capacity)
+{
+  m_capacity = capacity;
+  m_buckets.clear (); // will be reallocated on the next use
+}
+
+uint32_t
+NonceFilter::GetCapacity () const
+{
+  return m_capacity;
+}
+
+void
+NonceFilter::SetFalsePositiveRate (double rate)
+{
+  m_falsePositiveRate = rate;
+  m_buckets.clear (); // will be reallocated on the next use
+}
+
+double
+NonceFilter::GetFalsePositiveRate () const
+{
+  return m_falsePositiveRate;
+}
+
+void
+NonceFilter::SetBuckets (uint32_t buckets)
+{
+  m_nBuckets = buckets;
+  m_buckets.clear (); // will be reallocated on the next use
+}
+
+uint32_t
+NonceFilter::GetBuckets () const
+{
+  return m_nBuckets;
+}
+
+void
+NonceFilter::Reset ()
+{
+  // each bucket should be used at least for one time unit, otherwise nonces would be remembered longer than Lifetime
+  uint32_t nBuckets = static_cast<uint32_t> (std::min<int64_t> (m_nBuckets, m_lifetime.GetTimeStep ()));
+  m_period = Time (m_lifetime.GetTimeStep () / nBuckets);
+
+  // nonce is checked against all buckets, so false positive rate of each bucket should be proportionally lower
+  double bucketRate = std::max (m_falsePositiveRate / nBuckets, 1e-12);
+
+  m_nBits = static_cast<uint32_t> (ceil (-1.0 * m_capacity * log (bucketRate) / (log (2.0) * log (2.0))));
+  m_nBits = std::max<uint32_t> (m_nBits, 64);
+  m_nHashes = static_cast<uint32_t> (round (static_cast<double> (m_nBits) / m_capacity * log (2.0)));
+  m_nHashes = std::max<uint32_t> (m_nHashes, 1);
+
+  NS_LOG_DEBUG ("Buckets: " << nBuckets << ", bits per bucket: " << m_nBits << ", hashes: " << m_nHashes);
+
+  m_buckets.assign (nBuckets, std::vector<uint64_t> ((m_nBits + 63) / 64, 0));
+  m_current = 0;
+  m_currentStart = Simulator::Now ();
+}
+
+void
+NonceFilter::Rotate ()
+{
+  if (m_buckets.empty ())
+    {
+      Reset ();
+      return;
+    }
+
+  Time now = Simulator::Now ();
+  if (now - m_currentStart >= m_lifetime)
+    {
+      // everything is stale
+      for (uint32_t i = 0; i < m_buckets.size (); i++)
+        {
+          std::fill (m_buckets[i].begin (), m_buckets[i].end (), 0);
+        }
+      m_currentStart = now;
+      return;
+    }
+
+  while (now - m_currentStart >= m_period)
+    {
+      m_current = (m_current + 1) % m_buckets.size ();
+      std::fill (m_buckets[m_current].begin (), m_buckets[m_current].end (), 0);
+      m_currentStart += m_period;
+    }
+}
+
+bool
+NonceFilter::Check (const std::vector<uint64_t> &bucket, uint64_t hash) const
+{
+  uint32_t h1 = static_cast<uint32_t> (hash);
+  uint32_t h2 = static_cast<uint32_t> (hash >> 32) | 1;
+  for (uint32_t i = 0; i < m_nHashes; i++)
+    {
+      uint32_t bit = (h1 + i * h2) % m_nBits;
+      if ((bucket[bit >> 6] & (static_cast<uint64_t> (1) << (bit & 63))) == 0)
+        return false;
+    }
+  return true;
+}
+
+uint64_t
+NonceFilter::Hash (const Name &name, uint32_t nonce)
+{
+  std::size_t seed = 0;
+  BOOST_FOREACH (const std::string &component, name)
+    {
+      boost::hash_combine (seed, component);
+    }
+
+  // mix name hash and nonce (splitmix64 finalizer)
+  uint64_t hash = static_cast<uint64_t> (seed) ^ (static_cast<uint64_t> (nonce) * 0x9E3779B97F4A7C15ULL);
+  hash = (hash ^ (hash >> 30)) * 0xBF58476D1CE4E5B9ULL;
+  hash = (hash ^ (hash >> 27)) * 0x94D049BB133111EBULL;
+  return hash ^ (hash >> 31);
+}
+
+} // namespace ndn
+} // namespace ns3
@@ -0,0 +1,151 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil -*- */
+/*
+ * Copyright (c) 2011 University of California, Los Angeles
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ * Author: Alexander Afanasyev <alexander.afanasyev@ucla.edu>
+ */
+
+#ifndef _NDN_NONCE_FILTER_H_
+#define _NDN_NONCE_FILTER_H_
+
+#include "ns3/object.h"
+#include "ns3/nstime.h"
+
+#include <vector>
+
+namespace ns3 {
+namespace ndn {
+
+class Name;
+
+/**
+ * @ingroup ndn
+ * @brief Per-node filter of recently seen (name, nonce) pairs, used to detect looped Interests
+ *
+ * Unlike nonces recorded in PIT entries, nonces in the filter are remembered for the configured
+ * lifetime, independent from the lifetime of the PIT entry.
+ *
+ * The filter is a ring of Bloom filters (buckets), each accumulating nonces during Lifetime/Buckets
+ * period of time.  When the period is over, the oldest bucket is cleared and reused.
+ * Memory usage is determined by Capacity (expected number of nonces seen during one period),
+ * FalsePositiveRate (probability that a fresh nonce is reported as duplicate) and number of buckets.
+ */
+class NonceFilter : public Object
+{
+public:
+  /**
+   * \brief Interface ID
+   *
+   * \return interface ID
+   */
+  static TypeId
+  GetTypeId ();
+
+  /**
+   * @brief Default constructor
+   */
+  NonceFilter ();
+
+  /**
+   * @brief Virtual destructor
+   */
+  virtual
+  ~NonceFilter ();
+
+  /**
+   * @brief Record (name, nonce) pair in the filter
+   * @returns false if pair (most likely) has been seen before, true otherwise
+   */
+  bool
+  Add (const Name &name, uint32_t nonce);
+
+  /**
+   * @brief Check if (name, nonce) pair (most likely) has been seen before
+   */
+  bool
+  Contains (const Name &name, uint32_t nonce);
+
+  /**
+   * @brief Get number of bytes used by the filter
+   */
+  uint32_t
+  GetMemoryUsage () const;
+
+private:
+  void
+  SetLifetime (const Time &lifetime);
+
+  Time
+  GetLifetime () const;
+
+  void
+  SetCapacity (uint32_t capacity);
+
+  uint32_t
+  GetCapacity () const;
+
+  void
+  SetFalsePositiveRate (double rate);
+
+  double
+  GetFalsePositiveRate () const;
+
+  void
+  SetBuckets (uint32_t buckets);
+
+  uint32_t
+  GetBuckets () const;
+
+  /**
+   * @brief Allocate buckets according to the current parameters (all recorded nonces are lost)
+   */
+  void
+  Reset ();
+
+  /**
+   * @brief Clear buckets that became stale since the last call
+   */
+  void
+  Rotate ();
+
+  /**
+   * @brief Check if the bucket has all bits for the hash set
+   */
+  bool
+  Check (const std::vector<uint64_t> &bucket, uint64_t hash) const;
+
+  static uint64_t
+  Hash (const Name &name, uint32_t nonce);
+
+private:
+  uint32_t m_capacity;        ///< @brief Expected number of nonces per bucket
+  double m_falsePositiveRate; ///< @brief Target false positive rate of the whole filter
+  uint32_t m_nBuckets;        ///< @brief Number of buckets (fewer are used if Lifetime is shorter than Buckets time units)
+  Time m_lifetime;            ///< @brief How long nonces are remembered
+
+  uint32_t m_nBits;   ///< @brief Number of bits in each bucket
+  uint32_t m_nHashes; ///< @brief Number of hash functions
+
+  std::vector< std::vector<uint64_t> > m_buckets; ///< @brief Ring of Bloom filters
+  Time m_period;                ///< @brief Period of time during which nonces are recorded to one bucket
+  uint32_t m_current;           ///< @brief Index of the bucket to which nonces are recorded
+  Time m_currentStart;          ///< @brief Time when recording to the current bucket started
+};
+
+} // namespace ndn
+} // namespace ns3
+
+#endif // _NDN_NONCE_FILTER_H_
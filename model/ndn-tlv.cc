@@ -0,0 +1,309 @@
+/* -*- Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil -*- */
+/*
+ * Copyright (c) 2013 University of California, Los Angeles
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ * Author: Alexander Afanasyev <alexander.afanasyev@ucla.edu>
+ */
+
+#include "ndn-tlv.h"
+
+#include "ndn-name.h"
+#include "ndn-exclusion.h"
+
+#include "ns3/log.h"
+
+#include <string.h>
+
+NS_LOG_COMPONENT_DEFINE ("ndn.tlv");
+
+namespace ns3 {
+namespace ndn {
+namespace tlv {
+
+namespace {
+
+const char HEX_DIGITS[] = "0123456789ABCDEF";
+const uint32_t BINARY_HASH_SIZE = HASH_SIZE / 2;
+
+/**
+ * @brief Get value of the uppercase hex digit (-1 if character is not a hex digit)
+ */
+int
+HexDigitValue (char c)
+{
+  if (c >= '0' && c <= '9')
+    return c - '0';
+  if (c >= 'A' && c <= 'F')
+    return c - 'A' + 10;
+  return -1;
+}
+
+/**
+ * @brief Check if hash can be encoded in binary form without loss
+ */
+bool
+IsHexHash (const char *hash)
+{
+  for (uint32_t i = 0; i < HASH_SIZE; i++)
+    {
+      if (HexDigitValue (hash[i]) < 0)
+        return false;
+    }
+  return true;
+}
+
+uint32_t
+SizeOfNameValue (const Name &name)
+{
+  uint32_t length = 0;
+  for (Name::const_iterator component = name.begin (); component != name.end (); component++)
+    {
+      length += SizeOfBlock (NAME_COMPONENT, component->size ());
+    }
+  return length;
+}
+
+} // namespace
+
+uint32_t
+SizeOfVarNumber (uint64_t number)
+{
+  if (number < 253)
+    return 1;
+  else if (number <= 0xFFFF)
+    return 3;
+  else if (number <= 0xFFFFFFFF)
+    return 5;
+  else
+    return 9;
+}
+
+void
+WriteVarNumber (Buffer::Iterator &i, uint64_t number)
+{
+  if (number < 253)
+    {
+      i.WriteU8 (static_cast<uint8_t> (number));
+    }
+  else if (number <= 0xFFFF)
+    {
+      i.WriteU8 (253);
+      i.WriteHtonU16 (static_cast<uint16_t> (number));
+    }
+  else if (number <= 0xFFFFFFFF)
+    {
+      i.WriteU8 (254);
+      i.WriteHtonU32 (static_cast<uint32_t> (number));
+    }
+  else
+    {
+      i.WriteU8 (255);
+      i.WriteHtonU64 (number);
+    }
+}
+
+uint64_t
+ReadVarNumber (Buffer::Iterator &i)
+{
+  uint8_t first = i.ReadU8 ();
+  if (first < 253)
+    return first;
+  else if (first == 253)
+    return i.ReadNtohU16 ();
+  else if (first == 254)
+    return i.ReadNtohU32 ();
+  else
+    return i.ReadNtohU64 ();
+}
+
+uint32_t
+SizeOfBlock (uint32_t type, uint64_t length)
+{
+  return SizeOfVarNumber (type) + SizeOfVarNumber (length) + length;
+}
+
+void
+WriteBlockHeader (Buffer::Iterator &i, uint32_t type, uint64_t length)
+{
+  WriteVarNumber (i, type);
+  WriteVarNumber (i, length);
+}
+
+uint32_t
+SizeOfNonNegativeInteger (uint64_t value)
+{
+  if (value <= 0xFF)
+    return 1;
+  else if (value <= 0xFFFF)
+    return 2;
+  else if (value <= 0xFFFFFFFF)
+    return 4;
+  else
+    return 8;
+}
+
+void
+WriteNonNegativeInteger (Buffer::Iterator &i, uint32_t type, uint64_t value)
+{
+  uint32_t length = SizeOfNonNegativeInteger (value);
+  WriteBlockHeader (i, type, length);
+
+  switch (length)
+    {
+    case 1:
+      i.WriteU8 (static_cast<uint8_t> (value));
+      break;
+    case 2:
+      i.WriteHtonU16 (static_cast<uint16_t> (value));
+      break;
+    case 4:
+      i.WriteHtonU32 (static_cast<uint32_t> (value));
+      break;
+    default:
+      i.WriteHtonU64 (value);
+      break;
+    }
+}
+
+uint64_t
+ReadNonNegativeInteger (Buffer::Iterator &i, uint64_t length)
+{
+  switch (length)
+    {
+    case 1:
+      return i.ReadU8 ();
+    case 2:
+      return i.ReadNtohU16 ();
+    case 4:
+      return i.ReadNtohU32 ();
+    case 8:
+      return i.ReadNtohU64 ();
+    default:
+      NS_LOG_DEBUG ("Invalid length of non-negative integer: " << length);
+      i.Next (length);
+      return 0;
+    }
+}
+
+uint32_t
+SizeOfName (const Name &name)
+{
+  return SizeOfBlock (NAME, SizeOfNameValue (name));
+}
+
+void
+WriteName (Buffer::Iterator &i, const Name &name)
+{
+  WriteBlockHeader (i, NAME, SizeOfNameValue (name));
+
+  for (Name::const_iterator component = name.begin (); component != name.end (); component++)
+    {
+      WriteBlockHeader (i, NAME_COMPONENT, component->size ());
+      i.Write (reinterpret_cast<const uint8_t*> (component->c_str ()), component->size ());
+    }
+}
+
+Ptr<Name>
+ReadName (Buffer::Iterator &i, uint64_t length)
+{
+  Ptr<Name> name = Create<Name> ();
+
+  // count components first, so they are stored without reallocations
+  Buffer::Iterator scan = i;
+  size_t nComponents = 0;
+  while (scan.GetDistanceFrom (i) < length)
+    {
+      uint64_t type = ReadVarNumber (scan);
+      scan.Next (ReadVarNumber (scan));
+      if (type == NAME_COMPONENT)
+        nComponents++;
+    }
+  name->reserve (nComponents);
+
+  Buffer::Iterator start = i;
+  while (i.GetDistanceFrom (start) < length)
+    {
+      uint64_t type = ReadVarNumber (i);
+      uint64_t componentLength = ReadVarNumber (i);
+      if (type != NAME_COMPONENT)
+        {
+          i.Next (componentLength);
+          continue;
+        }
+
+      name->AppendComponent (i, componentLength);
+    }
+
+  return name;
+}
+
+uint32_t
+SizeOfHash (uint32_t type, const char *hash)
+{
+  if (hash[0] == 0)
+    return 0;
+
+  return SizeOfBlock (type, IsHexHash (hash) ? BINARY_HASH_SIZE : HASH_SIZE);
+}
+
+void
+WriteHash (Buffer::Iterator &i, uint32_t type, const char *hash)
+{
+  if (hash[0] == 0)
+    return;
+
+  if (!IsHexHash (hash))
+    {
+      WriteBlockHeader (i, type, HASH_SIZE);
+      i.Write (reinterpret_cast<const uint8_t*> (hash), HASH_SIZE);
+      return;
+    }
+
+  WriteBlockHeader (i, type, BINARY_HASH_SIZE);
+  for (uint32_t pos = 0; pos < HASH_SIZE; pos += 2)
+    {
+      i.WriteU8 (static_cast<uint8_t> ((HexDigitValue (hash[pos]) << 4) | HexDigitValue (hash[pos + 1])));
+    }
+}
+
+void
+ReadHash (Buffer::Iterator &i, uint64_t length, char *hash)
+{
+  memset (hash, 0, HASH_SIZE + 1);
+
+  if (length == BINARY_HASH_SIZE)
+    {
+      for (uint32_t pos = 0; pos < HASH_SIZE; pos += 2)
+        {
+          uint8_t octet = i.ReadU8 ();
+          hash[pos]     = HEX_DIGITS[octet >> 4];
+          hash[pos + 1] = HEX_DIGITS[octet & 0x0F];
+        }
+    }
+  else if (length == HASH_SIZE)
+    {
+      i.Read (reinterpret_cast<uint8_t*> (hash), HASH_SIZE);
+    }
+  else
+    {
+      NS_LOG_DEBUG ("Invalid length of the hash: " << length);
+      i.Next (length);
+    }
+}
+
+} // namespace tlv
+} // namespace ndn
+} // namespace ns3
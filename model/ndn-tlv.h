@@ -0,0 +1,183 @@
+/* -*- Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil -*- */
+/*
+ * Copyright (c) 2013 University of California, Los Angeles
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ * Author: Alexander Afanasyev <alexander.afanasyev@ucla.edu>
+ */
+
+#ifndef _NDN_TLV_H_
+#define _NDN_TLV_H_
+
+#include "ns3/ptr.h"
+#include "ns3/buffer.h"
+
+namespace ns3 {
+namespace ndn {
+
+class Name;
+
+/**
+ * @brief Helpers for compact TLV wire format (NDN-TLV style)
+ *
+ * Each element is encoded as Type, Length, Value, where Type and Length are variable-length
+ * numbers (1, 3, 5, or 9 octets):
+ *
+ *   - number < 253:          1 octet
+ *   - number <= 0xFFFF:      0xFD followed by 2 octets (network order)
+ *   - number <= 0xFFFFFFFF:  0xFE followed by 4 octets (network order)
+ *   - otherwise:             0xFF followed by 8 octets (network order)
+ *
+ * Interest ::= INTEREST-TYPE TLV-LENGTH
+ *                HopCount?     (4 octets)
+ *                Name
+ *                Selectors?    (Exclude with CONTENT-HASH for each excluded content object)
+ *                Nonce
+ *                Scope?
+ *                InterestLifetime? (milliseconds)
+ *                Nack?
+ *
+ * Data     ::= DATA-TYPE TLV-LENGTH
+ *                HopCount?     (4 octets)
+ *                Name
+ *                MetaInfo      (FreshnessPeriod? (milliseconds), Timestamp (milliseconds))
+ *                SignatureValue?
+ *                ContentHash?
+ *              <payload>
+ *
+ * Unlike NDN-TLV, payload of the Data packet is not a part of the TLV block, so the header
+ * can be encoded independently from the payload (same as in ndnSIM wire format).
+ * SHA-1 digests represented as 40-character hex strings are encoded as 20 binary octets.
+ * HopCount has a fixed size and is always the first element of the block, so Face can increment
+ * it in place, without decoding or changing the size of the header.
+ */
+namespace tlv {
+
+/**
+ * @brief TLV types
+ */
+enum
+  {
+    INTEREST          = 0x05,
+    DATA              = 0x06,
+    NAME              = 0x07,
+    NAME_COMPONENT    = 0x08,
+    SELECTORS         = 0x09,
+    NONCE             = 0x0A,
+    SCOPE             = 0x0B,
+    INTEREST_LIFETIME = 0x0C,
+    EXCLUDE           = 0x10,
+    META_INFO         = 0x14,
+    SIGNATURE_VALUE   = 0x17,
+    FRESHNESS_PERIOD  = 0x19,
+
+    // ndnSIM-specific types
+    NACK              = 0x80,
+    TIMESTAMP         = 0x81,
+    CONTENT_HASH      = 0x82,
+    HOP_COUNT         = 0x83
+  };
+
+/**
+ * @brief Get number of octets necessary to encode variable-length number
+ */
+uint32_t
+SizeOfVarNumber (uint64_t number);
+
+/**
+ * @brief Write variable-length number and advance the iterator
+ */
+void
+WriteVarNumber (Buffer::Iterator &i, uint64_t number);
+
+/**
+ * @brief Read variable-length number and advance the iterator
+ */
+uint64_t
+ReadVarNumber (Buffer::Iterator &i);
+
+/**
+ * @brief Get size of the whole TLV block with value of the specified length
+ */
+uint32_t
+SizeOfBlock (uint32_t type, uint64_t length);
+
+/**
+ * @brief Write type and length of TLV block and advance the iterator
+ */
+void
+WriteBlockHeader (Buffer::Iterator &i, uint32_t type, uint64_t length);
+
+/**
+ * @brief Get number of octets (1, 2, 4, or 8) necessary to encode non-negative integer
+ */
+uint32_t
+SizeOfNonNegativeInteger (uint64_t value);
+
+/**
+ * @brief Write the whole TLV block with non-negative integer value
+ */
+void
+WriteNonNegativeInteger (Buffer::Iterator &i, uint32_t type, uint64_t value);
+
+/**
+ * @brief Read value of non-negative integer (block header should be already read)
+ */
+uint64_t
+ReadNonNegativeInteger (Buffer::Iterator &i, uint64_t length);
+
+/**
+ * @brief Get size of the whole Name TLV block
+ */
+uint32_t
+SizeOfName (const Name &name);
+
+/**
+ * @brief Write the whole Name TLV block
+ */
+void
+WriteName (Buffer::Iterator &i, const Name &name);
+
+/**
+ * @brief Read value of Name TLV block (block header should be already read)
+ */
+Ptr<Name>
+ReadName (Buffer::Iterator &i, uint64_t length);
+
+/**
+ * @brief Get size of the whole TLV block with the hash (0, if hash is empty)
+ * @param hash hash (HASH_SIZE characters, usually hex representation of the digest)
+ */
+uint32_t
+SizeOfHash (uint32_t type, const char *hash);
+
+/**
+ * @brief Write the whole TLV block with the hash (nothing is written if hash is empty)
+ */
+void
+WriteHash (Buffer::Iterator &i, uint32_t type, const char *hash);
+
+/**
+ * @brief Read value of the hash TLV block (block header should be already read)
+ * @param hash buffer for the hash (at least HASH_SIZE + 1 characters)
+ */
+void
+ReadHash (Buffer::Iterator &i, uint64_t length, char *hash);
+
+} // namespace tlv
+} // namespace ndn
+} // namespace ns3
+
+#endif // _NDN_TLV_H_
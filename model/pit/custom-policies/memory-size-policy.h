@@ -0,0 +1,193 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2011 University of California, Los Angeles
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ * Author: Alexander Afanasyev <alexander.afanasyev@ucla.edu>
+ */
+
+#ifndef MEMORY_SIZE_POLICY_H_
+#define MEMORY_SIZE_POLICY_H_
+
+#include <boost/intrusive/options.hpp>
+#include <boost/intrusive/list.hpp>
+
+namespace ns3 {
+namespace ndn {
+namespace ndnSIM {
+
+/**
+ * @brief Traits for policy that limits PIT by the number of bytes actually allocated for entries
+ *
+ * Size of each entry includes the trie node, the PIT entry object, stored Interest (name and exclusion list),
+ * nonces, face records, and forwarding strategy tags.  Intermediate trie nodes without payload
+ * (shared by several entries) are not accounted.
+ *
+ * When a new entry does not fit, the least recently used entries (entries that were not created or
+ * changed for the longest time) are evicted until it does.  The new entry is rejected only if it alone
+ * exceeds the limit.
+ */
+struct memory_size_policy_traits
+{
+  /// @brief Name that can be used to identify the policy (for NS-3 object model and logging)
+  static std::string GetName () { return "MemorySize"; }
+
+  struct policy_hook_type : public boost::intrusive::list_member_hook<> { uint32_t size; };
+
+  template<class Container>
+  struct container_hook
+  {
+    typedef boost::intrusive::member_hook< Container,
+                                           policy_hook_type,
+                                           &Container::policy_hook_ > type;
+  };
+
+  template<class Base,
+           class Container,
+           class Hook>
+  struct policy
+  {
+    static uint32_t& get_size (typename Container::iterator item)
+    {
+      return static_cast<typename policy_container::value_traits::hook_type*>
+        (policy_container::value_traits::to_node_ptr(*item))->size;
+    }
+
+    static const uint32_t& get_size (typename Container::const_iterator item)
+    {
+      return static_cast<const typename policy_container::value_traits::hook_type*>
+        (policy_container::value_traits::to_node_ptr(*item))->size;
+    }
+
+    static uint32_t memory_usage (typename Container::const_iterator item)
+    {
+      return item->memory_usage ()
+        + sizeof (*item->payload ())
+        + item->payload ()->GetMemoryUsage ();
+    }
+
+    typedef typename boost::intrusive::list< Container, Hook > policy_container;
+
+    // could be just typedef
+    class type : public policy_container
+    {
+    public:
+      typedef Container parent_trie;
+
+      type (Base &base)
+        : base_ (base)
+        , max_size_ (0) // size in bytes, unlimited by default
+        , current_space_used_ (0)
+      {
+      }
+
+      inline void
+      update (typename parent_trie::iterator item)
+      {
+        // in case size got changed
+        current_space_used_ -= get_size (item);
+        get_size (item) = memory_usage (item);
+        current_space_used_ += get_size (item); // this operation can violate policy constraint, which
+                                                // will be enforced when the next entry is inserted
+
+        // entry has been used, do relocation
+        policy_container::splice (policy_container::end (),
+                                  *this,
+                                  policy_container::s_iterator_to (*item));
+      }
+
+      inline bool
+      insert (typename parent_trie::iterator item)
+      {
+        uint32_t entrySize = memory_usage (item);
+
+        if (max_size_ != 0)
+          {
+            if (entrySize > max_size_)
+              {
+                // entry would not fit even in the empty PIT
+                return false;
+              }
+
+            while (current_space_used_ + entrySize > max_size_)
+              {
+                base_.erase (&(*policy_container::begin ()));
+              }
+          }
+
+        get_size (item) = entrySize;
+        current_space_used_ += entrySize;
+
+        policy_container::push_back (*item);
+        return true;
+      }
+
+      inline void
+      lookup (typename parent_trie::iterator item)
+      {
+        // do nothing
+      }
+
+      inline void
+      erase (typename parent_trie::iterator item)
+      {
+        current_space_used_ -= get_size (item);
+        policy_container::erase (policy_container::s_iterator_to (*item));
+
+        // entry can outlive the trie node, make sure its size is not updated anymore
+        item->payload ()->SetTrie (0);
+      }
+
+      inline void
+      clear ()
+      {
+        policy_container::clear ();
+        current_space_used_ = 0;
+      }
+
+      inline void
+      set_max_size (size_t max_size)
+      {
+        max_size_ = max_size;
+      }
+
+      inline size_t
+      get_max_size () const
+      {
+        return max_size_;
+      }
+
+      inline uint32_t
+      get_current_space_used () const
+      {
+        return current_space_used_;
+      }
+
+    private:
+      type () : base_(*((Base*)0)) { };
+
+    private:
+      Base &base_;
+      uint32_t max_size_;
+      uint32_t current_space_used_;
+    };
+  };
+};
+
+} // ndnSIM
+} // ndn
+} // ns3
+
+#endif // MEMORY_SIZE_POLICY_H_
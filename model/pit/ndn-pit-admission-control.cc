@@ -0,0 +1,149 @@
+/* -*- Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil -*- */
+/*
+ * Copyright (c) 2011 University of California, Los Angeles
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ * Author: Alexander Afanasyev <alexander.afanasyev@ucla.edu>
+ */
+
+#include "ndn-pit-admission-control.h"
+
+#include "ns3/ndn-pit-entry.h"
+#include "ns3/ndn-fib-entry.h"
+#include "ns3/ndn-face.h"
+
+#include "ns3/log.h"
+#include "ns3/uinteger.h"
+
+NS_LOG_COMPONENT_DEFINE ("ndn.pit.AdmissionControl");
+
+namespace ns3 {
+namespace ndn {
+namespace pit {
+
+NS_OBJECT_ENSURE_REGISTERED (AdmissionControl);
+
+TypeId
+AdmissionControl::GetTypeId ()
+{
+  static TypeId tid = TypeId ("ns3::ndn::pit::AdmissionControl")
+    .SetGroupName ("Ndn")
+    .SetParent<Object> ()
+    .AddConstructor<AdmissionControl> ()
+
+    .AddAttribute ("MaxEntriesPerFace",
+                   "Maximum number of PIT entries in which a face can be recorded as incoming. If 0, limit is not enforced",
+                   UintegerValue (0),
+                   MakeUintegerAccessor (&AdmissionControl::m_maxPerFace),
+                   MakeUintegerChecker<uint32_t> ())
+
+    .AddAttribute ("MaxEntriesPerPrefix",
+                   "Maximum number of pending PIT entries that belong to the same FIB prefix. If 0, limit is not enforced",
+                   UintegerValue (0),
+                   MakeUintegerAccessor (&AdmissionControl::m_maxPerPrefix),
+                   MakeUintegerChecker<uint32_t> ())
+    ;
+  return tid;
+}
+
+AdmissionControl::AdmissionControl ()
+  : m_maxPerFace (0)
+  , m_maxPerPrefix (0)
+{
+}
+
+AdmissionControl::~AdmissionControl ()
+{
+}
+
+bool
+AdmissionControl::CanAdmit (Ptr<Face> face, Ptr<Entry> pitEntry, Ptr<fib::Entry> fibEntry) const
+{
+  if (pitEntry != 0)
+    {
+      if (pitEntry->GetIncoming ().find (face) != pitEntry->GetIncoming ().end ())
+        return true; // face is already accounted for this entry
+
+      fibEntry = pitEntry->GetFibEntry ();
+    }
+
+  if (m_maxPerFace != 0 && GetFaceUsage (face) >= m_maxPerFace)
+    {
+      NS_LOG_DEBUG ("Face " << face->GetId () << " exceeded its PIT quota (" << m_maxPerFace << ")");
+      return false;
+    }
+
+  bool newPending = (pitEntry == 0 || pitEntry->GetIncoming ().empty ());
+  if (m_maxPerPrefix != 0 && newPending && fibEntry != 0 && GetPrefixUsage (fibEntry) >= m_maxPerPrefix)
+    {
+      NS_LOG_DEBUG ("Prefix " << fibEntry->GetPrefix () << " exceeded its PIT quota (" << m_maxPerPrefix << ")");
+      return false;
+    }
+
+  return true;
+}
+
+void
+AdmissionControl::DidAddIncoming (Entry &pitEntry, Ptr<Face> face)
+{
+  m_faceCounters[face->GetId ()] ++;
+
+  if (pitEntry.GetIncoming ().size () == 1) // the first incoming face, entry became pending
+    {
+      m_prefixCounters[PeekPointer (pitEntry.GetFibEntry ())] ++;
+    }
+}
+
+void
+AdmissionControl::DidRemoveIncoming (Entry &pitEntry, Ptr<Face> face)
+{
+  face_counters::iterator faceCounter = m_faceCounters.find (face->GetId ());
+  NS_ASSERT (faceCounter != m_faceCounters.end ());
+  if (-- faceCounter->second == 0)
+    m_faceCounters.erase (faceCounter);
+
+  if (pitEntry.GetIncoming ().empty ()) // the last incoming face, entry is no longer pending
+    {
+      prefix_counters::iterator prefixCounter =
+        m_prefixCounters.find (PeekPointer (pitEntry.GetFibEntry ()));
+      NS_ASSERT (prefixCounter != m_prefixCounters.end ());
+      if (-- prefixCounter->second == 0)
+        m_prefixCounters.erase (prefixCounter);
+    }
+}
+
+uint32_t
+AdmissionControl::GetFaceUsage (Ptr<Face> face) const
+{
+  face_counters::const_iterator counter = m_faceCounters.find (face->GetId ());
+  if (counter == m_faceCounters.end ())
+    return 0;
+  else
+    return counter->second;
+}
+
+uint32_t
+AdmissionControl::GetPrefixUsage (Ptr<fib::Entry> fibEntry) const
+{
+  prefix_counters::const_iterator counter = m_prefixCounters.find (PeekPointer (fibEntry));
+  if (counter == m_prefixCounters.end ())
+    return 0;
+  else
+    return counter->second;
+}
+
+} // namespace pit
+} // namespace ndn
+} // namespace ns3
@@ -0,0 +1,130 @@
+/* -*- Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil -*- */
+/*
+ * Copyright (c) 2011 University of California, Los Angeles
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ * Author: Alexander Afanasyev <alexander.afanasyev@ucla.edu>
+ */
+
+#ifndef _NDN_PIT_ADMISSION_CONTROL_H_
+#define _NDN_PIT_ADMISSION_CONTROL_H_
+
+#include "ns3/object.h"
+#include "ns3/ptr.h"
+
+#include <map>
+
+namespace ns3 {
+namespace ndn {
+
+class Face;
+
+namespace fib {
+class Entry;
+}
+
+namespace pit {
+
+class Entry;
+
+/**
+ * @ingroup ndn
+ * @brief Optional PIT admission controller, bounding number of pending entries per incoming face and per FIB prefix
+ *
+ * Counters are maintained incrementally by PIT entries (each time incoming face record is added or removed),
+ * so admission check is just a couple of map lookups.  Forwarding strategy checks admission before
+ * a new incoming face record is created and calls ForwardingStrategy::DidExceedPitQuota if the
+ * Interest is not admitted.
+ *
+ * Controller is enabled when aggregated to the node before PIT (see StackHelper::EnablePitQuotas)
+ */
+class AdmissionControl : public Object
+{
+public:
+  /**
+   * \brief Interface ID
+   *
+   * \return interface ID
+   */
+  static TypeId
+  GetTypeId ();
+
+  /**
+   * @brief Default constructor
+   */
+  AdmissionControl ();
+
+  /**
+   * @brief Virtual destructor
+   */
+  virtual
+  ~AdmissionControl ();
+
+  /**
+   * @brief Check if Interest from the face can be recorded in PIT
+   *
+   * @param face     incoming face of the Interest
+   * @param pitEntry existing PIT entry for the Interest (0 if entry is not yet created)
+   * @param fibEntry FIB entry for the Interest (used only when PIT entry does not exist yet)
+   *
+   * Interest is always admitted if the face is already recorded as incoming in the PIT entry
+   */
+  bool
+  CanAdmit (Ptr<Face> face, Ptr<Entry> pitEntry, Ptr<fib::Entry> fibEntry) const;
+
+  /**
+   * @brief Notify controller that new incoming face record has been added to the PIT entry
+   *
+   * Should be called by pit::Entry after the record has been added
+   */
+  void
+  DidAddIncoming (Entry &pitEntry, Ptr<Face> face);
+
+  /**
+   * @brief Notify controller that incoming face record has been removed from the PIT entry
+   *
+   * Should be called by pit::Entry after the record has been removed
+   */
+  void
+  DidRemoveIncoming (Entry &pitEntry, Ptr<Face> face);
+
+  /**
+   * @brief Get number of PIT entries in which the face is recorded as incoming
+   */
+  uint32_t
+  GetFaceUsage (Ptr<Face> face) const;
+
+  /**
+   * @brief Get number of PIT entries with non-empty list of incoming faces that belong to the FIB prefix
+   */
+  uint32_t
+  GetPrefixUsage (Ptr<fib::Entry> fibEntry) const;
+
+private:
+  uint32_t m_maxPerFace;   ///< @brief Maximum number of pending entries per incoming face (0 means no limit)
+  uint32_t m_maxPerPrefix; ///< @brief Maximum number of pending entries per FIB prefix (0 means no limit)
+
+  typedef std::map<uint32_t, uint32_t> face_counters; ///< @brief face ID => number of pending entries
+  typedef std::map<const fib::Entry*, uint32_t> prefix_counters; ///< @brief FIB entry => number of pending entries
+
+  face_counters m_faceCounters;
+  prefix_counters m_prefixCounters;
+};
+
+} // namespace pit
+} // namespace ndn
+} // namespace ns3
+
+#endif // _NDN_PIT_ADMISSION_CONTROL_H_
@@ -51,6 +51,10 @@ public:
   virtual ~EntryImpl ()
   {
     CONTAINER.i_time.erase (Pit::time_index::s_iterator_to (*this));
+
+    // entry could have been evicted by the replacement policy, bypassing PIT
+    if (CONTAINER.m_nameTree != 0)
+      CONTAINER.m_nameTree->RemovePitEntry (this->GetPrefix (), this);
     
     CONTAINER.RescheduleCleaning ();
   }
@@ -75,6 +79,66 @@ public:
     CONTAINER.RescheduleCleaning ();
   }
   
+  virtual void
+  AddSeenNonce (uint32_t nonce)
+  {
+    super::AddSeenNonce (nonce);
+    CONTAINER.DidChangeEntrySize (*this);
+  }
+
+  virtual in_iterator
+  AddIncoming (Ptr<Face> face)
+  {
+    in_iterator ret = super::AddIncoming (face);
+    CONTAINER.DidChangeEntrySize (*this);
+    return ret;
+  }
+
+  virtual void
+  RemoveIncoming (Ptr<Face> face)
+  {
+    super::RemoveIncoming (face);
+    CONTAINER.DidChangeEntrySize (*this);
+  }
+
+  virtual void
+  ClearIncoming ()
+  {
+    super::ClearIncoming ();
+    CONTAINER.DidChangeEntrySize (*this);
+  }
+
+  virtual out_iterator
+  AddOutgoing (Ptr<Face> face)
+  {
+    out_iterator ret = super::AddOutgoing (face);
+    CONTAINER.DidChangeEntrySize (*this);
+    return ret;
+  }
+
+  virtual void
+  ClearOutgoing ()
+  {
+    super::ClearOutgoing ();
+    CONTAINER.DidChangeEntrySize (*this);
+  }
+
+  virtual void
+  RemoveAllReferencesToFace (Ptr<Face> face)
+  {
+    super::RemoveAllReferencesToFace (face);
+    CONTAINER.DidChangeEntrySize (*this);
+  }
+
+protected:
+  virtual void
+  DidChangeFwTags ()
+  {
+    super::DidChangeFwTags ();
+    CONTAINER.DidChangeEntrySize (*this);
+  }
+
+public:
   // to make sure policies work
   void
   SetTrie (typename Pit::super::iterator item) { item_ = item; }
@@ -21,9 +21,11 @@
 #include "ndn-pit-entry.h"
 
 #include "ns3/ndn-pit.h"
+#include "ndn-pit-admission-control.h"
 #include "ns3/ndn-fib.h"
 #include "ns3/ndn-name.h"
 #include "ns3/ndn-interest.h"
+#include "ns3/ndn-exclusion.h"
 
 #include "ns3/simulator.h"
 #include "ns3/log.h"
@@ -59,6 +61,13 @@ Entry::Entry (Pit &container,
 Entry::~Entry ()
 {
   NS_LOG_FUNCTION (GetPrefix ());
+
+  if (m_container.m_admissionControl != 0)
+    {
+      // entry could be removed while still pending (e.g., evicted by the replacement policy)
+      while (!m_incoming.empty ())
+        EraseIncoming (m_incoming.begin ());
+    }
 }
 
 void
@@ -120,19 +129,42 @@ Entry::AddIncoming (Ptr<Face> face)
 
   // NS_ASSERT_MSG (ret.second, "Something is wrong");
 
+  if (ret.second && m_container.m_admissionControl != 0)
+    m_container.m_admissionControl->DidAddIncoming (*this, face);
+
   return ret.first;
 }
 
 void
 Entry::RemoveIncoming (Ptr<Face> face)
 {
-  m_incoming.erase (face);
+  in_iterator incoming = m_incoming.find (face);
+
+  if (incoming != m_incoming.end ())
+    EraseIncoming (incoming);
 }
 
 void
 Entry::ClearIncoming ()
 {
-  m_incoming.clear ();
+  if (m_container.m_admissionControl == 0)
+    {
+      m_incoming.clear ();
+      return;
+    }
+
+  while (!m_incoming.empty ())
+    EraseIncoming (m_incoming.begin ());
+}
+
+void
+Entry::EraseIncoming (in_iterator incoming)
+{
+  Ptr<Face> face = incoming->m_face;
+  m_incoming.erase (incoming);
+
+  if (m_container.m_admissionControl != 0)
+    m_container.m_admissionControl->DidRemoveIncoming (*this, face);
 }
 
 Entry::out_iterator
@@ -163,7 +195,7 @@ Entry::RemoveAllReferencesToFace (Ptr<Face> face)
   in_iterator incoming = m_incoming.find (face);
 
   if (incoming != m_incoming.end ())
-    m_incoming.erase (incoming);
+    EraseIncoming (incoming);
 
   out_iterator outgoing =
     m_outgoing.find (face);
@@ -270,6 +302,56 @@ Entry::GetInterest () const
   return m_interest;
 }
 
+namespace
+{
+/// @brief Approximate overhead of a red-black tree node (color, parent, left and right pointers)
+const uint32_t SET_NODE_OVERHEAD = 4 * sizeof (void*);
+
+/// @brief Approximate overhead of reference counter allocated together with shared object
+const uint32_t SHARED_COUNT_OVERHEAD = 2 * sizeof (void*) + 2 * sizeof (long);
+
+/// @brief Memory of the string outside of the string object
+inline uint32_t
+StringHeapUsage (const std::string &str)
+{
+  // short strings are stored inside the object (small string optimization)
+  return str.capacity () >= sizeof (std::string) ? str.capacity () + 1 : 0;
+}
+}
+
+uint32_t
+Entry::GetMemoryUsage () const
+{
+  uint32_t size = 0;
+
+  if (m_interest != 0)
+    {
+      size += sizeof (Interest) + sizeof (Name);
+      size += m_interest->GetName ().GetComponents ().capacity () * sizeof (std::string);
+      BOOST_FOREACH (const std::string &component, m_interest->GetName ())
+        {
+          size += StringHeapUsage (component);
+        }
+
+      // empty exclusion filter is shared between all Interests
+      if (m_interest->GetExclusionPtr () != 0 && m_interest->GetExclusionPtr ()->size () > 0)
+        size += sizeof (Exclusion);
+    }
+
+  size += m_seenNonces.size () * (SET_NODE_OVERHEAD + sizeof (nonce_container::value_type));
+  size += m_incoming.size ()   * (SET_NODE_OVERHEAD + sizeof (in_container::value_type));
+  size += m_outgoing.size ()   * (SET_NODE_OVERHEAD + sizeof (out_container::value_type));
+
+  size += m_fwTags.capacity () * sizeof (fw_tag_container::value_type);
+  BOOST_FOREACH (const fw_tag_container::value_type &tag, m_fwTags)
+    {
+      if (tag)
+        size += SHARED_COUNT_OVERHEAD + sizeof (fw::Tag);
+    }
+
+  return size;
+}
+
 std::ostream& operator<< (std::ostream& os, const Entry &entry)
 {
   os << "Prefix: " << entry.GetPrefix () << "\n";
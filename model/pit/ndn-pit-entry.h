@@ -28,6 +28,7 @@
 
 #include "ns3/ndn-pit-entry-incoming-face.h"
 #include "ns3/ndn-pit-entry-outgoing-face.h"
+#include "ns3/ndn-fw-tag.h"
 
 #include <boost/multi_index_container.hpp>
 #include <boost/multi_index/tag.hpp>
@@ -37,6 +38,7 @@
 #include <boost/multi_index/member.hpp>
 // #include <boost/multi_index/mem_fun.hpp>
 #include <set>
+#include <vector>
 #include <boost/shared_ptr.hpp>
 
 namespace ns3 {
@@ -44,8 +46,6 @@ namespace ndn {
 
 class Pit;
 
-namespace fw { class Tag; }
-
 namespace pit {
 
 /// @cond include_hidden
@@ -100,6 +100,8 @@ public:
 
   typedef std::set< uint32_t > nonce_container;  ///< @brief nonce container type
 
+  typedef std::vector< boost::shared_ptr<fw::Tag> > fw_tag_container; ///< @brief forwarding strategy tag container type (indexed by tag slot)
+
   /**
    * \brief PIT entry constructor
    * \param prefix Prefix of the PIT entry
@@ -270,19 +272,38 @@ public:
 
   /**
    * @brief Add new forwarding strategy tag
+   *
+   * Tag is stored in the slot of its dynamic type (slot is determined at runtime).
+   * If tag of the same type already exists, it will be replaced
    */
   inline void
   AddFwTag (boost::shared_ptr< fw::Tag > tag);
 
+  /**
+   * @brief Add new forwarding strategy tag
+   *
+   * Tag is stored in the slot of type T (slot is determined once per type), so T must be the exact
+   * type of the tag.  If tag of the same type already exists, it will be replaced.
+   *
+   * Tags should be created using fw::MakeTag<T> (), which places the tag and reference counter in
+   * one pooled memory block
+   */
+  template<class T>
+  inline void
+  AddFwTag (boost::shared_ptr< T > tag);
+
   /**
    * @brief Get forwarding strategy tag (tag is not removed)
+   *
+   * Only the slot of type T is checked: tags of types derived from T are stored in their own slots
+   * and are not returned
    */
   template<class T>
   inline boost::shared_ptr< T >
   GetFwTag ();
 
   /**
-   * @brief Remove the forwarding strategy tag
+   * @brief Remove the forwarding strategy tag of type T (tags of derived types are not affected)
    */
   template<class T>
   inline void
@@ -294,10 +315,37 @@ public:
   Ptr<const Interest>
   GetInterest () const;
 
+  /**
+   * @brief Get approximate number of bytes allocated by the entry
+   *
+   * Includes the stored Interest (with name and exclusion list), nonces, incoming/outgoing face
+   * records and forwarding strategy tags.  Size of the entry object itself (sizeof) and
+   * the container structures (e.g., trie node) are not included.
+   */
+  uint32_t
+  GetMemoryUsage () const;
+
 private:
   friend std::ostream& operator<< (std::ostream& os, const Entry &entry);
 
+  inline void
+  SetFwTag (uint32_t slot, boost::shared_ptr< fw::Tag > tag);
+
+  /**
+   * @brief Remove incoming face record and notify PIT admission control (if any)
+   */
+  void
+  EraseIncoming (in_iterator incoming);
+
 protected:
+  /**
+   * @brief Notification that forwarding strategy tag has been added or removed
+   *
+   * Used by PIT implementations to keep memory accounting of the entry up to date
+   */
+  virtual void
+  DidChangeFwTags () { }
+
   Pit &m_container; ///< @brief Reference to the container (to rearrange indexes, if necessary)
 
   Ptr<const Interest> m_interest; ///< \brief Interest of the PIT entry (if several interests are received, then nonce is from the first Interest)
@@ -312,7 +360,7 @@ protected:
   Time m_lastRetransmission; ///< @brief Last time when number of retransmissions were increased
   uint32_t m_maxRetxCount;   ///< @brief Maximum allowed number of retransmissions via outgoing faces
 
-  std::list< boost::shared_ptr<fw::Tag> > m_fwTags; ///< @brief Forwarding strategy tags
+  fw_tag_container m_fwTags; ///< @brief Forwarding strategy tags (position in the container is the slot of the tag type)
 };
 
 struct EntryIsNotEmpty
@@ -326,68 +374,55 @@ struct EntryIsNotEmpty
 
 std::ostream& operator<< (std::ostream& os, const Entry &entry);
 
+inline void
+Entry::SetFwTag (uint32_t slot, boost::shared_ptr< fw::Tag > tag)
+{
+  if (slot >= m_fwTags.size ())
+    {
+      m_fwTags.resize (slot + 1);
+    }
+
+  m_fwTags[slot] = tag;
+  DidChangeFwTags ();
+}
+
 inline void
 Entry::AddFwTag (boost::shared_ptr< fw::Tag > tag)
 {
-  m_fwTags.push_back (tag);
+  SetFwTag (fw::Tag::GetSlot (typeid (*tag)), tag);
+}
+
+template<class T>
+inline void
+Entry::AddFwTag (boost::shared_ptr< T > tag)
+{
+  NS_ASSERT_MSG (typeid (*tag) == typeid (T), "Tag should be added using its exact type");
+  SetFwTag (fw::TagSlot<T>::Get (), tag);
 }
 
-/**
- * @brief Get and remove forwarding strategy tag
- */
 template<class T>
 inline boost::shared_ptr< T >
 Entry::GetFwTag ()
 {
-  for (std::list< boost::shared_ptr<fw::Tag> >::iterator item = m_fwTags.begin ();
-       item != m_fwTags.end ();
-       item ++)
+  uint32_t slot = fw::TagSlot<T>::Get ();
+  if (slot < m_fwTags.size ())
     {
-      boost::shared_ptr< T > retPtr = boost::dynamic_pointer_cast<T> (*item);
-      if (retPtr != boost::shared_ptr< T > ())
-        {
-          return retPtr;
-        }
+      // only tags of type T can be stored in this slot
+      return boost::static_pointer_cast< T > (m_fwTags[slot]);
     }
 
   return boost::shared_ptr< T > ();
 }
 
-// /**
-//  * @brief Peek the forwarding strategy tag
-//  */
-// template<class T>
-// inline boost::shared_ptr< const T >
-// Entry::PeekFwTag () const
-// {
-//   for (std::list< boost::shared_ptr<fw::Tag> >::const_iterator item = m_fwTags.begin ();
-//        item != m_fwTags.end ();
-//        item ++)
-//     {
-//       boost::shared_ptr< const T > retPtr = boost::dynamic_pointer_cast<const T> (*item);
-//       if (retPtr != 0)
-//         {
-//           return retPtr;
-//         }
-//     }
-
-//   return 0;
-// }
-
 template<class T>
 inline void
 Entry::RemoveFwTag ()
 {
-  for (std::list< boost::shared_ptr<fw::Tag> >::iterator item = m_fwTags.begin ();
-       item != m_fwTags.end ();
-       item ++)
+  uint32_t slot = fw::TagSlot<T>::Get ();
+  if (slot < m_fwTags.size () && m_fwTags[slot] != 0)
     {
-      boost::shared_ptr< T > retPtr = boost::dynamic_pointer_cast< T > (*item);
-      if (retPtr != boost::shared_ptr< T > ())
-        {
-          m_fwTags.erase (item);
-          return;
-        }
+      m_fwTags[slot].reset ();
+      DidChangeFwTags ();
     }
 }
 
@@ -32,6 +32,7 @@
 NS_LOG_COMPONENT_DEFINE ("ndn.pit.PitImpl");
 
 #include "custom-policies/serialized-size-policy.h"
+#include "custom-policies/memory-size-policy.h"
 
 #include "ns3/string.h"
 #include "ns3/uinteger.h"
@@ -67,6 +68,23 @@ PitImpl<serialized_size_policy_traits>::GetCurrentSize () const
   return super::getPolicy ().get_current_space_used ();
 }
 
+template<>
+uint32_t
+PitImpl<memory_size_policy_traits>::GetCurrentSize () const
+{
+  return super::getPolicy ().get_current_space_used ();
+}
+
+template<>
+void
+PitImpl<memory_size_policy_traits>::DidChangeEntrySize (entry &item)
+{
+  if (item.to_iterator () == 0) // entry is no longer in PIT
+    return;
+
+  super::getPolicy ().update (item.to_iterator ());
+}
+
 //////////////////////////////////////////////////////////////////////////////////////////
 //////////////////////////////////////////////////////////////////////////////////////////
 //////////////////////////////////////////////////////////////////////////////////////////
@@ -76,11 +94,13 @@ template class PitImpl<persistent_policy_traits>;
 template class PitImpl<random_policy_traits>;
 template class PitImpl<lru_policy_traits>;
 template class PitImpl<serialized_size_policy_traits>;
+template class PitImpl<memory_size_policy_traits>;
 
 NS_OBJECT_ENSURE_REGISTERED_TEMPL(PitImpl, persistent_policy_traits);
 NS_OBJECT_ENSURE_REGISTERED_TEMPL(PitImpl, random_policy_traits);
 NS_OBJECT_ENSURE_REGISTERED_TEMPL(PitImpl, lru_policy_traits);
 NS_OBJECT_ENSURE_REGISTERED_TEMPL(PitImpl, serialized_size_policy_traits);
+NS_OBJECT_ENSURE_REGISTERED_TEMPL(PitImpl, memory_size_policy_traits);
 
 
 typedef multi_policy_traits< boost::mpl::vector2< persistent_policy_traits,
@@ -126,6 +146,12 @@ class Lru : public PitImpl<lru_policy_traits> { };
  */
 class SerializedSize : public PitImpl<serialized_size_policy_traits> { };
 
+/**
+ * @brief PIT implementation where size of PIT is based on memory actually allocated for PIT entries in bytes (MaxSize parameter).
+ * When PIT reaches its limit, the largest entries are removed
+ */
+class MemorySize : public PitImpl<memory_size_policy_traits> { };
+
 #endif
 
 } // namespace pit
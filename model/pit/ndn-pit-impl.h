@@ -28,6 +28,7 @@
 
 #include "../../utils/trie/trie-with-policy.h"
 #include "ndn-pit-entry-impl.h"
+#include "../ndn-name-tree.h"
 
 #include "ns3/ndn-interest.h"
 #include "ns3/ndn-content-object.h"
@@ -92,6 +93,9 @@ public:
   virtual Ptr<Entry>
   Create (Ptr<const Interest> header);
 
+  virtual Ptr<Entry>
+  Create (Ptr<const Interest> header, Ptr<fib::Entry> fibEntry);
+
   virtual void
   MarkErased (Ptr<Entry> entry);
 
@@ -134,10 +138,19 @@ private:
   uint32_t
   GetCurrentSize () const;
 
+  /**
+   * @brief Notify PIT that the entry has changed its memory footprint (e.g., new incoming face added)
+   *
+   * Does nothing, unless policy depends on the entry size
+   */
+  void
+  DidChangeEntrySize (entry &item);
+
 private:
   EventId m_cleanEvent;
   Ptr<Fib> m_fib; ///< \brief Link to FIB table
   Ptr<ForwardingStrategy> m_forwardingStrategy;
+  Ptr<NameTree> m_nameTree; ///< \brief Link to the unified name tree (if enabled)
 
   static LogComponent g_log; ///< @brief Logging variable
 
@@ -194,6 +207,12 @@ PitImpl<Policy>::GetCurrentSize () const
   return super::getPolicy ().size ();
 }
 
+template<class Policy>
+void
+PitImpl<Policy>::DidChangeEntrySize (entry &item)
+{
+}
+
 template<class Policy>
 PitImpl<Policy>::PitImpl ()
 {
@@ -230,6 +249,10 @@ PitImpl<Policy>::NotifyNewAggregate ()
     {
       m_forwardingStrategy = GetObject<ForwardingStrategy> ();
     }
+  if (m_nameTree == 0)
+    {
+      m_nameTree = GetObject<NameTree> ();
+    }
 
   Pit::NotifyNewAggregate ();
 }
@@ -242,6 +265,7 @@ PitImpl<Policy>::DoDispose ()
 
   m_forwardingStrategy = 0;
   m_fib = 0;
+  m_nameTree = 0;
 
   Pit::DoDispose ();
 }
@@ -283,6 +307,8 @@ PitImpl<Policy>::CleanExpired ()
       if (entry->GetExpireTime () <= now) // is the record stale?
         {
           m_forwardingStrategy->WillEraseTimedOutPendingInterest (entry->to_iterator ()->payload ());
+          if (m_nameTree != 0)
+            m_nameTree->RemovePitEntry (entry->GetPrefix (), &(*entry));
           super::erase (entry->to_iterator ());
           // count ++;
         }
@@ -347,7 +373,13 @@ Ptr<Entry>
 PitImpl<Policy>::Create (Ptr<const Interest> header)
 {
   NS_LOG_DEBUG (header->GetName ());
-  Ptr<fib::Entry> fibEntry = m_fib->LongestPrefixMatch (*header);
+  return Create (header, m_fib->LongestPrefixMatch (*header));
+}
+
+template<class Policy>
+Ptr<Entry>
+PitImpl<Policy>::Create (Ptr<const Interest> header, Ptr<fib::Entry> fibEntry)
+{
   if (fibEntry == 0)
     return 0;
 
@@ -362,6 +394,8 @@ PitImpl<Policy>::Create (Ptr<const Interest> header)
       if (result.second)
         {
           newEntry->SetTrie (result.first);
+          if (m_nameTree != 0)
+            m_nameTree->SetPitEntry (header->GetName (), newEntry);
           return newEntry;
         }
       else
@@ -382,6 +416,8 @@ PitImpl<Policy>::MarkErased (Ptr<Entry> item)
 {
   if (this->m_PitEntryPruningTimout.IsZero ())
     {
+      if (m_nameTree != 0)
+        m_nameTree->RemovePitEntry (item->GetPrefix (), PeekPointer (item));
       super::erase (StaticCast< entry > (item)->to_iterator ());
     }
   else
@@ -19,6 +19,7 @@
  */
 
 #include "ndn-pit.h"
+#include "ndn-pit-admission-control.h"
 
 #include "ns3/ndn-interest.h"
 #include "ns3/ndn-content-object.h"
@@ -70,5 +71,30 @@ Pit::~Pit ()
 {
 }
 
+void
+Pit::NotifyNewAggregate ()
+{
+  if (m_admissionControl == 0)
+    {
+      m_admissionControl = GetObject<pit::AdmissionControl> ();
+    }
+
+  Object::NotifyNewAggregate ();
+}
+
+void
+Pit::DoDispose ()
+{
+  m_admissionControl = 0;
+
+  Object::DoDispose ();
+}
+
+Ptr<pit::Entry>
+Pit::Create (Ptr<const Interest> header, Ptr<fib::Entry> fibEntry)
+{
+  return Create (header);
+}
+
 } // namespace ndn
 } // namespace ns3
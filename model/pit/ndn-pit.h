@@ -30,6 +30,10 @@
 namespace ns3 {
 namespace ndn {
 
+namespace pit {
+class AdmissionControl;
+}
+
 class L3Protocol;
 class Face;
 class ContentObject;
@@ -108,6 +112,19 @@ public:
   virtual Ptr<pit::Entry>
   Create (Ptr<const Interest> header) = 0;
 
+  /**
+   * @brief Creates a PIT entry for the given interest, using already known FIB entry
+   * @param header parsed interest header
+   * @param fibEntry FIB entry with the longest prefix match for the interest name
+   *        (e.g., resolved by the NameTree). If 0, entry will not be created
+   * @returns iterator to Pit entry. If record could not be created (e.g., limit reached),
+   *          return end() iterator
+   *
+   * Default implementation ignores fibEntry and calls Create (header)
+   */
+  virtual Ptr<pit::Entry>
+  Create (Ptr<const Interest> header, Ptr<fib::Entry> fibEntry);
+
   /**
    * @brief Mark PIT entry deleted
    * @param entry PIT entry
@@ -172,11 +189,20 @@ public:
   inline void
   SetMaxPitEntryLifetime (const Time &maxLifetime);
 
+protected:
+  // inherited from Object class
+  virtual void NotifyNewAggregate (); ///< @brief Even when object is aggregated to another Object
+  virtual void DoDispose (); ///< @brief Do cleanup
+
 protected:
   // configuration variables. Check implementation of GetTypeId for more details
   Time m_PitEntryPruningTimout;
 
   Time m_maxPitEntryLifetime;
+
+  Ptr<pit::AdmissionControl> m_admissionControl; ///< \brief Per-face and per-prefix quotas (optional)
+
+  friend class pit::Entry;
 };
 
 ///////////////////////////////////////////////////////////////////////////////
@@ -151,4 +151,61 @@ FibEntryTest::DoRun ()
   NS_TEST_ASSERT_MSG_EQ (recorders.front ()->count, 2, "two events should have been reported");
 }
 
+static const ndn::fib::FaceMetric &
+GetRecord (Ptr<ndn::fib::Entry> entry, Ptr<ndn::Face> face)
+{
+  ndn::fib::FaceMetricList::const_iterator record = entry->m_faces.find (face);
+  NS_ASSERT (record != entry->m_faces.end ());
+  return *record;
+}
+
+void
+FibEntryReorderTest::DoRun ()
+{
+  Ptr<Node> node = CreateObject<Node> ();
+  NodeContainer neighbors;
+  neighbors.Create (3);
+
+  PointToPointHelper p2p;
+  for (uint32_t i = 0; i < neighbors.GetN (); i++)
+    {
+      p2p.Install (node, neighbors.Get (i));
+    }
+
+  ndn::StackHelper ndn;
+  ndn.Install (node);
+
+  Ptr<ndn::L3Protocol> l3 = node->GetObject<ndn::L3Protocol> ();
+  Ptr<ndn::Face> faceA = l3->GetFace (0);
+  Ptr<ndn::Face> faceB = l3->GetFace (1);
+  Ptr<ndn::Face> faceC = l3->GetFace (2);
+
+  Ptr<ndn::Fib> fib = node->GetObject<ndn::Fib> ();
+  fib->Add (ndn::Name ("/reorder"), faceA, 5);
+  fib->Add (ndn::Name ("/reorder"), faceC, 3);
+  Ptr<ndn::fib::Entry> entry = fib->Add (ndn::Name ("/reorder"), faceB, 10);
+
+  entry->UpdateStatus (faceC, ndn::fib::FaceMetric::NDN_FIB_RED);
+  entry->Invalidate (faceB);
+
+  // order is A (yellow, 5), C (red, 3), B (red, max)
+  NS_TEST_ASSERT_MSG_EQ (entry->FindBestCandidate (0).GetFace (), faceA, "A should be the best next hop");
+  NS_TEST_ASSERT_MSG_EQ (entry->FindBestCandidate (2).GetFace (), faceB, "B should be the worst next hop");
+
+  // B jumps over both records
+  entry->AddOrUpdateRoutingMetric (faceB, 1);
+
+  NS_TEST_ASSERT_MSG_EQ (GetRecord (entry, faceB).GetStatus (), ndn::fib::FaceMetric::NDN_FIB_YELLOW, "B should become yellow");
+  NS_TEST_ASSERT_MSG_EQ (GetRecord (entry, faceB).GetRoutingCost (), 1, "B should get the new cost");
+  NS_TEST_ASSERT_MSG_EQ (GetRecord (entry, faceC).GetStatus (), ndn::fib::FaceMetric::NDN_FIB_RED, "C should stay red");
+  NS_TEST_ASSERT_MSG_EQ (GetRecord (entry, faceC).GetRoutingCost (), 3, "cost of C should not change");
+  NS_TEST_ASSERT_MSG_EQ (GetRecord (entry, faceA).GetStatus (), ndn::fib::FaceMetric::NDN_FIB_YELLOW, "A should stay yellow");
+
+  NS_TEST_ASSERT_MSG_EQ (entry->FindBestCandidate (0).GetFace (), faceB, "B should be the best next hop");
+  NS_TEST_ASSERT_MSG_EQ (entry->FindBestCandidate (1).GetFace (), faceA, "A should be the second next hop");
+  NS_TEST_ASSERT_MSG_EQ (entry->FindBestCandidate (2).GetFace (), faceC, "C should be the last next hop");
+
+  Simulator::Destroy ();
+}
+
 }
@@ -43,6 +43,18 @@ private:
   virtual void DoRun ();
 };
 
+class FibEntryReorderTest : public TestCase
+{
+public:
+  FibEntryReorderTest ()
+    : TestCase ("FIB entry reorder test")
+  {
+  }
+
+private:
+  virtual void DoRun ();
+};
+
 }
 
 #endif // NDNSIM_TEST_FIB_ENTRY_H
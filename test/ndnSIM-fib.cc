@@ -0,0 +1,294 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2011-2013 University of California, Los Angeles
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ * Author: Alexander Afanasyev <alexander.afanasyev@ucla.edu>
+ */
+
+#include "ndnSIM-fib.h"
+#include "ns3/core-module.h"
+#include "ns3/ndnSIM-module.h"
+#include "ns3/point-to-point-module.h"
+
+#include "ns3/ndnSIM/model/fw/flooding.h"
+
+#include <boost/foreach.hpp>
+
+NS_LOG_COMPONENT_DEFINE ("ndn.FibTest");
+
+namespace ns3
+{
+
+namespace
+{
+
+/**
+ * @brief Deterministic pseudo-random number generator, so test results are reproducible
+ */
+uint32_t
+NextRandom (uint32_t &seed)
+{
+  seed = seed * 1103515245 + 12345;
+  return (seed >> 16) & 0x7fff;
+}
+
+ndn::Name
+RandomName (uint32_t &seed, uint32_t maxLength)
+{
+  static const char *components[] = { "a", "b", "c" };
+
+  ndn::Name name;
+  uint32_t length = NextRandom (seed) % (maxLength + 1);
+  for (uint32_t i = 0; i < length; i++)
+    {
+      name.Add (std::string (components[NextRandom (seed) % 3]));
+    }
+  return name;
+}
+
+/**
+ * @brief Forwarding strategy that records sizes of FIB entry batches
+ */
+class BulkCountingStrategy : public ndn::fw::Flooding
+{
+public:
+  static TypeId
+  GetTypeId ()
+  {
+    static TypeId tid = TypeId ("ns3::ndn::fw::test::BulkCountingStrategy")
+      .SetParent<ndn::fw::Flooding> ()
+      .AddConstructor<BulkCountingStrategy> ()
+      ;
+    return tid;
+  }
+
+  virtual void
+  DidAddFibEntries (const std::vector< Ptr<ndn::fib::Entry> > &fibEntries)
+  {
+    m_batches.push_back (fibEntries.size ());
+    ndn::fw::Flooding::DidAddFibEntries (fibEntries);
+  }
+
+  std::vector<size_t> m_batches;
+};
+
+NS_OBJECT_ENSURE_REGISTERED (BulkCountingStrategy);
+
+int32_t
+GetRoutingCost (Ptr<ndn::Fib> fib, const std::string &prefix, Ptr<ndn::Face> face)
+{
+  Ptr<ndn::fib::Entry> entry = fib->Find (ndn::Name (prefix));
+  if (entry == 0)
+    return -1;
+
+  ndn::fib::FaceMetricList::const_iterator record = entry->m_faces.get<ndn::fib::i_face> ().find (face);
+  if (record == entry->m_faces.get<ndn::fib::i_face> ().end ())
+    return -1;
+
+  return record->GetRoutingCost ();
+}
+
+}
+
+void
+FibHashLpmTest::Compare (Ptr<ndn::Fib> expected, Ptr<ndn::Fib> actual, const std::vector<ndn::Name> &names, const std::string &stage)
+{
+  NS_TEST_ASSERT_MSG_EQ (actual->GetSize (), expected->GetSize (), stage << ": FIBs should have the same number of entries");
+
+  BOOST_FOREACH (const ndn::Name &name, names)
+    {
+      ndn::Interest interest;
+      interest.SetName (Create<ndn::Name> (name));
+
+      Ptr<ndn::fib::Entry> expectedMatch = expected->LongestPrefixMatch (interest);
+      Ptr<ndn::fib::Entry> actualMatch = actual->LongestPrefixMatch (interest);
+
+      NS_TEST_ASSERT_MSG_EQ ((actualMatch == 0), (expectedMatch == 0), stage << ": match for " << name);
+      if (expectedMatch != 0 && actualMatch != 0)
+        {
+          NS_TEST_ASSERT_MSG_EQ (actualMatch->GetPrefix (), expectedMatch->GetPrefix (), stage << ": match for " << name);
+        }
+    }
+}
+
+void
+FibHashLpmTest::DoRun ()
+{
+  NodeContainer nodes;
+  nodes.Create (3);
+
+  // two faces on both nodes
+  PointToPointHelper p2p;
+  p2p.Install (nodes.Get (0), nodes.Get (2));
+  p2p.Install (nodes.Get (0), nodes.Get (2));
+  p2p.Install (nodes.Get (1), nodes.Get (2));
+  p2p.Install (nodes.Get (1), nodes.Get (2));
+
+  ndn::StackHelper ndn;
+  ndn.Install (nodes.Get (0));
+  ndn.Install (nodes.Get (2));
+
+  ndn::StackHelper ndnHashLpm;
+  ndnHashLpm.SetFib ("ns3::ndn::fib::HashLpm");
+  ndnHashLpm.Install (nodes.Get (1));
+
+  Ptr<ndn::Fib> expected = nodes.Get (0)->GetObject<ndn::Fib> ();
+  Ptr<ndn::Fib> actual = nodes.Get (1)->GetObject<ndn::Fib> ();
+
+  Ptr<ndn::L3Protocol> expectedNdn = nodes.Get (0)->GetObject<ndn::L3Protocol> ();
+  Ptr<ndn::L3Protocol> actualNdn = nodes.Get (1)->GetObject<ndn::L3Protocol> ();
+
+  uint32_t seed = 1;
+  std::vector<ndn::Name> queries;
+  for (uint32_t i = 0; i < 500; i++)
+    {
+      queries.push_back (RandomName (seed, 8));
+    }
+
+  std::vector<ndn::Name> prefixes;
+  for (uint32_t i = 0; i < 60; i++)
+    {
+      ndn::Name prefix = RandomName (seed, 5);
+      uint32_t face = NextRandom (seed) % 2;
+      expected->Add (prefix, expectedNdn->GetFace (face), 1);
+      actual->Add (prefix, actualNdn->GetFace (face), 1);
+      prefixes.push_back (prefix);
+    }
+  Compare (expected, actual, queries, "Initial");
+
+  for (uint32_t i = 0; i < 20; i++)
+    {
+      Ptr<const ndn::Name> prefix = Create<ndn::Name> (prefixes[NextRandom (seed) % prefixes.size ()]);
+      expected->Remove (prefix);
+      actual->Remove (prefix);
+    }
+  Compare (expected, actual, queries, "Remove");
+
+  for (uint32_t i = 0; i < 20; i++)
+    {
+      ndn::Name prefix = RandomName (seed, 5);
+      uint32_t face = NextRandom (seed) % 2;
+      expected->Add (prefix, expectedNdn->GetFace (face), 1);
+      actual->Add (prefix, actualNdn->GetFace (face), 1);
+      Compare (expected, actual, queries, "Add");
+    }
+
+  // prefix longer than the current search range
+  ndn::Name longPrefix;
+  for (uint32_t i = 0; i < 9; i++)
+    {
+      longPrefix.Add (std::string ("a"));
+    }
+  expected->Add (longPrefix, expectedNdn->GetFace (0), 1);
+  actual->Add (longPrefix, actualNdn->GetFace (0), 1);
+  queries.push_back (longPrefix);
+  Compare (expected, actual, queries, "Add long prefix");
+
+  expected->RemoveFromAll (expectedNdn->GetFace (1));
+  actual->RemoveFromAll (actualNdn->GetFace (1));
+  Compare (expected, actual, queries, "RemoveFromAll");
+
+  expected->RemoveFromAll (expectedNdn->GetFace (0));
+  actual->RemoveFromAll (actualNdn->GetFace (0));
+  NS_TEST_ASSERT_MSG_EQ (actual->GetSize (), 0, "All entries should be removed");
+  Compare (expected, actual, queries, "Empty");
+
+  Simulator::Destroy ();
+}
+
+void
+FibAddBulkTest::DoRun ()
+{
+  NodeContainer nodes;
+  nodes.Create (2);
+
+  PointToPointHelper p2p;
+  p2p.Install (nodes.Get (0), nodes.Get (1));
+  p2p.Install (nodes.Get (0), nodes.Get (1));
+
+  ndn::StackHelper ndnHelper;
+  ndnHelper.SetForwardingStrategy ("ns3::ndn::fw::test::BulkCountingStrategy");
+  ndnHelper.Install (nodes);
+
+  Ptr<ndn::L3Protocol> l3 = nodes.Get (0)->GetObject<ndn::L3Protocol> ();
+  Ptr<ndn::Face> face0 = l3->GetFace (0);
+  Ptr<ndn::Face> face1 = l3->GetFace (1);
+  Ptr<ndn::Fib> fib = nodes.Get (0)->GetObject<ndn::Fib> ();
+  Ptr<BulkCountingStrategy> strategy = nodes.Get (0)->GetObject<BulkCountingStrategy> ();
+  NS_TEST_ASSERT_MSG_NE (strategy, 0, "forwarding strategy should be installed");
+
+  // unsorted, with duplicate prefixes (the last route for the same face wins, as with Fib::Add)
+  ndn::fib::RouteList routes;
+  routes.push_back (ndn::fib::Route (Create<ndn::Name> ("/a/b"), face0, 5));
+  routes.push_back (ndn::fib::Route (Create<ndn::Name> ("/c"), face0, 1));
+  routes.push_back (ndn::fib::Route (Create<ndn::Name> ("/a"), face1, 2));
+  routes.push_back (ndn::fib::Route (Create<ndn::Name> ("/a/b"), face1, 3));
+  routes.push_back (ndn::fib::Route (Create<ndn::Name> ("/a/b/c"), face0, 4));
+  routes.push_back (ndn::fib::Route (Create<ndn::Name> ("/a/b"), face0, 1));
+  fib->AddBulk (routes);
+
+  NS_TEST_ASSERT_MSG_EQ (fib->GetSize (), 4, "duplicate prefixes should share FIB entry");
+  NS_TEST_ASSERT_MSG_EQ (strategy->m_batches.size (), 1, "strategy should be notified once per batch");
+  NS_TEST_ASSERT_MSG_EQ (strategy->m_batches.back (), 4, "strategy should be notified about all new entries");
+
+  NS_TEST_ASSERT_MSG_EQ (GetRoutingCost (fib, "/a/b", face0), 1, "the last of duplicate routes should win");
+  NS_TEST_ASSERT_MSG_EQ (GetRoutingCost (fib, "/a/b", face1), 3, "routes via different faces should be merged");
+  NS_TEST_ASSERT_MSG_EQ (GetRoutingCost (fib, "/a", face1), 2, "route for /a");
+  NS_TEST_ASSERT_MSG_EQ (GetRoutingCost (fib, "/a", face0), -1, "/a should not have a route via face 0");
+  NS_TEST_ASSERT_MSG_EQ (GetRoutingCost (fib, "/a/b/c", face0), 4, "route for /a/b/c");
+  NS_TEST_ASSERT_MSG_EQ (GetRoutingCost (fib, "/c", face0), 1, "route for /c");
+
+  ndn::Interest interest;
+  interest.SetName (Create<ndn::Name> ("/a/b/d"));
+  Ptr<ndn::fib::Entry> match = fib->LongestPrefixMatch (interest);
+  NS_TEST_ASSERT_MSG_NE (match, 0, "/a/b/d should match");
+  NS_TEST_ASSERT_MSG_EQ (match->GetPrefix (), ndn::Name ("/a/b"), "/a/b/d should match /a/b");
+
+  // only existing prefixes: routes are updated, but there are no new entries to notify about
+  routes.clear ();
+  routes.push_back (ndn::fib::Route (Create<ndn::Name> ("/c"), face1, 7));
+  routes.push_back (ndn::fib::Route (Create<ndn::Name> ("/a"), face0, 6));
+  fib->AddBulk (routes);
+
+  NS_TEST_ASSERT_MSG_EQ (fib->GetSize (), 4, "no new entries should be created");
+  NS_TEST_ASSERT_MSG_EQ (strategy->m_batches.size (), 1, "strategy should not be notified without new entries");
+  NS_TEST_ASSERT_MSG_EQ (GetRoutingCost (fib, "/c", face1), 7, "route should be added to existing entry");
+  NS_TEST_ASSERT_MSG_EQ (GetRoutingCost (fib, "/a", face0), 6, "route should be added to existing entry");
+
+  // prefixes are parsed the same way as by AddRoute
+  std::vector<std::string> prefixes;
+  prefixes.push_back ("/d/%41");
+  prefixes.push_back ("/a");
+  prefixes.push_back ("/b");
+  ndn::StackHelper::AddRoutes (nodes.Get (0), prefixes, face1, 8);
+
+  NS_TEST_ASSERT_MSG_EQ (fib->GetSize (), 6, "two new entries should be created");
+  NS_TEST_ASSERT_MSG_EQ (strategy->m_batches.size (), 2, "strategy should be notified once per batch");
+  NS_TEST_ASSERT_MSG_EQ (strategy->m_batches.back (), 2, "strategy should be notified only about new entries");
+  NS_TEST_ASSERT_MSG_EQ (GetRoutingCost (fib, "/d/A", face1), 8, "escaped component should be unescaped");
+  NS_TEST_ASSERT_MSG_EQ (GetRoutingCost (fib, "/b", face1), 8, "route for /b");
+  NS_TEST_ASSERT_MSG_EQ (GetRoutingCost (fib, "/a", face1), 8, "existing route should be updated");
+
+  match = 0;
+  strategy = 0;
+  fib = 0;
+  face0 = 0;
+  face1 = 0;
+  l3 = 0;
+  Simulator::Destroy ();
+}
+
+}
@@ -0,0 +1,250 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2011-2013 University of California, Los Angeles
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ * Author: Alexander Afanasyev <alexander.afanasyev@ucla.edu>
+ */
+
+#include "ndnSIM-fw.h"
+#include "ns3/core-module.h"
+#include "ns3/ndnSIM-module.h"
+#include "ns3/point-to-point-module.h"
+
+#include "ns3/ndnSIM/model/fw/rtt-adaptive.h"
+#include "ns3/ndnSIM/model/fw/weighted-multipath.h"
+
+#include <sstream>
+#include <set>
+
+NS_LOG_COMPONENT_DEFINE ("ndn.FwTest");
+
+namespace ns3
+{
+
+namespace
+{
+
+/**
+ * @brief Create PIT entry for the Interest and let forwarding strategy of the node propagate it
+ */
+template<class Strategy>
+Ptr<ndn::pit::Entry>
+Propagate (Ptr<Node> node, const std::string &name)
+{
+  Ptr<ndn::Interest> interest = Create<ndn::Interest> ();
+  interest->SetName (Create<ndn::Name> (name));
+  interest->SetNonce (1);
+  interest->SetInterestLifetime (Seconds (1.0));
+
+  Ptr<ndn::pit::Entry> pitEntry = node->GetObject<ndn::Pit> ()->Create (interest);
+  if (pitEntry == 0)
+    return 0;
+
+  Ptr<Packet> packet = Create<Packet> ();
+  packet->AddHeader (*interest);
+  node->GetObject<Strategy> ()->DoPropagateInterest (0, interest, packet, pitEntry);
+  return pitEntry;
+}
+
+bool
+IsForwardedTo (Ptr<ndn::pit::Entry> pitEntry, Ptr<ndn::Face> face)
+{
+  return pitEntry->GetOutgoing ().find (face) != pitEntry->GetOutgoing ().end ();
+}
+
+double
+GetSatisfactionRatio (Ptr<ndn::fib::Entry> fibEntry, Ptr<ndn::Face> face)
+{
+  return fibEntry->m_faces.get<ndn::fib::i_face> ().find (face)->GetSatisfactionRatio ();
+}
+
+}
+
+void
+FwRttAdaptiveTest::DoRun ()
+{
+  NodeContainer nodes;
+  nodes.Create (2);
+
+  PointToPointHelper p2p;
+  for (uint32_t i = 0; i < 3; i++)
+    {
+      p2p.Install (nodes.Get (0), nodes.Get (1));
+    }
+
+  ndn::StackHelper ndnHelper;
+  ndnHelper.SetForwardingStrategy ("ns3::ndn::fw::RttAdaptive", "ProbingProbability", "0");
+  ndnHelper.Install (nodes);
+
+  Ptr<Node> node = nodes.Get (0);
+  Ptr<ndn::L3Protocol> l3 = node->GetObject<ndn::L3Protocol> ();
+  Ptr<ndn::Face> faces[] = { l3->GetFace (0), l3->GetFace (1), l3->GetFace (2) };
+
+  Ptr<ndn::Fib> fib = node->GetObject<ndn::Fib> ();
+  for (uint32_t i = 0; i < 3; i++)
+    {
+      fib->Add (Create<ndn::Name> ("/p"), faces[i], i + 1);
+    }
+  Ptr<ndn::fib::Entry> fibEntry = fib->Find (ndn::Name ("/p"));
+
+  // without measurements, face with the lowest routing cost is used
+  Ptr<ndn::pit::Entry> pitEntry = Propagate<ndn::fw::RttAdaptive> (node, "/p/1");
+  NS_TEST_ASSERT_MSG_NE (pitEntry, 0, "PIT entry should be created");
+  NS_TEST_ASSERT_MSG_EQ (pitEntry->GetOutgoing ().size (), 1, "Interest should be sent to one face");
+  NS_TEST_ASSERT_MSG_EQ (IsForwardedTo (pitEntry, faces[0]), true, "face with the lowest cost should be used");
+
+  // measured faces are preferred, the one with the smallest RTT first
+  fibEntry->UpdateFaceRtt (faces[0], MilliSeconds (100));
+  fibEntry->UpdateFaceRtt (faces[1], MilliSeconds (10));
+  pitEntry = Propagate<ndn::fw::RttAdaptive> (node, "/p/2");
+  NS_TEST_ASSERT_MSG_EQ (pitEntry->GetOutgoing ().size (), 1, "Interest should be sent to one face");
+  NS_TEST_ASSERT_MSG_EQ (IsForwardedTo (pitEntry, faces[1]), true, "face with the smallest RTT should be used");
+
+  // failures make the score of the face worse
+  while (GetSatisfactionRatio (fibEntry, faces[1]) >= 0.05)
+    {
+      fibEntry->UpdateFaceSatisfaction (faces[1], false);
+    }
+  pitEntry = Propagate<ndn::fw::RttAdaptive> (node, "/p/3");
+  NS_TEST_ASSERT_MSG_EQ (pitEntry->GetOutgoing ().size (), 1, "Interest should be sent to one face");
+  NS_TEST_ASSERT_MSG_EQ (IsForwardedTo (pitEntry, faces[0]), true, "face with the best RTT to satisfaction ratio should be used");
+
+  // after timeout or NACK, a copy is sent to a face without measurements
+  fibEntry->m_needsProbing = true;
+  pitEntry = Propagate<ndn::fw::RttAdaptive> (node, "/p/4");
+  NS_TEST_ASSERT_MSG_EQ (pitEntry->GetOutgoing ().size (), 2, "Interest should be sent to the best face and probed");
+  NS_TEST_ASSERT_MSG_EQ (IsForwardedTo (pitEntry, faces[0]), true, "best face should be used");
+  NS_TEST_ASSERT_MSG_EQ (IsForwardedTo (pitEntry, faces[2]), true, "face without measurements should be probed");
+  NS_TEST_ASSERT_MSG_EQ (fibEntry->m_needsProbing, false, "probing flag should be reset");
+
+  pitEntry = Propagate<ndn::fw::RttAdaptive> (node, "/p/5");
+  NS_TEST_ASSERT_MSG_EQ (pitEntry->GetOutgoing ().size (), 1, "Interest should not be probed without the flag");
+
+  // RED faces are never used
+  fibEntry->Invalidate (faces[0]);
+  pitEntry = Propagate<ndn::fw::RttAdaptive> (node, "/p/6");
+  NS_TEST_ASSERT_MSG_EQ (pitEntry->GetOutgoing ().size (), 1, "Interest should be sent to one face");
+  NS_TEST_ASSERT_MSG_EQ (IsForwardedTo (pitEntry, faces[1]), true, "the best non-RED face should be used");
+
+  pitEntry = 0;
+  fibEntry = 0;
+  fib = 0;
+  for (uint32_t i = 0; i < 3; i++)
+    {
+      faces[i] = 0;
+    }
+  l3 = 0;
+  node = 0;
+  Simulator::Destroy ();
+}
+
+void
+FwWeightedMultipathTest::DoRun ()
+{
+  NodeContainer nodes;
+  nodes.Create (2);
+
+  PointToPointHelper p2p;
+  for (uint32_t i = 0; i < 2; i++)
+    {
+      p2p.Install (nodes.Get (0), nodes.Get (1));
+    }
+
+  ndn::StackHelper ndnHelper;
+  ndnHelper.SetForwardingStrategy ("ns3::ndn::fw::WeightedMultipath");
+  ndnHelper.Install (nodes);
+
+  Ptr<Node> node = nodes.Get (0);
+  Ptr<ndn::L3Protocol> l3 = node->GetObject<ndn::L3Protocol> ();
+  Ptr<ndn::Face> faces[] = { l3->GetFace (0), l3->GetFace (1) };
+
+  Ptr<ndn::Fib> fib = node->GetObject<ndn::Fib> ();
+  for (uint32_t i = 0; i < 2; i++)
+    {
+      fib->Add (Create<ndn::Name> ("/p"), faces[i], 1);
+    }
+  Ptr<ndn::fib::Entry> fibEntry = fib->Find (ndn::Name ("/p"));
+
+  // without limits, weight of the face is its satisfaction ratio
+  while (GetSatisfactionRatio (fibEntry, faces[1]) >= 0.35)
+    {
+      fibEntry->UpdateFaceSatisfaction (faces[1], false);
+    }
+  double expectedShare = GetSatisfactionRatio (fibEntry, faces[0]) /
+    (GetSatisfactionRatio (fibEntry, faces[0]) + GetSatisfactionRatio (fibEntry, faces[1]));
+
+  const uint32_t nInterests = 3000;
+  uint32_t counts[] = { 0, 0 };
+  for (uint32_t i = 0; i < nInterests; i++)
+    {
+      std::ostringstream name;
+      name << "/p/" << i;
+      Ptr<ndn::pit::Entry> pitEntry = Propagate<ndn::fw::WeightedMultipath> (node, name.str ());
+      NS_TEST_ASSERT_MSG_NE (pitEntry, 0, "PIT entry should be created");
+      NS_TEST_ASSERT_MSG_EQ (pitEntry->GetOutgoing ().size (), 1, "Interest should be sent to one face");
+
+      for (uint32_t face = 0; face < 2; face++)
+        {
+          if (IsForwardedTo (pitEntry, faces[face]))
+            counts[face]++;
+        }
+    }
+  NS_TEST_ASSERT_MSG_EQ (counts[0] + counts[1], nInterests, "every Interest should be forwarded");
+  NS_TEST_ASSERT_MSG_EQ_TOL (static_cast<double> (counts[0]) / nInterests, expectedShare, 0.03,
+                             "Interests should be split in proportion to face weights");
+
+  // Interests of the same flow stick to the same face, while flows are spread over faces
+  node->GetObject<ndn::fw::WeightedMultipath> ()->SetAttribute ("FlowPrefixLength", UintegerValue (2));
+  std::set<uint32_t> usedFaces;
+  for (uint32_t flow = 0; flow < 20; flow++)
+    {
+      std::set<uint32_t> flowFaces;
+      for (uint32_t i = 0; i < 10; i++)
+        {
+          std::ostringstream name;
+          name << "/p/flow" << flow << "/" << i;
+          Ptr<ndn::pit::Entry> pitEntry = Propagate<ndn::fw::WeightedMultipath> (node, name.str ());
+          NS_TEST_ASSERT_MSG_EQ (pitEntry->GetOutgoing ().size (), 1, "Interest should be sent to one face");
+
+          flowFaces.insert (pitEntry->GetOutgoing ().begin ()->m_face->GetId ());
+        }
+      NS_TEST_ASSERT_MSG_EQ (flowFaces.size (), 1, "all Interests of the flow should be sent to the same face");
+      usedFaces.insert (flowFaces.begin (), flowFaces.end ());
+    }
+  NS_TEST_ASSERT_MSG_EQ (usedFaces.size (), 2, "flows should be spread over both faces");
+
+  // RED faces are never used
+  fibEntry->Invalidate (faces[0]);
+  for (uint32_t flow = 0; flow < 20; flow++)
+    {
+      std::ostringstream name;
+      name << "/p/red" << flow << "/0";
+      Ptr<ndn::pit::Entry> pitEntry = Propagate<ndn::fw::WeightedMultipath> (node, name.str ());
+      NS_TEST_ASSERT_MSG_EQ (IsForwardedTo (pitEntry, faces[1]), true, "only non-RED face should be used");
+    }
+
+  fibEntry = 0;
+  fib = 0;
+  for (uint32_t i = 0; i < 2; i++)
+    {
+      faces[i] = 0;
+    }
+  l3 = 0;
+  node = 0;
+  Simulator::Destroy ();
+}
+
+}
@@ -0,0 +1,310 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2011,2012 University of California, Los Angeles
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ * Author: Alexander Afanasyev <alexander.afanasyev@ucla.edu>
+ */
+
+#include "ndnSIM-global-routing.h"
+#include "ns3/core-module.h"
+#include "ns3/ndnSIM-module.h"
+#include "ns3/point-to-point-module.h"
+
+#include "ns3/ndnSIM/helper/ndn-global-routing-graph.h"
+
+#include <set>
+#include <map>
+#include <fstream>
+#include <sstream>
+#include <iomanip>
+#include <cstdio>
+#include <unistd.h>
+
+#include <boost/foreach.hpp>
+
+NS_LOG_COMPONENT_DEFINE ("ndn.GlobalRoutingTest");
+
+namespace ns3
+{
+
+namespace
+{
+
+// "node prefix face" -> "cost status delay"
+typedef std::map<std::string, std::string> Routes;
+
+Routes
+GetRoutes ()
+{
+  Routes routes;
+  for (NodeList::Iterator node = NodeList::Begin (); node != NodeList::End (); node++)
+    {
+      Ptr<ndn::Fib> fib = (*node)->GetObject<ndn::Fib> ();
+      for (Ptr<ndn::fib::Entry> entry = fib->Begin (); entry != fib->End (); entry = fib->Next (entry))
+        {
+          BOOST_FOREACH (const ndn::fib::FaceMetric &metric, entry->m_faces)
+            {
+              std::ostringstream key;
+              key << (*node)->GetId () << " " << entry->GetPrefix () << " " << metric.GetFace ()->GetId ();
+
+              // delay is saved in seconds, so compare it with microsecond precision
+              std::ostringstream route;
+              route << metric.GetRoutingCost () << " " << metric.GetStatus () << " "
+                    << std::fixed << std::setprecision (6) << metric.GetRealDelay ().ToDouble (Time::S);
+
+              routes[key.str ()] = route.str ();
+            }
+        }
+    }
+  return routes;
+}
+
+void
+ClearFibs ()
+{
+  for (NodeList::Iterator node = NodeList::Begin (); node != NodeList::End (); node++)
+    {
+      Ptr<ndn::Fib> fib = (*node)->GetObject<ndn::Fib> ();
+      while (fib->Begin () != fib->End ())
+        {
+          fib->Remove (fib->Begin ()->m_prefix);
+        }
+    }
+}
+
+std::string
+CreateTempFile ()
+{
+  char filename[] = "/tmp/ndnSIM-routes-XXXXXX";
+  int fd = mkstemp (filename);
+  if (fd < 0)
+    return "";
+  close (fd);
+  return filename;
+}
+
+}
+
+void
+GlobalRoutingGraphUpdateTest::DoRun ()
+{
+  // (node, node, metric)
+  const uint32_t links[][3] = { { 0, 1, 2 }, { 1, 2, 3 }, { 2, 3, 1 }, { 0, 4, 4 },
+                                { 4, 5, 1 }, { 5, 3, 2 }, { 1, 4, 7 }, { 2, 5, 5 } };
+  const uint32_t nLinks = sizeof (links) / sizeof (links[0]);
+
+  NodeContainer nodes;
+  nodes.Create (6);
+
+  PointToPointHelper p2p;
+  std::vector<NetDeviceContainer> devices;
+  for (uint32_t link = 0; link < nLinks; link++)
+    {
+      devices.push_back (p2p.Install (nodes.Get (links[link][0]), nodes.Get (links[link][1])));
+    }
+
+  ndn::StackHelper ndnHelper;
+  ndnHelper.Install (nodes);
+
+  ndn::GlobalRoutingHelper routingHelper;
+  routingHelper.Install (nodes);
+
+  for (uint32_t link = 0; link < nLinks; link++)
+    {
+      for (uint32_t side = 0; side < 2; side++)
+        {
+          Ptr<NetDevice> device = devices[link].Get (side);
+          Ptr<ndn::Face> face = device->GetNode ()->GetObject<ndn::L3Protocol> ()->GetFaceByNetDevice (device);
+          NS_TEST_ASSERT_MSG_NE (face, 0, "there should be a face for each device");
+          face->SetMetric (links[link][2]);
+        }
+    }
+
+  ndn::GlobalRoutingGraph graph;
+  uint32_t nNodes = graph.GetNNodes ();
+  NS_TEST_ASSERT_MSG_EQ (nNodes, 6, "all nodes should be in the graph");
+
+  std::vector<ndn::GlobalRoutingGraph::Paths> trees (nNodes);
+  for (uint32_t source = 0; source < nNodes; source++)
+    {
+      graph.ShortestPaths (source, trees[source]);
+    }
+
+  ndn::GlobalRoutingGraph::Paths fresh;
+  std::vector<ndn::GlobalRoutingGraph::PathChange> changes;
+
+  std::pair<uint32_t, uint32_t> edges (graph.GetEdges (0).first, graph.GetEdges (graph.GetNVertices () - 1).second);
+  for (uint32_t edge = edges.first; edge < edges.second; edge++)
+    {
+      uint32_t original = graph.GetMetric (edge);
+      // increase, decrease, disable, re-enable
+      const uint32_t metrics[] = { original + 5, 1, ndn::GlobalRoutingGraph::DISABLED, original };
+
+      for (uint32_t step = 0; step < sizeof (metrics) / sizeof (metrics[0]); step++)
+        {
+          uint32_t oldMetric = graph.GetMetric (edge);
+          graph.SetMetric (edge, metrics[step]);
+
+          for (uint32_t source = 0; source < nNodes; source++)
+            {
+              ndn::GlobalRoutingGraph::Paths before = trees[source];
+
+              changes.clear ();
+              graph.UpdateShortestPaths (source, edge, oldMetric, trees[source], changes);
+              graph.ShortestPaths (source, fresh);
+
+              std::set<uint32_t> changed;
+              for (std::vector<ndn::GlobalRoutingGraph::PathChange>::const_iterator change = changes.begin ();
+                   change != changes.end ();
+                   change++)
+                {
+                  NS_TEST_ASSERT_MSG_EQ (changed.insert (change->m_vertex).second, true,
+                                         "each vertex should be reported only once");
+                  NS_TEST_ASSERT_MSG_EQ (change->m_distance, before.m_distance[change->m_vertex],
+                                         "previous distance should be reported");
+                  NS_TEST_ASSERT_MSG_EQ (change->m_firstHop, before.m_firstHop[change->m_vertex],
+                                         "previous first hop should be reported");
+                }
+
+              for (uint32_t vertex = 0; vertex < graph.GetNVertices (); vertex++)
+                {
+                  NS_TEST_ASSERT_MSG_EQ (trees[source].m_distance[vertex], fresh.m_distance[vertex],
+                                         "updated distance should be the same as calculated from scratch"
+                                         " (edge " << edge << ", step " << step << ", source " << source
+                                         << ", vertex " << vertex << ")");
+                  NS_TEST_ASSERT_MSG_EQ (trees[source].m_firstHop[vertex] == ndn::GlobalRoutingGraph::INVALID,
+                                         fresh.m_firstHop[vertex] == ndn::GlobalRoutingGraph::INVALID,
+                                         "reachability should be the same as calculated from scratch");
+
+                  if (before.m_distance[vertex] != trees[source].m_distance[vertex] ||
+                      before.m_firstHop[vertex] != trees[source].m_firstHop[vertex])
+                    {
+                      NS_TEST_ASSERT_MSG_EQ (changed.count (vertex), 1, "changed vertex should be reported");
+                    }
+                }
+            }
+        }
+    }
+
+  Simulator::Destroy ();
+}
+
+void
+GlobalRoutingSaveLoadTest::Compare (const std::map<std::string, std::string> &expected, const std::string &stage)
+{
+  Routes actual = GetRoutes ();
+  NS_TEST_ASSERT_MSG_EQ (actual.size (), expected.size (), stage << ": FIBs should have the same number of routes");
+
+  for (Routes::const_iterator route = expected.begin (); route != expected.end (); route++)
+    {
+      Routes::const_iterator found = actual.find (route->first);
+      NS_TEST_ASSERT_MSG_EQ ((found != actual.end ()), true, stage << ": route " << route->first << " should exist");
+      NS_TEST_ASSERT_MSG_EQ (found->second, route->second, stage << ": route " << route->first);
+    }
+}
+
+void
+GlobalRoutingSaveLoadTest::DoRun ()
+{
+  // (node, node, metric)
+  const uint32_t links[][3] = { { 0, 1, 1 }, { 1, 2, 2 }, { 0, 3, 1 }, { 3, 2, 1 } };
+  const uint32_t nLinks = sizeof (links) / sizeof (links[0]);
+
+  NodeContainer nodes;
+  nodes.Create (4);
+
+  PointToPointHelper p2p;
+  std::vector<NetDeviceContainer> devices;
+  for (uint32_t link = 0; link < nLinks; link++)
+    {
+      devices.push_back (p2p.Install (nodes.Get (links[link][0]), nodes.Get (links[link][1])));
+    }
+
+  ndn::StackHelper ndnHelper;
+  ndnHelper.Install (nodes);
+
+  ndn::GlobalRoutingHelper routingHelper;
+  routingHelper.Install (nodes);
+
+  std::vector< Ptr<ndn::Face> > faces;
+  for (uint32_t link = 0; link < nLinks; link++)
+    {
+      for (uint32_t side = 0; side < 2; side++)
+        {
+          Ptr<NetDevice> device = devices[link].Get (side);
+          Ptr<ndn::Face> face = device->GetNode ()->GetObject<ndn::L3Protocol> ()->GetFaceByNetDevice (device);
+          NS_TEST_ASSERT_MSG_NE (face, 0, "there should be a face for each device");
+          face->SetMetric (links[link][2]);
+          faces.push_back (face);
+        }
+    }
+
+  routingHelper.AddOrigin ("/a", nodes.Get (2));
+  routingHelper.AddOrigin ("/b/c", nodes.Get (0));
+  // routes through all faces, so one of them can be marked green and another one red
+  ndn::GlobalRoutingHelper::CalculateAllPossibleRoutes ();
+
+  Ptr<ndn::fib::Entry> entry = nodes.Get (0)->GetObject<ndn::Fib> ()->Find (ndn::Name ("/a"));
+  NS_TEST_ASSERT_MSG_NE (entry, 0, "node 0 should have a route to /a");
+  entry->UpdateStatus (faces[0], ndn::fib::FaceMetric::NDN_FIB_GREEN);
+  entry->Invalidate (faces[4]);
+
+  Routes routes = GetRoutes ();
+  NS_TEST_ASSERT_MSG_EQ ((routes.size () > 0), true, "routes should be calculated");
+
+  std::string filename = CreateTempFile ();
+  NS_TEST_ASSERT_MSG_NE (filename, "", "temporary file should be created");
+  ndn::GlobalRoutingHelper::SaveRoutes (filename);
+
+  ClearFibs ();
+  NS_TEST_ASSERT_MSG_EQ (ndn::GlobalRoutingHelper::LoadRoutes (filename), true, "routes should be loaded");
+  Compare (routes, "loaded");
+
+  // changed metric of a face changes topology fingerprint, so saved routes should not be installed
+  faces[2]->SetMetric (links[1][2] + 1);
+  NS_TEST_ASSERT_MSG_EQ (ndn::GlobalRoutingHelper::LoadRoutes (filename), false,
+                         "routes saved for a different topology should be rejected");
+  Compare (routes, "different topology");
+  faces[2]->SetMetric (links[1][2]);
+
+  std::string contents;
+  {
+    std::ifstream is (filename.c_str (), std::ios::binary);
+    std::ostringstream os;
+    os << is.rdbuf ();
+    contents = os.str ();
+  }
+
+  std::string truncated = CreateTempFile ();
+  NS_TEST_ASSERT_MSG_NE (truncated, "", "temporary file should be created");
+  {
+    std::ofstream os (truncated.c_str (), std::ios::binary);
+    os.write (contents.data (), contents.size () - 1);
+  }
+
+  ClearFibs ();
+  NS_TEST_ASSERT_MSG_EQ (ndn::GlobalRoutingHelper::LoadRoutes (truncated), false, "truncated file should be rejected");
+  NS_TEST_ASSERT_MSG_EQ (GetRoutes ().size (), 0, "nothing should be installed from a truncated file");
+
+  std::remove (filename.c_str ());
+  std::remove (truncated.c_str ());
+
+  entry = 0;
+  faces.clear ();
+  Simulator::Destroy ();
+}
+
+}
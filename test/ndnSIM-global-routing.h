@@ -0,0 +1,60 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2011-2013 University of California, Los Angeles
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ * Author: Alexander Afanasyev <alexander.afanasyev@ucla.edu>
+ */
+
+#ifndef NDNSIM_TEST_GLOBAL_ROUTING_H
+#define NDNSIM_TEST_GLOBAL_ROUTING_H
+
+#include "ns3/test.h"
+
+#include <map>
+#include <string>
+
+namespace ns3 {
+
+class GlobalRoutingGraphUpdateTest : public TestCase
+{
+public:
+  GlobalRoutingGraphUpdateTest ()
+    : TestCase ("Global routing graph incremental update test")
+  {
+  }
+
+private:
+  virtual void DoRun ();
+};
+
+class GlobalRoutingSaveLoadTest : public TestCase
+{
+public:
+  GlobalRoutingSaveLoadTest ()
+    : TestCase ("Global routing save and load routes test")
+  {
+  }
+
+private:
+  virtual void DoRun ();
+
+  void
+  Compare (const std::map<std::string, std::string> &expected, const std::string &stage);
+};
+
+}
+
+#endif // NDNSIM_TEST_GLOBAL_ROUTING_H
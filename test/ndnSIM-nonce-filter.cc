@@ -0,0 +1,138 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2011-2013 University of California, Los Angeles
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ * Author: Alexander Afanasyev <alexander.afanasyev@ucla.edu>
+ */
+
+#include "ndnSIM-nonce-filter.h"
+#include "ns3/core-module.h"
+#include "ns3/ndnSIM-module.h"
+#include "ns3/ndnSIM/model/ndn-nonce-filter.h"
+
+NS_LOG_COMPONENT_DEFINE ("ndn.NonceFilterTest");
+
+namespace ns3
+{
+
+void
+NonceFilterTest::DoRun ()
+{
+  Ptr<ndn::NonceFilter> filter = CreateObject<ndn::NonceFilter> ();
+
+  ndn::Name name ("/prefix/1");
+  NS_TEST_ASSERT_MSG_EQ (filter->Contains (name, 1), false, "Filter should be empty");
+  NS_TEST_ASSERT_MSG_EQ (filter->Add (name, 1), true, "Nonce is seen for the first time");
+  NS_TEST_ASSERT_MSG_EQ (filter->Contains (name, 1), true, "Nonce should be remembered");
+  NS_TEST_ASSERT_MSG_EQ (filter->Add (name, 1), false, "Nonce should be reported as duplicate");
+
+  NS_TEST_ASSERT_MSG_EQ (filter->Contains (name, 2), false, "Other nonce for the same name should not be reported");
+  NS_TEST_ASSERT_MSG_EQ (filter->Contains (ndn::Name ("/prefix/2"), 1), false, "Same nonce for other name should not be reported");
+
+  NS_TEST_ASSERT_MSG_GT (filter->GetMemoryUsage (), 0, "Buckets should be allocated after the first use");
+
+  // changing parameters drops all recorded nonces
+  filter->SetAttribute ("Buckets", UintegerValue (2));
+  NS_TEST_ASSERT_MSG_EQ (filter->Contains (name, 1), false, "Nonces should be forgotten after reconfiguration");
+
+  Simulator::Destroy ();
+}
+
+void
+NonceFilterRotationTest::Check (Ptr<ndn::NonceFilter> filter, uint32_t nonce, bool expected)
+{
+  NS_TEST_ASSERT_MSG_EQ (filter->Contains (ndn::Name ("/prefix"), nonce), expected,
+                         "Unexpected state of nonce " << nonce << " at " << Simulator::Now ().ToDouble (Time::S) << "s");
+}
+
+void
+NonceFilterRotationTest::Add (Ptr<ndn::NonceFilter> filter, uint32_t nonce)
+{
+  NS_TEST_ASSERT_MSG_EQ (filter->Add (ndn::Name ("/prefix"), nonce), true, "Nonce " << nonce << " is seen for the first time");
+}
+
+void
+NonceFilterRotationTest::DoRun ()
+{
+  // period of each bucket is 1s
+  Ptr<ndn::NonceFilter> filter = CreateObject<ndn::NonceFilter> ();
+  filter->SetAttribute ("Lifetime", TimeValue (Seconds (4.0)));
+  filter->SetAttribute ("Buckets", UintegerValue (4));
+
+  // nonce recorded at the beginning of the period is remembered for the whole Lifetime
+  Simulator::Schedule (Seconds (0.0), &NonceFilterRotationTest::Add, this, filter, 1);
+  Simulator::Schedule (Seconds (3.9), &NonceFilterRotationTest::Check, this, filter, 1, true);
+  Simulator::Schedule (Seconds (4.0), &NonceFilterRotationTest::Check, this, filter, 1, false);
+
+  // nonce recorded in the middle of the period is remembered at least Lifetime-Lifetime/Buckets
+  Simulator::Schedule (Seconds (2.5), &NonceFilterRotationTest::Add, this, filter, 2);
+  Simulator::Schedule (Seconds (5.9), &NonceFilterRotationTest::Check, this, filter, 2, true);
+  Simulator::Schedule (Seconds (6.0), &NonceFilterRotationTest::Check, this, filter, 2, false);
+
+  // all buckets are stale if filter was not used for more than Lifetime
+  Simulator::Schedule (Seconds (7.0), &NonceFilterRotationTest::Add, this, filter, 3);
+  Simulator::Schedule (Seconds (20.0), &NonceFilterRotationTest::Check, this, filter, 3, false);
+
+  Simulator::Run ();
+  Simulator::Destroy ();
+
+  // Lifetime shorter than number of buckets (in the smallest time units): each bucket is still used
+  // at least for one time unit and nonces are not remembered longer than Lifetime
+  filter = CreateObject<ndn::NonceFilter> ();
+  filter->SetAttribute ("Lifetime", TimeValue (NanoSeconds (2)));
+  filter->SetAttribute ("Buckets", UintegerValue (4));
+
+  Simulator::Schedule (NanoSeconds (0), &NonceFilterRotationTest::Add, this, filter, 1);
+  Simulator::Schedule (NanoSeconds (1), &NonceFilterRotationTest::Check, this, filter, 1, true);
+  Simulator::Schedule (NanoSeconds (2), &NonceFilterRotationTest::Check, this, filter, 1, false);
+
+  Simulator::Run ();
+  Simulator::Destroy ();
+}
+
+void
+NonceFilterFalsePositiveTest::DoRun ()
+{
+  Ptr<ndn::NonceFilter> filter = CreateObject<ndn::NonceFilter> ();
+  filter->SetAttribute ("Capacity", UintegerValue (1000));
+  filter->SetAttribute ("FalsePositiveRate", DoubleValue (0.01));
+
+  ndn::Name name ("/prefix");
+  for (uint32_t nonce = 0; nonce < 1000; nonce++)
+    {
+      filter->Add (name, nonce);
+    }
+
+  uint32_t falsePositives = 0;
+  const uint32_t probes = 10000;
+  for (uint32_t nonce = 1000; nonce < 1000 + probes; nonce++)
+    {
+      if (filter->Contains (name, nonce))
+        falsePositives ++;
+    }
+
+  NS_LOG_DEBUG ("False positives: " << falsePositives << " out of " << probes);
+  NS_TEST_ASSERT_MSG_LT (falsePositives, 0.02 * probes, "False positive rate should be close to the configured");
+
+  for (uint32_t nonce = 0; nonce < 1000; nonce++)
+    {
+      NS_TEST_ASSERT_MSG_EQ (filter->Contains (name, nonce), true, "Recorded nonce should never be missed");
+    }
+
+  Simulator::Destroy ();
+}
+
+}
@@ -0,0 +1,87 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2011-2013 University of California, Los Angeles
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ * Author: Alexander Afanasyev <alexander.afanasyev@ucla.edu>
+ */
+
+#include "ndnSIM-object-pool.h"
+#include "ns3/core-module.h"
+#include "ns3/ndnSIM-module.h"
+
+#include "ns3/ndnSIM/utils/ndn-object-pool.h"
+
+#include <vector>
+
+NS_LOG_COMPONENT_DEFINE ("ndn.ObjectPoolTest");
+
+namespace ns3
+{
+
+namespace
+{
+
+struct PooledObject
+{
+  NDN_OBJECT_POOL (PooledObject, 4)
+
+  uint64_t m_value[2];
+};
+
+struct DerivedPooledObject : public PooledObject
+{
+  uint64_t m_extra;
+};
+
+typedef ndn::ObjectPool<PooledObject, 4> Pool;
+
+}
+
+void
+ObjectPoolTest::DoRun ()
+{
+  NS_TEST_ASSERT_MSG_EQ (Pool::GetSize (), 0, "pool should be empty initially");
+
+  PooledObject *object = new PooledObject;
+  delete object;
+  NS_TEST_ASSERT_MSG_EQ (Pool::GetSize (), 1, "memory of released object should be kept in the pool");
+
+  PooledObject *reused = new PooledObject;
+  NS_TEST_ASSERT_MSG_EQ ((reused == object), true, "memory of released object should be reused");
+  NS_TEST_ASSERT_MSG_EQ (Pool::GetSize (), 0, "reused block should be taken from the pool");
+  delete reused;
+
+  std::vector<PooledObject*> objects;
+  for (uint32_t i = 0; i < 6; i++)
+    {
+      objects.push_back (new PooledObject);
+    }
+  NS_TEST_ASSERT_MSG_EQ (Pool::GetSize (), 0, "all blocks should be taken from the pool");
+
+  for (uint32_t i = 0; i < objects.size (); i++)
+    {
+      delete objects[i];
+    }
+  NS_TEST_ASSERT_MSG_EQ (Pool::GetSize (), 4, "pool should not keep more than MaxSize blocks");
+
+  // objects of derived classes have different size and bypass the pool
+  DerivedPooledObject *derived = new DerivedPooledObject;
+  NS_TEST_ASSERT_MSG_EQ (Pool::GetSize (), 4, "derived object should not be taken from the pool");
+  delete derived;
+  NS_TEST_ASSERT_MSG_EQ (Pool::GetSize (), 4, "derived object should not be returned to the pool");
+}
+
+}
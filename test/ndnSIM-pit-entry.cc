@@ -0,0 +1,273 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2011-2013 University of California, Los Angeles
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ * Author: Alexander Afanasyev <alexander.afanasyev@ucla.edu>
+ */
+
+#include "ndnSIM-pit-entry.h"
+#include "ns3/core-module.h"
+#include "ns3/ndnSIM-module.h"
+#include "ns3/point-to-point-module.h"
+#include "ns3/ndnSIM/model/pit/ndn-pit-admission-control.h"
+
+#include <boost/shared_ptr.hpp>
+
+NS_LOG_COMPONENT_DEFINE ("ndn.PitEntryTest");
+
+namespace ns3
+{
+
+namespace
+{
+
+struct BaseTag : public ndn::fw::Tag
+{
+};
+
+struct DerivedTag : public BaseTag
+{
+};
+
+Ptr<ndn::pit::Entry>
+CreatePitEntry (Ptr<Node> node, const std::string &name)
+{
+  Ptr<ndn::Interest> interest = Create<ndn::Interest> ();
+  interest->SetName (Create<ndn::Name> (name));
+  interest->SetNonce (1);
+  interest->SetInterestLifetime (Seconds (1.0));
+
+  return node->GetObject<ndn::Pit> ()->Create (interest);
+}
+
+uint32_t
+GetCurrentSize (Ptr<ndn::Pit> pit)
+{
+  UintegerValue size;
+  pit->GetAttribute ("CurrentSize", size);
+  return size.Get ();
+}
+
+}
+
+void
+PitEntryFwTagTest::DoRun ()
+{
+  Ptr<Node> node = CreateObject<Node> ();
+  Ptr<Node> nodeSink = CreateObject<Node> ();
+  PointToPointHelper p2p;
+  p2p.Install (node, nodeSink);
+
+  ndn::StackHelper ndn;
+  ndn.Install (node);
+  ndn.Install (nodeSink);
+
+  ndn::StackHelper::AddRoute (node, "/", 0, 0);
+
+  Ptr<ndn::pit::Entry> pitEntry = CreatePitEntry (node, "/1");
+  NS_TEST_ASSERT_MSG_NE (pitEntry, 0, "PIT entry should be created");
+
+  NS_TEST_ASSERT_MSG_EQ ((pitEntry->GetFwTag<BaseTag> () == 0), true, "No tags should be present");
+
+  boost::shared_ptr<BaseTag> baseTag = ndn::fw::MakeTag<BaseTag> ();
+  pitEntry->AddFwTag (baseTag);
+  NS_TEST_ASSERT_MSG_EQ ((pitEntry->GetFwTag<BaseTag> () == baseTag), true, "Tag should be found in the slot of its type");
+  NS_TEST_ASSERT_MSG_EQ ((pitEntry->GetFwTag<DerivedTag> () == 0), true, "Tag of base type should not be returned for derived type");
+
+  boost::shared_ptr<DerivedTag> derivedTag = ndn::fw::MakeTag<DerivedTag> ();
+  pitEntry->AddFwTag (derivedTag);
+  NS_TEST_ASSERT_MSG_EQ ((pitEntry->GetFwTag<DerivedTag> () == derivedTag), true, "Tag should be found in the slot of its type");
+  NS_TEST_ASSERT_MSG_EQ ((pitEntry->GetFwTag<BaseTag> () == baseTag), true, "Tag of derived type should not replace tag of base type");
+
+  pitEntry->RemoveFwTag<BaseTag> ();
+  NS_TEST_ASSERT_MSG_EQ ((pitEntry->GetFwTag<BaseTag> () == 0), true, "Tag should be removed");
+  NS_TEST_ASSERT_MSG_EQ ((pitEntry->GetFwTag<DerivedTag> () == derivedTag), true, "Tag of derived type should not be removed");
+
+  // untyped overload uses the slot of dynamic type
+  boost::shared_ptr<DerivedTag> anotherDerivedTag = ndn::fw::MakeTag<DerivedTag> ();
+  pitEntry->AddFwTag (boost::shared_ptr<ndn::fw::Tag> (anotherDerivedTag));
+  NS_TEST_ASSERT_MSG_EQ ((pitEntry->GetFwTag<DerivedTag> () == anotherDerivedTag), true, "Tag should replace tag of the same type");
+  NS_TEST_ASSERT_MSG_EQ ((pitEntry->GetFwTag<BaseTag> () == 0), true, "Tag should not be stored in the slot of base type");
+
+  pitEntry->RemoveFwTag<DerivedTag> ();
+  NS_TEST_ASSERT_MSG_EQ ((pitEntry->GetFwTag<DerivedTag> () == 0), true, "Tag should be removed");
+
+  // removing absent tag is a no-op
+  pitEntry->RemoveFwTag<BaseTag> ();
+  NS_TEST_ASSERT_MSG_EQ ((pitEntry->GetFwTag<BaseTag> () == 0), true, "No tags should be present");
+
+  pitEntry = 0;
+  Simulator::Destroy ();
+}
+
+void
+PitMemorySizeTest::DoRun ()
+{
+  Ptr<Node> node = CreateObject<Node> ();
+  Ptr<Node> nodeSink = CreateObject<Node> ();
+  PointToPointHelper p2p;
+  p2p.Install (node, nodeSink);
+
+  ndn::StackHelper ndn;
+  ndn.SetPit ("ns3::ndn::pit::MemorySize");
+  ndn.Install (node);
+  ndn.Install (nodeSink);
+
+  ndn::StackHelper::AddRoute (node, "/", 0, 0);
+
+  Ptr<ndn::Pit> pit = node->GetObject<ndn::Pit> ();
+  Ptr<ndn::Face> face = node->GetObject<ndn::L3Protocol> ()->GetFace (0);
+  NS_TEST_ASSERT_MSG_EQ (GetCurrentSize (pit), 0, "PIT should be empty");
+
+  // accounted size of the entry = trie node + entry object + GetMemoryUsage (), only the last part
+  // changes when the entry is modified
+  Ptr<ndn::pit::Entry> pitEntry = CreatePitEntry (node, "/1");
+  NS_TEST_ASSERT_MSG_NE (pitEntry, 0, "PIT entry should be created");
+  uint32_t overhead = GetCurrentSize (pit) - pitEntry->GetMemoryUsage ();
+  NS_TEST_ASSERT_MSG_GT (overhead, 0, "Trie node and entry object should be accounted");
+
+  pitEntry->AddIncoming (face);
+  NS_TEST_ASSERT_MSG_EQ (GetCurrentSize (pit) - pitEntry->GetMemoryUsage (), overhead, "AddIncoming should be accounted");
+
+  pitEntry->AddOutgoing (face);
+  NS_TEST_ASSERT_MSG_EQ (GetCurrentSize (pit) - pitEntry->GetMemoryUsage (), overhead, "AddOutgoing should be accounted");
+
+  pitEntry->AddSeenNonce (1);
+  NS_TEST_ASSERT_MSG_EQ (GetCurrentSize (pit) - pitEntry->GetMemoryUsage (), overhead, "AddSeenNonce should be accounted");
+
+  pitEntry->AddFwTag (ndn::fw::MakeTag<BaseTag> ());
+  NS_TEST_ASSERT_MSG_EQ (GetCurrentSize (pit) - pitEntry->GetMemoryUsage (), overhead, "AddFwTag should be accounted");
+
+  pitEntry->RemoveFwTag<BaseTag> ();
+  NS_TEST_ASSERT_MSG_EQ (GetCurrentSize (pit) - pitEntry->GetMemoryUsage (), overhead, "RemoveFwTag should be accounted");
+
+  pitEntry->ClearIncoming ();
+  NS_TEST_ASSERT_MSG_EQ (GetCurrentSize (pit) - pitEntry->GetMemoryUsage (), overhead, "ClearIncoming should be accounted");
+
+  pitEntry->ClearOutgoing ();
+  NS_TEST_ASSERT_MSG_EQ (GetCurrentSize (pit) - pitEntry->GetMemoryUsage (), overhead, "ClearOutgoing should be accounted");
+
+  pit->MarkErased (pitEntry);
+  NS_TEST_ASSERT_MSG_EQ (GetCurrentSize (pit), 0, "Size of erased entry should be released");
+
+  // entry modified after removal from PIT should not be accounted anymore
+  pitEntry->AddIncoming (face);
+  NS_TEST_ASSERT_MSG_EQ (GetCurrentSize (pit), 0, "Entry is no longer in PIT");
+  pitEntry = 0;
+
+  // least recently used entries are evicted first
+  Ptr<ndn::pit::Entry> entry1 = CreatePitEntry (node, "/1");
+  Ptr<ndn::pit::Entry> entry2 = CreatePitEntry (node, "/2");
+  Ptr<ndn::pit::Entry> entry3 = CreatePitEntry (node, "/3");
+  uint32_t entrySize = GetCurrentSize (pit) / 3;
+  pit->SetAttribute ("MaxSize", UintegerValue (GetCurrentSize (pit) + entrySize / 2));
+
+  // change of the entry (without change of its size) makes it recently used
+  entry1->AddFwTag (ndn::fw::MakeTag<BaseTag> ());
+  entry1->RemoveFwTag<BaseTag> ();
+
+  Ptr<ndn::pit::Entry> entry4 = CreatePitEntry (node, "/4");
+  NS_TEST_ASSERT_MSG_NE (entry4, 0, "New entry should be created");
+  NS_TEST_ASSERT_MSG_EQ (pit->Find (ndn::Name ("/2")), 0, "Least recently used entry should be evicted");
+  NS_TEST_ASSERT_MSG_NE (pit->Find (ndn::Name ("/1")), 0, "Recently changed entry should stay");
+  NS_TEST_ASSERT_MSG_NE (pit->Find (ndn::Name ("/3")), 0, "Only one entry should be evicted");
+  NS_TEST_ASSERT_MSG_EQ (pit->GetSize (), 3, "PIT should have 3 entries");
+
+  // entry larger than the limit is rejected without evicting anything
+  pit->SetAttribute ("MaxSize", UintegerValue (entrySize / 2));
+  NS_TEST_ASSERT_MSG_EQ (CreatePitEntry (node, "/5"), 0, "Entry larger than the limit should be rejected");
+  NS_TEST_ASSERT_MSG_EQ (pit->GetSize (), 3, "Existing entries should stay");
+
+  entry1 = 0;
+  entry2 = 0;
+  entry3 = 0;
+  entry4 = 0;
+  Simulator::Destroy ();
+}
+
+void
+PitAdmissionControlTest::DoRun ()
+{
+  NodeContainer nodes;
+  nodes.Create (3);
+  PointToPointHelper p2p;
+  p2p.Install (nodes.Get (0), nodes.Get (1));
+  p2p.Install (nodes.Get (0), nodes.Get (2));
+
+  ndn::StackHelper ndn;
+  ndn.EnablePitQuotas (true,
+                       "MaxEntriesPerFace", "3",
+                       "MaxEntriesPerPrefix", "3");
+  ndn.Install (nodes);
+
+  Ptr<Node> node = nodes.Get (0);
+  ndn::StackHelper::AddRoute (node, "/", 0, 0);
+
+  Ptr<ndn::pit::AdmissionControl> admission = node->GetObject<ndn::pit::AdmissionControl> ();
+  NS_TEST_ASSERT_MSG_NE (admission, 0, "Admission control should be enabled");
+
+  Ptr<ndn::Face> face0 = node->GetObject<ndn::L3Protocol> ()->GetFace (0);
+  Ptr<ndn::Face> face1 = node->GetObject<ndn::L3Protocol> ()->GetFace (1);
+
+  Ptr<ndn::pit::Entry> entry1 = CreatePitEntry (node, "/1");
+  Ptr<ndn::pit::Entry> entry2 = CreatePitEntry (node, "/2");
+  Ptr<ndn::pit::Entry> entry3 = CreatePitEntry (node, "/3");
+  Ptr<ndn::fib::Entry> fibEntry = entry1->GetFibEntry ();
+  NS_TEST_ASSERT_MSG_EQ (admission->GetPrefixUsage (fibEntry), 0, "Entries without incoming faces are not pending");
+
+  entry1->AddIncoming (face0);
+  entry1->AddIncoming (face0);
+  entry1->AddIncoming (face1);
+  NS_TEST_ASSERT_MSG_EQ (admission->GetFaceUsage (face0), 1, "Face should be counted once per entry");
+  NS_TEST_ASSERT_MSG_EQ (admission->GetFaceUsage (face1), 1, "Each incoming face should be counted");
+  NS_TEST_ASSERT_MSG_EQ (admission->GetPrefixUsage (fibEntry), 1, "Entry should be counted once per prefix");
+
+  entry2->AddIncoming (face0);
+  entry3->AddIncoming (face0);
+  NS_TEST_ASSERT_MSG_EQ (admission->GetFaceUsage (face0), 3, "Face is recorded in 3 entries");
+  NS_TEST_ASSERT_MSG_EQ (admission->GetPrefixUsage (fibEntry), 3, "3 entries are pending");
+
+  NS_TEST_ASSERT_MSG_EQ (admission->CanAdmit (face0, 0, fibEntry), false, "Per-face quota is exceeded");
+  NS_TEST_ASSERT_MSG_EQ (admission->CanAdmit (face1, 0, fibEntry), false, "Per-prefix quota is exceeded");
+  NS_TEST_ASSERT_MSG_EQ (admission->CanAdmit (face0, entry1, 0), true, "Face is already recorded in the entry");
+  NS_TEST_ASSERT_MSG_EQ (admission->CanAdmit (face1, entry2, 0), true, "Entry is already pending");
+
+  entry1->RemoveIncoming (face1);
+  NS_TEST_ASSERT_MSG_EQ (admission->GetFaceUsage (face1), 0, "RemoveIncoming should be accounted");
+  NS_TEST_ASSERT_MSG_EQ (admission->GetPrefixUsage (fibEntry), 3, "Entry is still pending");
+
+  entry1->ClearIncoming ();
+  NS_TEST_ASSERT_MSG_EQ (admission->GetFaceUsage (face0), 2, "ClearIncoming should be accounted");
+  NS_TEST_ASSERT_MSG_EQ (admission->GetPrefixUsage (fibEntry), 2, "Entry is no longer pending");
+  NS_TEST_ASSERT_MSG_EQ (admission->CanAdmit (face1, 0, fibEntry), true, "Quotas are no longer exceeded");
+
+  entry2->RemoveAllReferencesToFace (face0);
+  NS_TEST_ASSERT_MSG_EQ (admission->GetFaceUsage (face0), 1, "RemoveAllReferencesToFace should be accounted");
+  NS_TEST_ASSERT_MSG_EQ (admission->GetPrefixUsage (fibEntry), 1, "Entry is no longer pending");
+
+  // entry removed while still pending
+  node->GetObject<ndn::Pit> ()->MarkErased (entry3);
+  entry3 = 0;
+  NS_TEST_ASSERT_MSG_EQ (admission->GetFaceUsage (face0), 0, "Removal of pending entry should be accounted");
+  NS_TEST_ASSERT_MSG_EQ (admission->GetPrefixUsage (fibEntry), 0, "No entries are pending");
+
+  entry1 = 0;
+  entry2 = 0;
+  fibEntry = 0;
+  Simulator::Destroy ();
+}
+
+}
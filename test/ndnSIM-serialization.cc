@@ -24,6 +24,7 @@
 #include "ndnSIM-serialization.h"
 
 #include <boost/lexical_cast.hpp>
+#include <vector>
 
 using namespace std;
 
@@ -103,4 +104,293 @@ ContentObjectSerializationTest::DoRun ()
   NS_TEST_ASSERT_MSG_EQ (source.GetSignature (), target.GetSignature (), "source/target signature failed");
 }
 
+void
+InterestTlvSerializationTest::DoSetup ()
+{
+  m_savedFormat = HeaderHelper::GetWireFormat ();
+  HeaderHelper::SetWireFormat (HeaderHelper::WIRE_FORMAT_TLV);
+}
+
+void
+InterestTlvSerializationTest::DoTeardown ()
+{
+  HeaderHelper::SetWireFormat (m_savedFormat);
+}
+
+void
+InterestTlvSerializationTest::DoRun ()
+{
+  Interest source;
+  source.SetName (Create<Name> (boost::lexical_cast<Name> ("/test/test2")));
+  source.SetScope (2);
+  source.SetInterestLifetime (MilliSeconds (1500));
+  source.SetNonce (200);
+  source.SetNack (10);
+  source.SetHopCount (3);
+
+  char hash[HASH_SIZE + 1];
+  memset (hash, 0, HASH_SIZE + 1);
+  memset (hash, 'A', HASH_SIZE);
+  hash[1] = '0';
+  source.AddExclusion (hash);
+
+  Ptr<Packet> packet = Create<Packet> (0);
+  //serialization
+  packet->AddHeader (source);
+  NS_TEST_ASSERT_MSG_EQ (packet->GetSize (), source.GetSerializedSize (), "serialized size is incorrect");
+  NS_TEST_ASSERT_MSG_EQ (HeaderHelper::GetNdnHeaderType (packet), HeaderHelper::INTEREST_TLV, "TLV Interest is not detected");
+
+  //deserialization
+  Interest target;
+  packet->RemoveHeader (target);
+
+  NS_TEST_ASSERT_MSG_EQ (source.GetName ()            , target.GetName ()            , "source/target name failed");
+  NS_TEST_ASSERT_MSG_EQ (source.GetScope ()           , target.GetScope ()           , "source/target scope failed");
+  NS_TEST_ASSERT_MSG_EQ (source.GetInterestLifetime (), target.GetInterestLifetime (), "source/target interest lifetime failed");
+  NS_TEST_ASSERT_MSG_EQ (source.GetNonce ()           , target.GetNonce ()           , "source/target nonce failed");
+  NS_TEST_ASSERT_MSG_EQ (source.GetNack ()            , target.GetNack ()            , "source/target NACK failed");
+  NS_TEST_ASSERT_MSG_EQ (source.GetHopCount ()        , target.GetHopCount ()        , "source/target hop count failed");
+  NS_TEST_ASSERT_MSG_EQ (target.GetExclusion ().size (), 1, "source/target exclusion failed");
+  NS_TEST_ASSERT_MSG_EQ (target.GetExclusion ().Contains (hash), true, "source/target exclusion failed");
+  NS_TEST_ASSERT_MSG_EQ (packet->GetSize (), 0, "the whole packet should be consumed");
+
+  // copy (as made by AppFace to deliver the incremented hop count) keeps all fields and the size of the header
+  Interest copy (target);
+  copy.SetHopCount (target.GetHopCount () + 1);
+  NS_TEST_ASSERT_MSG_EQ (copy.GetSerializedSize (), source.GetSerializedSize (), "hop count should have fixed size");
+  NS_TEST_ASSERT_MSG_EQ (copy.GetExclusion ().Contains (hash), true, "copy should keep exclusions");
+  NS_TEST_ASSERT_MSG_EQ (copy.GetHopCount (), 4, "hop count was not updated");
+}
+
+void
+ContentObjectTlvSerializationTest::DoSetup ()
+{
+  m_savedFormat = HeaderHelper::GetWireFormat ();
+  HeaderHelper::SetWireFormat (HeaderHelper::WIRE_FORMAT_TLV);
+}
+
+void
+ContentObjectTlvSerializationTest::DoTeardown ()
+{
+  HeaderHelper::SetWireFormat (m_savedFormat);
+}
+
+void
+ContentObjectTlvSerializationTest::DoRun ()
+{
+  ContentObject source;
+  source.SetName (Create<Name> (boost::lexical_cast<Name> ("/test/test2/1")));
+  source.SetFreshness (Seconds (10));
+  source.SetTimestamp (Seconds (100));
+
+  int size = source.GetSerializedSize ();
+  source.SetSignature (10);
+  NS_TEST_ASSERT_MSG_EQ (source.GetSerializedSize (), static_cast<unsigned int> (size + 3), "Signature size should have increased by 3");
+
+  size = source.GetSerializedSize ();
+  source.SetHopCount (1);
+  NS_TEST_ASSERT_MSG_EQ (source.GetSerializedSize (), static_cast<unsigned int> (size + 6), "Hop count size should have increased by 6");
+
+  source.SetHash (source.ComputeHash ());
+
+  Ptr<Packet> packet = Create<Packet> (100);
+  //serialization
+  packet->AddHeader (source);
+  NS_TEST_ASSERT_MSG_EQ (packet->GetSize (), 100 + source.GetSerializedSize (), "serialized size is incorrect");
+  NS_TEST_ASSERT_MSG_EQ (HeaderHelper::GetNdnHeaderType (packet), HeaderHelper::CONTENT_OBJECT_TLV, "TLV ContentObject is not detected");
+
+  //deserialization
+  ContentObject target;
+  packet->RemoveHeader (target);
+
+  NS_TEST_ASSERT_MSG_EQ (source.GetName ()     , target.GetName ()     , "source/target name failed");
+  NS_TEST_ASSERT_MSG_EQ (source.GetFreshness (), target.GetFreshness (), "source/target freshness failed");
+  NS_TEST_ASSERT_MSG_EQ (source.GetTimestamp (), target.GetTimestamp (), "source/target timestamp failed");
+  NS_TEST_ASSERT_MSG_EQ (source.GetSignature (), target.GetSignature (), "source/target signature failed");
+  NS_TEST_ASSERT_MSG_EQ (source.GetHash ()     , target.GetHash ()     , "source/target hash failed");
+  NS_TEST_ASSERT_MSG_EQ (source.GetHopCount (), target.GetHopCount (), "source/target hop count failed");
+  NS_TEST_ASSERT_MSG_EQ (packet->GetSize (), 100, "payload should not be consumed");
+}
+
+void
+NameUriTest::DoRun ()
+{
+  // escapes (both upper and lower case hex digits)
+  Name escaped ("/first/second%2Fthird/%41%6a");
+  NS_TEST_ASSERT_MSG_EQ (escaped.size (), 3, "escaped slash should not split the component");
+  NS_TEST_ASSERT_MSG_EQ (escaped.cut (1).GetLastComponent (), "second/third", "%2F should be decoded");
+  NS_TEST_ASSERT_MSG_EQ (escaped.GetLastComponent (), "Aj", "%41%6a should be decoded");
+
+  // incomplete or invalid escapes are kept as is
+  NS_TEST_ASSERT_MSG_EQ (Name ("/a%").GetLastComponent (), "a%", "trailing % should be kept");
+  NS_TEST_ASSERT_MSG_EQ (Name ("/a%4/b").cut (1).GetLastComponent (), "a%4", "incomplete escape should be kept");
+  NS_TEST_ASSERT_MSG_EQ (Name ("/a%zz").GetLastComponent (), "a%zz", "invalid escape should be kept");
+
+  // empty components
+  NS_TEST_ASSERT_MSG_EQ (Name ("").size (), 0, "empty URI should give the root name");
+  NS_TEST_ASSERT_MSG_EQ (Name ("/").size (), 0, "/ should give the root name");
+  Name empty ("//a///b/");
+  NS_TEST_ASSERT_MSG_EQ (empty.size (), 2, "empty components should be skipped");
+  NS_TEST_ASSERT_MSG_EQ (empty, Name ("/a/b"), "empty components should be skipped");
+
+  // whitespace
+  Name spaces (" /a b/\tc\n ");
+  NS_TEST_ASSERT_MSG_EQ (spaces, Name ("/ab/c"), "whitespace should be ignored");
+  NS_TEST_ASSERT_MSG_EQ (Name ("/a/ /b").size (), 2, "whitespace-only component should be skipped");
+  NS_TEST_ASSERT_MSG_EQ (Name ("/a%20b").GetLastComponent (), "a b", "escaped whitespace should be kept");
+
+  // printing escapes everything that would not be parsed back as is
+  Name special;
+  special.Add ("a/b");
+  special.Add ("100%");
+  special.Add ("with space");
+  special.Add (std::string ("\x01\xff\0", 3));
+  NS_TEST_ASSERT_MSG_EQ (special.ToString (), "/a%2Fb/100%25/with%20space/%01%FF%00", "special characters should be escaped");
+  NS_TEST_ASSERT_MSG_EQ (boost::lexical_cast<std::string> (special), special.ToString (), "Print and ToString should match");
+  NS_TEST_ASSERT_MSG_EQ (Name (special.ToString ()), special, "printed name should be parsed back into the same name");
+  NS_TEST_ASSERT_MSG_EQ (boost::lexical_cast<Name> (escaped), escaped, "printed name should be parsed back into the same name");
+}
+
+void
+NameLongComponentSerializationTest::DoSetup ()
+{
+  m_savedFormat = HeaderHelper::GetWireFormat ();
+}
+
+void
+NameLongComponentSerializationTest::DoTeardown ()
+{
+  HeaderHelper::SetWireFormat (m_savedFormat);
+}
+
+void
+NameLongComponentSerializationTest::DoRun ()
+{
+  // longer than 255 octets (TLV length needs 3 octets), includes all octet values including zero
+  std::string longComponent (300, '\0');
+  for (size_t i = 0; i < longComponent.size (); i++)
+    longComponent[i] = static_cast<char> (i % 256);
+
+  Ptr<Name> name = Create<Name> ();
+  name->Add ("prefix");
+  name->Add (longComponent);
+  name->Add ("1");
+
+  HeaderHelper::WireFormat formats[] = { HeaderHelper::WIRE_FORMAT_NDNSIM, HeaderHelper::WIRE_FORMAT_TLV };
+  for (size_t format = 0; format < sizeof (formats) / sizeof (formats[0]); format++)
+    {
+      HeaderHelper::SetWireFormat (formats[format]);
+
+      Interest source;
+      source.SetName (name);
+      source.SetNonce (1);
+
+      Ptr<Packet> packet = Create<Packet> (0);
+      packet->AddHeader (source);
+      NS_TEST_ASSERT_MSG_EQ (packet->GetSize (), source.GetSerializedSize (), "serialized size is incorrect");
+
+      Interest target;
+      packet->RemoveHeader (target);
+      NS_TEST_ASSERT_MSG_EQ (target.GetName ().size (), 3, "number of components is incorrect");
+      NS_TEST_ASSERT_MSG_EQ (target.GetName ().GetComponents ().capacity (), 3, "components should be allocated at once");
+      NS_TEST_ASSERT_MSG_EQ (target.GetName ().cut (1).GetLastComponent () == longComponent, true, "long component is corrupted");
+      NS_TEST_ASSERT_MSG_EQ (target.GetName (), *name, "source/target name failed");
+      NS_TEST_ASSERT_MSG_EQ (target.GetName ().GetSerializedSize (), name->GetSerializedSize (), "cached name size is incorrect");
+      NS_TEST_ASSERT_MSG_EQ (packet->GetSize (), 0, "the whole packet should be consumed");
+    }
+}
+
+void
+HopCountUpdateTest::DoSetup ()
+{
+  m_savedFormat = HeaderHelper::GetWireFormat ();
+}
+
+void
+HopCountUpdateTest::DoTeardown ()
+{
+  HeaderHelper::SetWireFormat (m_savedFormat);
+}
+
+void
+HopCountUpdateTest::CheckUpdate (Ptr<Packet> packet, int32_t hopCount, const std::string &format)
+{
+  uint32_t size = packet->GetSize ();
+  std::vector<uint8_t> before (size);
+  packet->CopyData (&before[0], size);
+
+  NS_TEST_ASSERT_MSG_EQ (HeaderHelper::GetHopCount (packet), hopCount, format << ": hop count is not found");
+  NS_TEST_ASSERT_MSG_EQ (HeaderHelper::IncrementHopCount (packet), true, format << ": hop count is not incremented");
+  NS_TEST_ASSERT_MSG_EQ (HeaderHelper::GetHopCount (packet), hopCount + 1, format << ": wrong incremented hop count");
+  NS_TEST_ASSERT_MSG_EQ (packet->GetSize (), size, format << ": size of the packet should not change");
+
+  // only the 4-octet hop count field is different
+  std::vector<uint8_t> after (size);
+  packet->CopyData (&after[0], size);
+  uint32_t changed = 0;
+  for (uint32_t i = 0; i < size; i++)
+    {
+      if (before[i] != after[i])
+        changed ++;
+    }
+  NS_TEST_ASSERT_MSG_EQ (changed, 1, format << ": only the lowest octet of the hop count should change");
+
+  NS_TEST_ASSERT_MSG_EQ (HeaderHelper::SetHopCount (packet, 0x01020304), true, format << ": hop count is not set");
+  NS_TEST_ASSERT_MSG_EQ (HeaderHelper::GetHopCount (packet), 0x01020304, format << ": wrong hop count after set");
+  NS_TEST_ASSERT_MSG_EQ (packet->GetSize (), size, format << ": size of the packet should not change");
+}
+
+void
+HopCountUpdateTest::DoRun ()
+{
+  HeaderHelper::WireFormat formats[] = {HeaderHelper::WIRE_FORMAT_NDNSIM, HeaderHelper::WIRE_FORMAT_TLV};
+  for (uint32_t f = 0; f < 2; f++)
+    {
+      HeaderHelper::SetWireFormat (formats[f]);
+      std::string format = formats[f] == HeaderHelper::WIRE_FORMAT_TLV ? "TLV" : "ndnSIM";
+
+      Interest interest;
+      interest.SetName (Create<Name> ("/test/hop-count"));
+      interest.SetNonce (200);
+      interest.SetInterestLifetime (Seconds (2));
+
+      Ptr<Packet> packet = Create<Packet> ();
+      packet->AddHeader (interest);
+      NS_TEST_ASSERT_MSG_EQ (HeaderHelper::IncrementHopCount (packet), false, format << ": Interest without hop count should be untouched");
+      NS_TEST_ASSERT_MSG_EQ (HeaderHelper::GetHopCount (packet), -1, format << ": Interest should not carry hop count");
+
+      interest.SetHopCount (5);
+      packet = Create<Packet> ();
+      packet->AddHeader (interest);
+      CheckUpdate (packet, 5, format + " Interest");
+
+      Interest interestTarget;
+      packet->RemoveHeader (interestTarget);
+      NS_TEST_ASSERT_MSG_EQ (interestTarget.GetHopCount (), 0x01020304, format << ": Interest hop count failed");
+      NS_TEST_ASSERT_MSG_EQ (interestTarget.GetName (), interest.GetName (), format << ": Interest name failed");
+      NS_TEST_ASSERT_MSG_EQ (interestTarget.GetNonce (), interest.GetNonce (), format << ": Interest nonce failed");
+
+      ContentObject data;
+      data.SetName (Create<Name> ("/test/hop-count/1"));
+      data.SetTimestamp (Seconds (100));
+      data.SetHopCount (7);
+
+      static ContentObjectTail tail;
+      packet = Create<Packet> (100);
+      packet->AddHeader (data);
+      packet->AddTrailer (tail);
+      NS_TEST_ASSERT_MSG_EQ (HeaderHelper::GetNdnHeaderType (packet),
+                             formats[f] == HeaderHelper::WIRE_FORMAT_TLV ? HeaderHelper::CONTENT_OBJECT_TLV : HeaderHelper::CONTENT_OBJECT_NDNSIM,
+                             format << ": ContentObject with hop count is not detected");
+      CheckUpdate (packet, 7, format + " ContentObject");
+
+      ContentObject dataTarget;
+      packet->RemoveHeader (dataTarget);
+      NS_TEST_ASSERT_MSG_EQ (dataTarget.GetHopCount (), 0x01020304, format << ": ContentObject hop count failed");
+      NS_TEST_ASSERT_MSG_EQ (dataTarget.GetName (), data.GetName (), format << ": ContentObject name failed");
+      NS_TEST_ASSERT_MSG_EQ (dataTarget.GetTimestamp (), data.GetTimestamp (), format << ": ContentObject timestamp failed");
+      NS_TEST_ASSERT_MSG_EQ (packet->GetSize (), 100 + tail.GetSerializedSize (), format << ": payload should not be consumed");
+    }
+}
+
 }
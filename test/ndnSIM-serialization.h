@@ -23,6 +23,10 @@
 #define NDNSIM_SERIALIZATION_H
 
 #include "ns3/test.h"
+#include "ns3/ndn-header-helper.h"
+#include "ns3/ptr.h"
+
+#include <string>
 
 namespace ns3
 {
@@ -51,6 +55,85 @@ private:
   virtual void DoRun ();
 };
 
+class InterestTlvSerializationTest : public TestCase
+{
+public:
+  InterestTlvSerializationTest ()
+    : TestCase ("Interest TLV Serialization Test")
+  {
+  }
+
+private:
+  virtual void DoSetup ();
+  virtual void DoRun ();
+  virtual void DoTeardown ();
+
+  ndn::HeaderHelper::WireFormat m_savedFormat; ///< \brief Wire format to restore after the test
+};
+
+class ContentObjectTlvSerializationTest : public TestCase
+{
+public:
+  ContentObjectTlvSerializationTest ()
+    : TestCase ("ContentObject TLV Serialization Test")
+  {
+  }
+
+private:
+  virtual void DoSetup ();
+  virtual void DoRun ();
+  virtual void DoTeardown ();
+
+  ndn::HeaderHelper::WireFormat m_savedFormat; ///< \brief Wire format to restore after the test
+};
+
+class NameUriTest : public TestCase
+{
+public:
+  NameUriTest ()
+    : TestCase ("Name URI parsing and printing Test")
+  {
+  }
+
+private:
+  virtual void DoRun ();
+};
+
+class NameLongComponentSerializationTest : public TestCase
+{
+public:
+  NameLongComponentSerializationTest ()
+    : TestCase ("Name with long component Serialization Test")
+  {
+  }
+
+private:
+  virtual void DoSetup ();
+  virtual void DoRun ();
+  virtual void DoTeardown ();
+
+  ndn::HeaderHelper::WireFormat m_savedFormat; ///< \brief Wire format to restore after the test
+};
+
+class HopCountUpdateTest : public TestCase
+{
+public:
+  HopCountUpdateTest ()
+    : TestCase ("In-place hop count update Test")
+  {
+  }
+
+private:
+  virtual void DoSetup ();
+  virtual void DoRun ();
+  virtual void DoTeardown ();
+
+  void
+  CheckUpdate (Ptr<Packet> packet, int32_t hopCount, const std::string &format);
+
+  ndn::HeaderHelper::WireFormat m_savedFormat; ///< \brief Wire format to restore after the test
+};
+
 }
 
 #endif // NDNSIM_SERIALIZATION_H
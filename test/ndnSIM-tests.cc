@@ -23,7 +23,13 @@
 
 #include "ndnSIM-serialization.h"
 #include "ndnSIM-pit.h"
+#include "ndnSIM-pit-entry.h"
+#include "ndnSIM-nonce-filter.h"
 #include "ndnSIM-fib-entry.h"
+#include "ndnSIM-fib.h"
+#include "ndnSIM-global-routing.h"
+#include "ndnSIM-fw.h"
+#include "ndnSIM-object-pool.h"
 
 namespace ns3
 {
@@ -38,7 +44,26 @@ public:
 
     AddTestCase (new InterestSerializationTest ());
     AddTestCase (new ContentObjectSerializationTest ());
+    AddTestCase (new InterestTlvSerializationTest ());
+    AddTestCase (new ContentObjectTlvSerializationTest ());
+    AddTestCase (new NameUriTest ());
+    AddTestCase (new NameLongComponentSerializationTest ());
+    AddTestCase (new HopCountUpdateTest ());
     AddTestCase (new FibEntryTest ());
+    AddTestCase (new FibEntryReorderTest ());
+    AddTestCase (new FibHashLpmTest ());
+    AddTestCase (new FibAddBulkTest ());
+    AddTestCase (new GlobalRoutingGraphUpdateTest ());
+    AddTestCase (new GlobalRoutingSaveLoadTest ());
+    AddTestCase (new PitEntryFwTagTest ());
+    AddTestCase (new PitMemorySizeTest ());
+    AddTestCase (new PitAdmissionControlTest ());
+    AddTestCase (new NonceFilterTest ());
+    AddTestCase (new NonceFilterRotationTest ());
+    AddTestCase (new NonceFilterFalsePositiveTest ());
+    AddTestCase (new FwRttAdaptiveTest ());
+    AddTestCase (new FwWeightedMultipathTest ());
+    AddTestCase (new ObjectPoolTest ());
     // AddTestCase (new PitTest ());
   }
 };
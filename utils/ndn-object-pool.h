@@ -0,0 +1,234 @@
+/* -*- Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil -*- */
+/*
+ * Copyright (c) 2013 University of California, Los Angeles
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ * Author: Alexander Afanasyev <alexander.afanasyev@ucla.edu>
+ */
+
+#ifndef NDN_OBJECT_POOL_H
+#define NDN_OBJECT_POOL_H
+
+#include <new>
+#include <cstddef>
+
+namespace ns3 {
+namespace ndn {
+
+/**
+ * @brief Freelist of memory blocks for objects of type T
+ *
+ * Memory of released objects is kept in the list (up to MaxSize blocks) and reused for new objects
+ * of the same type, avoiding calls to the global allocator for short-lived objects that are created
+ * for each packet (Interest, ContentObject, Name, Exclusion).
+ *
+ * Pool is used via class-specific operator new/delete (see NDN_OBJECT_POOL), so it works
+ * transparently with Create<T> and Ptr<T>: when the last reference is released, memory of the
+ * object returns to the pool.
+ *
+ * The state of the pool is a POD, which is zero-initialized before any dynamic initialization and
+ * is never destroyed, so objects can be safely created and released from static objects.
+ * The simulator is single-threaded, so the pool is not protected by any locks.  Code that runs in
+ * other threads (e.g., SystemThread workers of GlobalRoutingHelper::CalculateRoutes and
+ * GlobalRoutingHelper::CalculateAllPossibleRoutes) must not create or release pooled objects.
+ */
+template<class T, std::size_t MaxSize = 1024>
+class ObjectPool
+{
+public:
+  /**
+   * @brief Get memory for a new object
+   * @param size requested size (objects of derived classes are allocated using the global allocator)
+   */
+  static void*
+  Allocate (std::size_t size)
+  {
+    if (size != sizeof (T) || s_state.m_head == 0)
+      return ::operator new (size);
+
+    Block *block = s_state.m_head;
+    s_state.m_head = block->m_next;
+    s_state.m_size --;
+    return block;
+  }
+
+  /**
+   * @brief Return memory of the destroyed object to the pool
+   * @param p pointer to the memory
+   * @param size size of the memory (as requested in Allocate)
+   */
+  static void
+  Release (void *p, std::size_t size)
+  {
+    if (p == 0)
+      return;
+
+    if (size != sizeof (T) || s_state.m_size >= MaxSize)
+      {
+        ::operator delete (p);
+        return;
+      }
+
+    Block *block = static_cast<Block*> (p);
+    block->m_next = s_state.m_head;
+    s_state.m_head = block;
+    s_state.m_size ++;
+  }
+
+  /**
+   * @brief Get number of memory blocks currently kept in the pool
+   */
+  static std::size_t
+  GetSize ()
+  {
+    return s_state.m_size;
+  }
+
+private:
+  struct Block
+  {
+    Block *m_next;
+  };
+
+  struct State
+  {
+    Block *m_head;
+    std::size_t m_size;
+  };
+
+  static State s_state;
+};
+
+template<class T, std::size_t MaxSize>
+typename ObjectPool<T, MaxSize>::State ObjectPool<T, MaxSize>::s_state = { 0, 0 };
+
+/**
+ * @brief STL-style allocator that takes single objects from ObjectPool
+ *
+ * Intended for boost::allocate_shared: the allocator is rebound to the internal type that holds both
+ * the reference counter and the object, so the whole block is reused via the pool of that type.
+ * Requests for arrays are served by the global allocator.
+ */
+template<class T>
+class ObjectPoolAllocator
+{
+public:
+  typedef T value_type;
+  typedef T* pointer;
+  typedef const T* const_pointer;
+  typedef T& reference;
+  typedef const T& const_reference;
+  typedef std::size_t size_type;
+  typedef std::ptrdiff_t difference_type;
+
+  template<class U>
+  struct rebind
+  {
+    typedef ObjectPoolAllocator<U> other;
+  };
+
+  ObjectPoolAllocator () { }
+
+  template<class U>
+  ObjectPoolAllocator (const ObjectPoolAllocator<U> &) { }
+
+  pointer
+  allocate (size_type n, const void * = 0)
+  {
+    if (n != 1)
+      return static_cast<pointer> (::operator new (n * sizeof (T)));
+
+    return static_cast<pointer> (ObjectPool<T>::Allocate (sizeof (T)));
+  }
+
+  void
+  deallocate (pointer p, size_type n)
+  {
+    if (n != 1)
+      {
+        ::operator delete (p);
+        return;
+      }
+
+    ObjectPool<T>::Release (p, sizeof (T));
+  }
+
+  void
+  construct (pointer p, const T &value)
+  {
+    new (p) T (value);
+  }
+
+  void
+  destroy (pointer p)
+  {
+    p->~T ();
+  }
+
+  size_type
+  max_size () const
+  {
+    return static_cast<size_type> (-1) / sizeof (T);
+  }
+
+  pointer
+  address (reference x) const
+  {
+    return &x;
+  }
+
+  const_pointer
+  address (const_reference x) const
+  {
+    return &x;
+  }
+
+  template<class U>
+  bool
+  operator == (const ObjectPoolAllocator<U> &) const
+  {
+    return true;
+  }
+
+  template<class U>
+  bool
+  operator != (const ObjectPoolAllocator<U> &) const
+  {
+    return false;
+  }
+};
+
+} // namespace ndn
+} // namespace ns3
+
+/**
+ * @brief Declare class-specific operator new/delete that use ObjectPool
+ *
+ * Should be placed inside the public section of the class declaration
+ */
+#define NDN_OBJECT_POOL(Type, MaxSize)                                  \
+  static void*                                                          \
+  operator new (std::size_t size)                                       \
+  {                                                                     \
+    return ::ns3::ndn::ObjectPool<Type, MaxSize>::Allocate (size);      \
+  }                                                                     \
+                                                                        \
+  static void                                                           \
+  operator delete (void *p, std::size_t size)                           \
+  {                                                                     \
+    ::ns3::ndn::ObjectPool<Type, MaxSize>::Release (p, size);           \
+  }
+
+#endif // NDN_OBJECT_POOL_H
@@ -76,6 +76,29 @@ public:
     return item;
   }
 
+  /**
+   * @brief Set payload on the node that was created directly in the trie (e.g., using find_or_create_child)
+   *
+   * If policy does not accept the node, payload is reset, but the (empty) node is not pruned,
+   * so iterators to the node and its parents remain valid
+   *
+   * @returns true if payload has been set, false if node already has a payload or policy rejected the node
+   */
+  inline bool
+  insert_payload (iterator node, typename PayloadTraits::insert_type payload)
+  {
+    if (node->payload () != PayloadTraits::empty_payload)
+      return false;
+
+    node->set_payload (payload);
+    if (!policy_.insert (s_iterator_to (node)))
+      {
+        node->set_payload (PayloadTraits::empty_payload);
+        return false;
+      }
+    return true;
+  }
+
   inline void
   erase (const FullKey &key)
   {
@@ -246,7 +246,7 @@ public:
   {
     // Full key is the whole content name, subkey is splitted based on '/'
 
-    FullKey modified_key(key.GetComponents());
+    FullKey modified_key(key);
 
     if (hash != NULL)
       {
@@ -286,6 +286,36 @@ public:
       return std::make_pair (trieNode, false);
   }
 
+  /**
+   * @brief Find child node with the key or create a new (empty) one
+   *
+   * Unlike insert, does not walk from the root, so can be used to insert a number of keys with
+   * common prefixes (e.g., sorted keys), remembering the path to the previous key
+   */
+  inline iterator
+  find_or_create_child (const Key &subkey)
+  {
+    typename unordered_set::iterator item = children_.find (subkey);
+    if (item != children_.end ())
+      return &(*item);
+
+    trie *newNode = new trie (subkey, initialBucketSize_, bucketIncrement_);
+    newNode->parent_ = this;
+
+    if (children_.size () >= bucketSize_)
+      {
+        bucketSize_ += bucketIncrement_;
+        bucketIncrement_ *= 2; // increase bucketIncrement exponentially
+
+        buckets_array newBuckets (new bucket_type [bucketSize_]);
+        children_.rehash (bucket_traits (newBuckets.get (), bucketSize_));
+        buckets_.swap (newBuckets);
+      }
+
+    children_.insert (*newNode);
+    return newNode;
+  }
+
   /**
    * @brief Removes payload (if it exists) and if there are no children, prunes parents trie
    */
@@ -571,6 +601,37 @@ public:
     return boost::make_tuple (foundNode, reachLast, trieNode);
   }
 
+  /**
+   * @brief Walk down the trie along the key, calling visitor for every node on the path (including this node)
+   * @param key the key along which to walk
+   * @param visitor functor, called as visitor (iterator) for every visited node
+   *
+   * Allows collecting several kinds of matches (e.g., exact and longest prefix) in a single pass
+   *
+   * @return ->first is the last visited node, ->second is true if the whole key was matched
+   */
+  template<class Visitor>
+  inline std::pair<iterator, bool>
+  walk (const FullKey &key, Visitor &visitor)
+  {
+    trie *trieNode = this;
+    visitor (trieNode);
+
+    BOOST_FOREACH (const Key &subkey, key)
+      {
+        typename unordered_set::iterator item = trieNode->children_.find (subkey);
+        if (item == trieNode->children_.end ())
+          {
+            return std::make_pair (trieNode, false);
+          }
+
+        trieNode = &(*item);
+        visitor (trieNode);
+      }
+
+    return std::make_pair (trieNode, true);
+  }
+
   /**
    * @brief Find next payload of the sub-trie
    * @returns end() or a valid iterator pointing to the trie leaf (order is not defined, enumeration )
@@ -658,6 +719,18 @@ public:
   inline void
   PrintStat (std::ostream &os) const;
 
+  /**
+   * @brief Get approximate number of bytes occupied by the node itself (payload and children are not included)
+   */
+  inline size_t
+  memory_usage () const
+  {
+    return sizeof (trie)
+      + bucketSize_ * sizeof (bucket_type)
+      + (key_.capacity () >= sizeof (Key) ? key_.capacity () + 1 : 0) // short keys are stored inside the object
+      + faces_with_exclusions.capacity () * sizeof (uint);
+  }
+
 private:
   //The disposer object function
   struct trie_delete_disposer